@@ -0,0 +1,474 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#include <cstdio>
+#include <algorithm>
+#include <vector>
+#include <random>
+#include <functional>
+#include <jansson.h>
+#include "../utils/log.h"
+#include "../utils/fs.h"
+#include "../utils/time.h"
+#include "const.h"
+#include "conf.h"
+#include "clock.h"
+#include "mixer.h"
+#include "mixerHandler.h"
+#include "kernelAudio.h"
+#include "realtime.h"
+#include "recorder.h"
+#include "patch.h"
+#include "profiler.h"
+#include "pluginHost.h"
+#include "sampleChannel.h"
+#include "wave.h"
+#include "waveFx.h"
+#include "waveManager.h"
+#include "benchmark.h"
+
+
+using std::string;
+using std::vector;
+
+
+namespace giada {
+namespace m {
+namespace benchmark
+{
+namespace
+{
+std::minstd_rand rng;
+
+
+/* -------------------------------------------------------------------------- */
+
+/* makeWave
+Stereo noise: nothing can be skipped as silence. */
+
+Wave* makeWave(int frames, const string& name)
+{
+	Wave* w = nullptr;
+	if (waveManager::createEmpty(frames, G_MAX_IO_CHANS, conf::samplerate, name, 
+		&w) != G_RES_OK)
+		return nullptr;
+	std::uniform_real_distribution<float> dist(-0.5f, 0.5f);
+	for (int i=0; i<w->getSize(); i++)
+		for (int j=0; j<w->getChannels(); j++)
+			w->getFrame(i)[j] = dist(rng);
+	return w;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* setupClock
+Headless counterpart of glue_setBpm() and glue_setBeats(). */
+
+void setupClock(const Session& s)
+{
+	clock::setBpm(s.bpm);
+	clock::setBeats(s.beats);
+	clock::setBars(s.bars);
+	clock::updateFrameBars();
+	clock::setQuantize(s.quantize);
+	mixer::allocVirtualInput(clock::getFramesInLoop());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* addChannels
+Adds 'count' channels made after Session 's'. Loop channels get mute on/off 
+actions, single ones key presses. */
+
+bool addChannels(const Session& s, int count)
+{
+	int framesInBar = clock::getFramesInBar();
+	int numLoops    = count * s.loops + 0.5f;
+	std::uniform_int_distribution<int> dist(0, framesInBar - 1);
+
+	for (int i=0; i<count; i++) {
+		SampleChannel* ch = static_cast<SampleChannel*>(mh::addChannel(G_CHANNEL_SAMPLE));
+		if (ch == nullptr)
+			return false;
+		Wave* wave = makeWave(s.length * conf::samplerate, "bench-" + std::to_string(i));
+		if (wave == nullptr)
+			return false;
+		ch->pushWave(wave);
+		ch->setPitch(s.pitch);
+		ch->mode = i < numLoops ? LOOP_BASIC : SINGLE_BASIC;
+
+		for (int bar=0; bar<clock::getBars(); bar++)
+			for (int k=0; k<s.actions; k++) {
+				int type = ch->mode == SINGLE_BASIC ? G_ACTION_KEYPRESS :
+					k % 2 == 0 ? G_ACTION_MUTEON : G_ACTION_MUTEOFF;
+				recorder::rec(ch->index, type, bar * framesInBar + dist(rng));
+			}
+		ch->hasActions = s.actions > 0;
+
+#ifdef WITH_VST
+		if (s.plugin != "" && pluginHost::addPlugin(s.plugin, pluginHost::CHANNEL, 
+			&mixer::mutex_plugins, ch) == nullptr) {
+			gu_log("[benchmark] unable to load plug-in %s\n", s.plugin.c_str());
+			return false;
+		}
+#endif
+	}
+	return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void removeChannels()
+{
+	vector<Channel*> chans = mixer::channels;
+	for (Channel* ch : chans) {
+		mh::deleteChannel(ch);
+#ifdef WITH_VST
+		pluginHost::freeStack(pluginHost::CHANNEL, &mixer::mutex_plugins, ch);
+#endif
+		delete ch;
+	}
+	recorder::clearAll();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* startTransport
+Starts the sequencer from the top, loop channels included, as if their keys 
+were pressed. */
+
+void startTransport()
+{
+	mixer::rewind();
+	clock::rewind();
+	clock::start();
+	for (Channel* ch : mixer::channels)
+		if (ch->type == G_CHANNEL_SAMPLE && static_cast<SampleChannel*>(ch)->mode & LOOP_ANY)
+			ch->start(0, false, 0, true, false, false);  // plays on frame 0, see Channel::onZero()
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* runCallback
+Times 'blocks' calls of mixer::masterPlay(), after a few untimed ones to warm
+up caches and plug-ins. */
+
+json_t* runCallback(int blocks)
+{
+	int bufSize = kernelAudio::getRealBufSize();
+	vector<float> out(bufSize * G_MAX_IO_CHANS);
+	vector<float> in (bufSize * G_MAX_IO_CHANS, 0.0f);
+
+	startTransport();
+	for (int i=0; i<G_BENCH_WARMUP; i++)
+		mixer::masterPlay(out.data(), in.data(), bufSize, 0.0, 0, nullptr);
+
+	profiler::Histogram h;
+	int64_t total = 0;
+	for (int i=0; i<blocks; i++) {
+		int64_t t = u::time::now();
+		mixer::masterPlay(out.data(), in.data(), bufSize, 0.0, 0, nullptr);
+		t = u::time::now() - t;
+		h.add(t);
+		total += t;
+	}
+	clock::stop();
+
+	int    channels = mixer::channels.size();
+	double mean     = total / (double) blocks;
+	double period   = bufSize * 1000000000.0 / conf::samplerate;
+
+	gu_log("[benchmark] %d channels: %.0f ns/block, %.0f ns/channel, load %.3f\n",
+		channels, mean, mean / std::max(1, channels), mean / period);
+
+	json_t* j = json_object();
+	json_object_set_new(j, "channels",      json_integer(channels));
+	json_object_set_new(j, "blocks",        json_integer(blocks));
+	json_object_set_new(j, "ns_block_mean", json_real(mean));
+	json_object_set_new(j, "ns_block_p50",  json_integer(h.getPercentile(0.5)));
+	json_object_set_new(j, "ns_block_p99",  json_integer(h.getPercentile(0.99)));
+	json_object_set_new(j, "ns_block_max",  json_integer(h.getMax()));
+	json_object_set_new(j, "ns_channel",    json_real(mean / std::max(1, channels)));
+	json_object_set_new(j, "load",          json_real(mean / period));
+	return j;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* measure
+Runs 'f' 'iterations' times and appends its average duration to 'out'. */
+
+void measure(json_t* out, const string& name, int iterations, std::function<void()> f)
+{
+	int64_t t = u::time::now();
+	for (int i=0; i<iterations; i++)
+		f();
+	double ns = (u::time::now() - t) / (double) iterations;
+
+	gu_log("[benchmark] %s: %.0f ns\n", name.c_str(), ns);
+
+	json_t* j = json_object();
+	json_object_set_new(j, "name",       json_string(name.c_str()));
+	json_object_set_new(j, "iterations", json_integer(iterations));
+	json_object_set_new(j, "ns_op",      json_real(ns));
+	json_array_append_new(out, j);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* runRecorder
+Lookups done by channels while playing, at random frames. Needs a session 
+with actions. */
+
+void runRecorder(json_t* out)
+{
+	int lastFrame = clock::getFramesInLoop();
+	int bufSize   = kernelAudio::getRealBufSize();
+	int numChans  = mixer::channels.size();
+	std::uniform_int_distribution<int> frameDist(0, lastFrame - 1);
+	std::uniform_int_distribution<int> chanDist (0, numChans - 1);
+	recorder::action* a = nullptr;
+	int count = 0;
+
+	measure(out, "recorder::getNextAction", G_BENCH_ITERATIONS, [&]
+	{
+		int chan = mixer::channels[chanDist(rng)]->index;
+		count += recorder::getNextAction(chan, G_ACTION_KEYS | G_ACTION_MUTES, 
+			frameDist(rng), &a);
+	});
+	measure(out, "recorder::getAction", G_BENCH_ITERATIONS, [&]
+	{
+		int chan = mixer::channels[chanDist(rng)]->index;
+		count += recorder::getAction(chan, G_ACTION_KEYPRESS, frameDist(rng), &a);
+	});
+	measure(out, "recorder::forEachAction (block)", G_BENCH_ITERATIONS, [&]
+	{
+		int chan  = mixer::channels[chanDist(rng)]->index;
+		int frame = frameDist(rng);
+		recorder::forEachAction(chan, frame, frame + bufSize, 
+			[&](const recorder::action*) { count++; });
+	});
+	gu_log("[benchmark] %d actions found\n", count);  // keeps lookups alive
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* runFillChan
+SampleChannel::clear() on a playing channel: one fillChan() per block, with or
+without resampling. */
+
+void runFillChan(json_t* out, const Session& s)
+{
+	Session one = s;
+	one.loops   = 1.0f;
+	one.actions = 0;
+	one.plugin  = "";
+
+	float pitches[] = {1.0f, s.pitch != 1.0f ? s.pitch : 1.5f};
+	for (float pitch : pitches) {
+		removeChannels();
+		one.pitch = pitch;
+		if (!addChannels(one, 1))
+			return;
+		SampleChannel* ch = static_cast<SampleChannel*>(mixer::channels[0]);
+		ch->start(0, false, 0, false, true, false);
+		int end = ch->getEnd() - kernelAudio::getRealBufSize() * pitch;
+		measure(out, pitch == 1.0f ? "SampleChannel::fillChan" : 
+			"SampleChannel::fillChan (resampling)", G_BENCH_ITERATIONS, [&]
+		{
+			if (ch->tracker >= end)
+				ch->tracker = 0;
+			ch->clear();
+		});
+	}
+	removeChannels();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void runWaveFx(json_t* out, const Session& s)
+{
+	Wave* w = makeWave(s.length * conf::samplerate, "bench");
+	if (w == nullptr)
+		return;
+	int size = w->getSize();
+
+	measure(out, "wfx::normalizeSoft", G_BENCH_WAVE_ITERATIONS, [&] { wfx::normalizeSoft(*w); });
+	measure(out, "wfx::fade",          G_BENCH_WAVE_ITERATIONS, [&] { wfx::fade(*w, 0, size, wfx::FADE_IN); });
+	measure(out, "wfx::smooth",        G_BENCH_WAVE_ITERATIONS, [&] { wfx::smooth(*w, 0, size); });
+	measure(out, "wfx::reverse",       G_BENCH_WAVE_ITERATIONS, [&] { wfx::reverse(*w, 0, size); });
+
+	/* Peaks as drawn by geWaveform, on a screen-wide picture. */
+
+	measure(out, "wfx::getPeaks", G_BENCH_WAVE_ITERATIONS, [&]
+	{
+		float ratio = size / (float) G_BENCH_PEAKS;
+		float sup, inf;
+		for (int i=0; i<G_BENCH_PEAKS; i++)
+			wfx::getPeaks(*w, i * ratio, std::min(size, (int) ((i + 1) * ratio)), sup, inf);
+	});
+
+	delete w;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* runPatch
+Writes and reads back the current session. */
+
+void runPatch(json_t* out)
+{
+	string path = gu_getHomePath() + G_SLASH + "giada-bench.gptc";
+
+	patch::init();
+	patch::version      = G_VERSION_STR;
+	patch::versionMajor = G_VERSION_MAJOR;
+	patch::versionMinor = G_VERSION_MINOR;
+	patch::versionPatch = G_VERSION_PATCH;
+	patch::name         = "bench";
+	patch::bpm          = clock::getBpm();
+	patch::bars         = clock::getBars();
+	patch::beats        = clock::getBeats();
+	patch::quantize     = clock::getQuantize();
+	patch::masterVolIn  = mixer::inVol;
+	patch::masterVolOut = mixer::outVol;
+	patch::metronome    = mixer::metronome;
+	patch::samplerate   = conf::samplerate;
+
+	patch::column_t col;
+	col.index     = 0;
+	col.width     = G_DEFAULT_COLUMN_WIDTH;
+	col.bus       = false;
+	col.busVolume = G_DEFAULT_VOL;
+	col.busMute   = false;
+	for (unsigned i=0; i<mixer::channels.size(); i++) {
+		mixer::channels[i]->writePatch(i, false);
+		col.channels.push_back(mixer::channels[i]->index);
+	}
+	patch::columns.push_back(col);
+
+	measure(out, "patch::write", G_BENCH_PATCH_ITERATIONS, [&] { patch::write(path); });
+	measure(out, "patch::read",  G_BENCH_PATCH_ITERATIONS, [&] { patch::read(path); });
+
+	std::remove(path.c_str());
+}
+}; // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+int run(const Session& s, const string& path)
+{
+	if (kernelAudio::getRealBufSize() <= 0 || s.channels <= 0 || s.blocks <= 0 ||
+	    s.length <= 0.0f || s.pitch <= 0.0f)
+		return G_RES_ERR_WRONG_DATA;
+
+	realtime::flushDenormals();
+	rng.seed(s.seed);
+	setupClock(s);
+
+	json_t* jRoot = json_object();
+	json_t* jSession = json_object();
+	json_object_set_new(jSession, "channels", json_integer(s.channels));
+	json_object_set_new(jSession, "length",   json_real(s.length));
+	json_object_set_new(jSession, "pitch",    json_real(s.pitch));
+	json_object_set_new(jSession, "actions",  json_integer(s.actions));
+	json_object_set_new(jSession, "loops",    json_real(s.loops));
+	json_object_set_new(jSession, "bpm",      json_real(s.bpm));
+	json_object_set_new(jSession, "beats",    json_integer(s.beats));
+	json_object_set_new(jSession, "bars",     json_integer(s.bars));
+	json_object_set_new(jSession, "quantize", json_integer(s.quantize));
+	json_object_set_new(jSession, "plugin",   json_string(s.plugin.c_str()));
+	json_object_set_new(jSession, "seed",     json_integer(s.seed));
+	json_object_set_new(jRoot, "version",    json_string(G_VERSION_STR));
+	json_object_set_new(jRoot, "samplerate", json_integer(conf::samplerate));
+	json_object_set_new(jRoot, "buffersize", json_integer(kernelAudio::getRealBufSize()));
+	json_object_set_new(jRoot, "session",    jSession);
+
+	int res = G_RES_ERR_MEMORY;
+
+	/* Whole session first, then the scaling curve: 1, 2, 4 ... channels. */
+
+	if (addChannels(s, s.channels)) {
+		json_object_set_new(jRoot, "callback", runCallback(s.blocks));
+
+		json_t* jMicro = json_array();
+		runRecorder(jMicro);
+		runPatch(jMicro);
+
+		vector<int> counts;
+		for (int n=1; n<s.channels; n*=2)
+			counts.push_back(n);
+		counts.push_back(s.channels);
+
+		res = G_RES_OK;
+		json_t* jScaling = json_array();
+		for (int n : counts) {
+			removeChannels();
+			if (!addChannels(s, n)) {
+				res = G_RES_ERR_MEMORY;
+				break;
+			}
+			json_array_append_new(jScaling, runCallback(s.blocks));
+		}
+		json_object_set_new(jRoot, "scaling", jScaling);
+
+		runFillChan(jMicro, s);
+		runWaveFx(jMicro, s);
+		json_object_set_new(jRoot, "micro", jMicro);
+	}
+	removeChannels();
+
+	if (res == G_RES_OK) {
+		int err = path == "" ? json_dumpf(jRoot, stdout, JSON_INDENT(2)) :
+			json_dump_file(jRoot, path.c_str(), JSON_INDENT(2));
+		if (err != 0) {
+			gu_log("[benchmark] unable to write results to %s\n", path.c_str());
+			res = G_RES_ERR_IO;
+		}
+	}
+	json_decref(jRoot);
+	return res;
+}
+}}}; // giada::m::benchmark::
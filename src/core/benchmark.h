@@ -0,0 +1,76 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef G_BENCHMARK_H
+#define G_BENCHMARK_H
+
+
+#include <string>
+#include "const.h"
+
+
+namespace giada {
+namespace m {
+namespace benchmark
+{
+/* Session
+Recipe for a synthetic session: 'channels' sample channels playing noise, a 
+share of them ('loops', 0.0 to 1.0) in loop mode and the rest in single mode,
+driven by 'actions' recorded actions per bar each. */
+
+struct Session
+{
+	int         channels = 16;
+	float       length   = 2.0f;   // sample length, in seconds
+	float       pitch    = 1.0f;
+	int         actions  = 4;      // per channel and bar
+	float       loops    = 0.5f;
+	float       bpm      = G_DEFAULT_BPM;
+	int         beats    = G_DEFAULT_BEATS;
+	int         bars     = G_DEFAULT_BARS;
+	int         quantize = G_DEFAULT_QUANTIZE;
+	std::string plugin   = "";     // plug-in added to each channel, if any
+	int         blocks   = 2000;   // callbacks to time
+	unsigned    seed     = 1;
+};
+
+/* run
+Builds the session, drives mixer::masterPlay() for 'blocks' callbacks, then 
+again with 1, 2, 4 ... channels for the scaling curve, and finally runs the 
+micro benchmarks: recorder lookups, SampleChannel::fillChan(), waveFx kernels,
+waveform peaks and patch read/write. Results go to 'path' as JSON, or to 
+stdout if 'path' is empty. Requires the engine to be set up with 
+init_prepareKernelAudio(true) and no channels loaded. Returns G_RES_OK on 
+success. */
+
+int run(const Session& s, const std::string& path);
+}}}; // giada::m::benchmark::
+
+
+#endif
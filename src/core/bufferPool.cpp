@@ -0,0 +1,198 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include <new>
+#include <vector>
+#include <cstdint>
+#include "../utils/log.h"
+#include "const.h"
+#include "audioBuffer.h"
+#include "bufferPool.h"
+
+
+namespace giada {
+namespace m {
+namespace bufferPool
+{
+namespace
+{
+struct Chunk
+{
+	float* raw;   // as returned by new[], used for deletion
+	float* data;  // first aligned sample
+};
+
+std::vector<Chunk>        chunks;
+std::vector<AudioBuffer*> owners;     // one per slot, nullptr if free
+std::vector<int>          freeSlots;
+
+int frames   = 0;
+int channels = 0;
+int stride   = 0;  // samples per slot, padded to G_BUFFER_ALIGN
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int computeStride(int frames, int channels)
+{
+	const int align = G_BUFFER_ALIGN / sizeof(float);
+	return ((frames * channels + align - 1) / align) * align;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool allocChunk(int stride, Chunk& c)
+{
+	c.raw = new (std::nothrow) float[stride * G_BUFFER_POOL_CHUNK + 
+		G_BUFFER_ALIGN / sizeof(float)];
+	if (c.raw == nullptr)
+		return false;
+	uintptr_t p = reinterpret_cast<uintptr_t>(c.raw);
+	p = (p + G_BUFFER_ALIGN - 1) & ~static_cast<uintptr_t>(G_BUFFER_ALIGN - 1);
+	c.data = reinterpret_cast<float*>(p);
+	return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void freeChunks(std::vector<Chunk>& cs)
+{
+	for (Chunk& c : cs)
+		delete[] c.raw;
+	cs.clear();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+float* getSlot(int i)
+{
+	return chunks[i / G_BUFFER_POOL_CHUNK].data + (i % G_BUFFER_POOL_CHUNK) * stride;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool grow()
+{
+	Chunk c;
+	if (!allocChunk(stride, c)) {
+		gu_log("[bufferPool::grow] unable to alloc new chunk!\n");
+		return false;
+	}
+	chunks.push_back(c);
+
+	int first = owners.size();
+	owners.resize(first + G_BUFFER_POOL_CHUNK, nullptr);
+	for (int i=first + G_BUFFER_POOL_CHUNK - 1; i>=first; i--)  // lowest slot first
+		freeSlots.push_back(i);
+
+	gu_log("[bufferPool::grow] pool grown to %d slots\n", (int) owners.size());
+	return true;
+}
+}; // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+bool init(int f, int c)
+{
+	clear();
+	frames   = f;
+	channels = c;
+	stride   = computeStride(f, c);
+	return grow();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void clear()
+{
+	for (AudioBuffer* b : owners)
+		if (b != nullptr)
+			b->setData(nullptr, 0, 0);
+	owners.clear();
+	freeSlots.clear();
+	freeChunks(chunks);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool acquire(AudioBuffer& b)
+{
+	if (freeSlots.empty() && !grow())
+		return false;
+
+	int i = freeSlots.back();
+	freeSlots.pop_back();
+	owners[i] = &b;
+
+	b.free();
+	b.setData(getSlot(i), frames, channels);
+	b.clear();
+	return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void release(AudioBuffer& b)
+{
+	for (unsigned i=0; i<owners.size(); i++) {
+		if (owners[i] != &b)
+			continue;
+		owners[i] = nullptr;
+		freeSlots.push_back(i);
+		b.setData(nullptr, 0, 0);
+		return;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int getFrames()      { return frames; }
+int countSlots()     { return owners.size(); }
+int countFreeSlots() { return freeSlots.size(); }
+}}}; // giada::m::bufferPool::
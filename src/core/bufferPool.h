@@ -0,0 +1,71 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+#ifndef G_BUFFER_POOL_H
+#define G_BUFFER_POOL_H
+
+
+namespace giada {
+namespace m 
+{
+class AudioBuffer;
+
+namespace bufferPool
+{
+/* init
+Sets the size of each buffer handed out by the pool and pre-allocates the first
+chunk of slots. Slots are G_BUFFER_ALIGN-aligned and laid out contiguously, 
+G_BUFFER_POOL_CHUNK at a time. The size is fixed until clear(): a new buffer 
+size from the configuration takes effect on restart, like the audio device. */
+
+bool init(int frames, int channels);
+
+/* clear
+Frees all chunks. Buffers still acquired are detached first, so they won't 
+point to freed memory. */
+
+void clear();
+
+/* acquire
+Binds 'b' to a free slot, growing the pool if needed. The buffer is cleared.
+Must not be called from the audio thread. */
+
+bool acquire(AudioBuffer& b);
+
+/* release
+Gives the slot used by 'b' back to the pool and detaches 'b'. Does nothing if 
+'b' was not acquired from the pool. */
+
+void release(AudioBuffer& b);
+
+int getFrames();
+int countSlots();
+int countFreeSlots();
+}}}; // giada::m::bufferPool::
+
+
+#endif
@@ -27,6 +27,7 @@
 
 #include <cassert>
 #include <cstring>
+#include <limits>
 #include "../utils/log.h"
 #include "../gui/elems/mainWindow/keyboard/channel.h"
 #include "const.h"
@@ -43,6 +44,9 @@
 #include "patch.h"
 #include "waveFx.h"
 #include "midiMapConf.h"
+#include "bufferPool.h"
+#include "uiState.h"
+#include "realtime.h"
 #include "channel.h"
 
 
@@ -55,7 +59,15 @@ Channel::Channel(int type, int status, int bufferSize)
 	volume_i       (1.0f),
 	volume_d       (0.0f),
 	mute_i         (false),
+	producing      (false),
+	tailFrames     (0),
+	sleeping       (false),
+	frozenWave     (nullptr),
 	guiChannel     (nullptr),
+	columnBus      (nullptr),
+	column         (0),
+	size           (G_GUI_CHANNEL_H_1),
+	level          ({ 0.0f, 0.0f }),
 	previewMode    (G_PREVIEW_NONE),
 	pan            (0.5f),
 	volume         (G_DEFAULT_VOL),
@@ -83,6 +95,15 @@ Channel::Channel(int type, int status, int bufferSize)
 	midiOutLmute   (0x0),
 	midiOutLsolo   (0x0)
 {
+#ifdef WITH_VST
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		sendLevels[i] = 0.0f;
+
+	/* Room for a full queue of 3-byte events plus JUCE's per-event header, so 
+	that draining the queue doesn't allocate on the audio thread. */
+
+	midiBuffer.ensureSize(G_CHANNEL_MIDI_QUEUE * 16);
+#endif
 }
 
 
@@ -92,6 +113,8 @@ Channel::Channel(int type, int status, int bufferSize)
 Channel::~Channel()
 {
 	status = STATUS_OFF;
+	bufferPool::release(vChan);
+	delete frozenWave;
 }
 
 
@@ -100,7 +123,8 @@ Channel::~Channel()
 
 bool Channel::allocBuffers()
 {
-	if (!vChan.alloc(bufferSize, G_MAX_IO_CHANS)) {
+	assert(bufferPool::getFrames() == bufferSize);
+	if (!bufferPool::acquire(vChan)) {
 		gu_log("[Channel::allocBuffers] unable to alloc memory for vChan!\n");
 		return false;
 	}
@@ -111,7 +135,18 @@ bool Channel::allocBuffers()
 /* -------------------------------------------------------------------------- */
 
 
-void Channel::copy(const Channel* src, pthread_mutex_t* pluginMutex)
+void Channel::prefault() const
+{
+	realtime::prefault(vChan);
+	realtime::prefault(frozenWave);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::copy(const Channel* src, pthread_mutex_t* pluginMutex, 
+	bool withActions)
 {
 	key             = src->key;
 	volume          = src->volume;
@@ -140,6 +175,8 @@ void Channel::copy(const Channel* src, pthread_mutex_t* pluginMutex)
 	/* clone plugins */
 
 #ifdef WITH_VST
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		sendLevels[i] = src->sendLevels[i];
 	for (unsigned i=0; i<src->plugins.size(); i++)
 		pluginHost::clonePlugin(src->plugins.at(i), pluginHost::CHANNEL,
 			pluginMutex, this);
@@ -147,6 +184,8 @@ void Channel::copy(const Channel* src, pthread_mutex_t* pluginMutex)
 
 	/* clone actions */
 
+	if (!withActions)
+		return;
 	for (unsigned i=0; i<recorder::global.size(); i++) {
 		for (unsigned k=0; k<recorder::global.at(i).size(); k++) {
 			recorder::action* a = recorder::global.at(i).at(k);
@@ -176,7 +215,7 @@ void Channel::sendMidiLmessage(uint32_t learn, const midimap::message_t& msg)
 	 * send it. */
 
 	out |= msg.value | (msg.channel << 24);
-	kernelMidi::send(out);
+	uiState::postEvent(uiState::MIDI_LIGHTNING, out);
 }
 
 
@@ -192,6 +231,167 @@ bool Channel::isPlaying() const
 /* -------------------------------------------------------------------------- */
 
 
+bool Channel::isProducing() const
+{
+#ifdef WITH_VST
+	return !midiBuffer.isEmpty();
+#else
+	return false;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool Channel::isActive() const
+{
+	if (frozenWave != nullptr)
+		return producing;
+	return producing || tailFrames > 0 || isProducing();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::updateTail()
+{
+	if (isProducing()) {
+		producing = true;
+		return;
+	}
+
+	/* Signal stopped during the last block: compute the tail from the plug-in 
+	stack once, then count it down. Infinite tails never expire. */
+
+#ifdef WITH_VST
+	if (producing)
+		tailFrames = pluginHost::getStackTail(pluginHost::CHANNEL, this);
+#endif
+	producing = false;
+
+	if (tailFrames == std::numeric_limits<int>::max())
+		return;
+	tailFrames = tailFrames > bufferSize ? tailFrames - bufferSize : 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::prepareBuffers()
+{
+#ifdef WITH_VST
+	drainMidiQueue();
+#endif
+	if (frozenWave != nullptr)  // vChan entirely rewritten by sumFrozen()
+		return;
+	if (isActive()) {
+		sleeping = false;
+		clear();
+	}
+	else
+	if (!sleeping) {
+		sleeping = true;
+		clear();
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::freeze(Wave* w)
+{
+	delete frozenWave;
+	frozenWave = w;
+	producing  = false;
+	tailFrames = 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+Wave* Channel::unfreeze()
+{
+	Wave* w = frozenWave;
+	frozenWave = nullptr;
+	sleeping   = false;  // vChan holds frozen data: clear it on next block
+	return w;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool Channel::isFrozen() const
+{
+	return frozenWave != nullptr;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::sumFrozen(int frame, int globalFrame, bool running)
+{
+	if (!running || mute || !isPlaying() || globalFrame >= frozenWave->getSize()) {
+		for (int i=0; i<vChan.countChannels(); i++)
+			vChan[frame][i] = 0.0f;
+		return;
+	}
+	producing = true;
+	vChan.copyFrame(frame, frozenWave->getFrame(globalFrame));
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+float Channel::getOutputGain(int ch)
+{
+	return volume;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::updateLevel()
+{
+	float gain[G_MAX_IO_CHANS];
+	for (int j=0; j<vChan.countChannels(); j++)
+		gain[j] = getOutputGain(j);
+	level = meter::measure(vChan, gain);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+#ifdef WITH_VST
+
+void Channel::sumSend(AudioBuffer& out, int bus)
+{
+	assert(out.countFrames() == vChan.countFrames());
+
+	float gain[G_MAX_IO_CHANS];
+	for (int j=0; j<out.countChannels(); j++)
+		gain[j] = getOutputGain(j) * sendLevels[bus];
+
+	for (int i=0; i<out.countFrames(); i++)
+		for (int j=0; j<out.countChannels(); j++)
+			out[i][j] += vChan[i][j] * gain[j];
+}
+
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void Channel::writePatch(int i, bool isProject)
 {
 	channelManager::writePatch(this, isProject);
@@ -354,4 +554,52 @@ void Channel::clearMidiBuffer()
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::addVstMidiEvent(uint32_t msg, int localFrame)
+{
+	if (isFrozen())  // plug-ins are not processed: events would pile up
+		return;
+	juce::MidiMessage message = juce::MidiMessage(
+		kernelMidi::getB1(msg),
+		kernelMidi::getB2(msg),
+		kernelMidi::getB3(msg));
+	midiBuffer.addEvent(message, localFrame);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool Channel::postMidiEvent(uint32_t msg, int localFrame)
+{
+	return midiQueue.push({ msg, localFrame });
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::sendVstMidiEvent(uint32_t msg, int localFrame)
+{
+	if (realtime::isAudioThread())
+		addVstMidiEvent(msg, localFrame);
+	else
+	if (!postMidiEvent(msg, localFrame))
+		gu_log("[Channel::sendVstMidiEvent] MIDI queue full, event %#X dropped\n", msg);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Channel::drainMidiQueue()
+{
+	QueuedMidiEvent e;
+	while (midiQueue.pop(e))
+		addVstMidiEvent(e.msg, e.frame);
+}
+
+
 #endif
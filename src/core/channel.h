@@ -36,6 +36,9 @@
 #include "midiEvent.h"
 #include "recorder.h"
 #include "audioBuffer.h"
+#include "meter.h"
+#include "queue.h"
+#include "const.h"
 
 #ifdef WITH_VST
 	#include "../deps/juce-config.h"
@@ -43,6 +46,8 @@
 
 
 class Plugin;
+class Wave;
+class ColumnBus;
 class MidiMapConf;
 class geChannel;
 
@@ -54,8 +59,9 @@ protected:
 	Channel(int type, int status, int bufferSize);
 
 	/* sendMidiLMessage
-	Composes a MIDI message by merging bytes from MidiMap conf class, and sends it 
-	to KernelMidi. */
+	Composes a MIDI message by merging bytes from MidiMap conf class, and queues it
+	for KernelMidi: it's sent by the video thread, as this is often called by the 
+	audio thread. */
 
 	void sendMidiLmessage(uint32_t learn, const giada::m::midimap::message_t& msg);
 
@@ -77,6 +83,18 @@ protected:
 
 	juce::MidiBuffer midiBuffer;
 
+	/* QueuedMidiEvent, midiQueue
+	MIDI events posted from threads other than the audio one. They reach 
+	midiBuffer at the beginning of the next block, see drainMidiQueue(). */
+
+	struct QueuedMidiEvent
+	{
+		uint32_t msg;
+		int      frame;
+	};
+
+	giada::m::MpscQueue<QueuedMidiEvent, G_CHANNEL_MIDI_QUEUE> midiQueue;
+
 #endif
 
 	/* bufferSize
@@ -92,15 +110,60 @@ protected:
 	float volume_d;
 
 	bool mute_i;                // internal mute
+
+	/* producing
+	Whether the channel has produced signal since the last call to updateTail(). 
+	Set it from the audio thread whenever new data is written into vChan. */
+
+	bool producing;
+
+	/* tailFrames
+	Frames of plug-in tail left to render once the channel has stopped producing
+	signal. */
+
+	int tailFrames;
+
+	/* sleeping
+	True if buffers have been cleared when the channel went idle. See 
+	prepareBuffers(). */
+
+	bool sleeping;
+
+	/* frozenWave
+	Pre-rendered loop played back while the channel is frozen. See freeze(). */
+
+	Wave* frozenWave;
+
+	/* isProducing
+	Tells whether the channel generates signal in the current block, plug-in 
+	tails excluded. Base implementation checks for pending plug-in MIDI events. */
+
+	virtual bool isProducing() const;
+
+	/* updateTail
+	Re-arms the plug-in tail countdown while the channel is producing signal,
+	consumes it otherwise. Call it once per block from process(), before the
+	plug-in stack is processed. */
+
+	void updateTail();
+
+	/* getOutputGain
+	Returns the gain applied to audio channel 'ch' (0 or 1) of vChan when it is
+	mixed into the output buffer. */
+
+	virtual float getOutputGain(int ch);
 	
 public:
 
 	virtual ~Channel();
 
 	/* copy
-	Makes a shallow copy (no vChan/pChan allocation) of another channel. */
+	Makes a shallow copy (no vChan/pChan allocation) of another channel. Recorded
+	actions of 'src' are cloned for this channel too, unless 'withActions' is 
+	false: set 'index' before calling it. */
 
-	virtual void copy(const Channel* src, pthread_mutex_t* pluginMutex) = 0;
+	virtual void copy(const Channel* src, pthread_mutex_t* pluginMutex, 
+		bool withActions=true) = 0;
 
 	/* process
 	Merges vChannels into buffer, plus plugin processing (if any). Warning:
@@ -218,8 +281,72 @@ public:
 
 	virtual bool allocBuffers();
 
+	/* prefault
+	Touches every page of internal buffers and Waves. See realtime::prefault. */
+
+	virtual void prefault() const;
+
 	bool isPlaying() const;
 	float getPan() const;
+
+	/* isActive
+	Tells whether the mixer has to render this channel in the current block: it
+	is producing signal or it still has a plug-in tail to play. Idle channels are
+	skipped. */
+
+	bool isActive() const;
+
+	/* prepareBuffers
+	Clears buffers at the beginning of each block. Idle channels are cleared only
+	once, when they fall asleep, so that they are already silent if they wake up 
+	in the middle of a block. */
+
+	void prepareBuffers();
+
+#ifdef WITH_VST
+
+	/* drainMidiQueue
+	Moves queued MIDI events into midiBuffer. Only the thread processing the 
+	channel: the audio thread, or the one rendering a private copy. */
+
+	void drainMidiQueue();
+
+#endif
+
+	/* freeze, unfreeze, isFrozen
+	A frozen channel plays back a pre-rendered Wave in sync with the sequencer, 
+	instead of running its live chain. Plug-ins stay in the stack with their 
+	state, but they are not processed: parameter changes are still applied every
+	block, MIDI events are dropped. freeze() takes ownership of 'w', 
+	unfreeze() gives it back to the caller. Call them with mixer::mutex_chans 
+	locked. */
+
+	void freeze(Wave* w);
+	Wave* unfreeze();
+	bool isFrozen() const;
+
+	/* sumFrozen
+	Copies frame 'globalFrame' of the frozen Wave into vChan at 'frame', or 
+	silence if the sequencer is not running, the channel is muted or not 
+	playing. Solo is handled by the mixer as for live channels. */
+
+	void sumFrozen(int frame, int globalFrame, bool running);
+
+	/* updateLevel
+	Measures vChan post-fader into 'level'. Call it after process(). */
+
+	void updateLevel();
+
+#ifdef WITH_VST
+
+	/* sumSend
+	Adds the content of vChan to send bus 'bus', post-fader and scaled by the 
+	send level. Call it after process(). */
+
+	void sumSend(giada::m::AudioBuffer& out, int bus);
+
+#endif
+
 	bool isPreview() const;
 
 	/* isMidiAllowed
@@ -249,9 +376,49 @@ public:
 
 	void clearMidiBuffer();
 
+	/* addVstMidiEvent
+	Adds a new MIDI event to midiBuffer from a composite uint32_t raw MIDI event.
+	LocalFrame is the offset: it tells where to put the event inside the buffer.
+	Audio thread only: use postMidiEvent() anywhere else. */
+
+	void addVstMidiEvent(uint32_t msg, int localFrame);
+
+	/* postMidiEvent
+	Queues a MIDI event for the channel plug-ins from any thread, without locking.
+	It is delivered at the beginning of the next block. Returns false if the 
+	queue is full and the event was dropped. */
+
+	bool postMidiEvent(uint32_t msg, int localFrame=0);
+
+	/* sendVstMidiEvent
+	Delivers a MIDI event to the channel plug-ins from any thread: within the 
+	current block at 'localFrame' if called by the audio thread, at the beginning
+	of the next one otherwise. */
+
+	void sendVstMidiEvent(uint32_t msg, int localFrame=0);
+
 #endif
 
   geChannel* guiChannel;        // pointer to a gChannel object, part of the GUI
+
+	/* columnBus
+	Column bus this channel is summed into, or nullptr if it goes straight to the
+	master output. */
+
+	ColumnBus* columnBus;
+
+	/* column, size
+	Keyboard column the channel belongs to and height of its row in the main 
+	window. Kept in the model: channels scrolled out of view have no widget. */
+
+	int column;
+	int size;
+
+	/* level
+	Output level of the last block, written by the audio thread under 
+	mixer::mutex_chans. Zero if the channel is idle. */
+
+	giada::m::meter::Level level;
 	
 	/* previewMode
 	Whether the channel is in audio preview mode or not. */
@@ -301,6 +468,11 @@ public:
 
 #ifdef WITH_VST
   std::vector <Plugin*> plugins;
+
+	/* sendLevels
+	How much signal is sent to each send bus, from 0.0 (no send) to 1.0. */
+
+	float sendLevels[G_MAX_SEND_BUSES];
 #endif
 
 };
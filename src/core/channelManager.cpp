@@ -25,7 +25,6 @@
  * -------------------------------------------------------------------------- */
 
 
-#include "../gui/elems/mainWindow/keyboard/channel.h"
 #include "../utils/fs.h"
 #include "const.h"
 #include "channel.h"
@@ -70,8 +69,9 @@ void writePlugins_(const Channel* ch, patch::channel_t& pch)
 
 	pluginHost::forEachPlugin(pluginHost::CHANNEL, ch, [&] (const Plugin* p) {
 		patch::plugin_t pp;
-		pp.path   = p->getUniqueId();
-		pp.bypass = p->isBypassed();
+		pp.path      = p->getUniqueId();
+		pp.bypass    = p->isBypassed();
+		pp.keepAwake = p->isKeptAwake();
 		for (int k=0; k<p->getNumParameters(); k++)
 			pp.params.push_back(p->getParameter(k));
 		for (uint32_t param : p->midiInParams)
@@ -79,6 +79,9 @@ void writePlugins_(const Channel* ch, patch::channel_t& pch)
 		pch.plugins.push_back(pp);
 	});
 
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		pch.sendLevels.push_back(ch->sendLevels[i]);
+
 #endif
 }
 } // {anonymous}
@@ -110,6 +113,7 @@ void readPlugins_(Channel* ch, const patch::channel_t& pch)
 			continue;
 
 		plugin->setBypass(ppl.bypass);
+		plugin->setKeepAwake(ppl.keepAwake);
 		for (unsigned j=0; j<ppl.params.size(); j++)
 			plugin->setParameter(j, ppl.params.at(j));
 
@@ -123,6 +127,9 @@ void readPlugins_(Channel* ch, const patch::channel_t& pch)
 		}
 	}
 
+	for (unsigned i=0; i<pch.sendLevels.size() && i<G_MAX_SEND_BUSES; i++)
+		ch->sendLevels[i] = pch.sendLevels.at(i);
+
 #endif
 }
 
@@ -159,11 +166,11 @@ int writePatch(const Channel* ch, bool isProject)
 	patch::channel_t pch;
 	pch.type            = ch->type;
 	pch.index           = ch->index;
-	pch.size            = ch->guiChannel->getSize();
+	pch.size            = ch->size;
 	pch.name            = ch->name;
 	pch.key             = ch->key;
 	pch.armed           = ch->armed;
-	pch.column          = ch->guiChannel->getColumnIndex();
+	pch.column          = ch->column;
 	pch.mute            = ch->mute;
 	// pch.mute_s          = ch->mute_s;  TODO remove it with mute refactoring
 	pch.solo            = ch->solo;
@@ -26,12 +26,13 @@
 
 
 #include <cassert>
-#include "../glue/transport.h"
-#include "../glue/main.h"
+#include <cstring>
 #include "conf.h"
 #include "const.h"
 #include "kernelAudio.h"
 #include "kernelMidi.h"
+#include "uiState.h"
+#include "eventLog.h"
 #include "clock.h"
 
 
@@ -337,22 +338,33 @@ void recvJackSync()
 {
 	kernelAudio::JackState jackState = kernelAudio::jackTransportQuery();
 
+	/* Called by the audio thread: the actual work is left to the video thread,
+	see gu_refreshUI(). */
+
 	if (jackState.running != jackStatePrev.running) {
 		if (jackState.running) {
 			if (!isRunning())
-				glue_startSeq(false); // not from UI
+				uiState::postEvent(uiState::TRANSPORT_START);
 		}
 		else {
 			if (isRunning())
-				glue_stopSeq(false); // not from UI
+				uiState::postEvent(uiState::TRANSPORT_STOP);
 		}
 	}
 	if (jackState.bpm != jackStatePrev.bpm)
 		if (jackState.bpm > 1.0f)  // 0 bpm if Jack does not send that info
-			glue_setBpm(jackState.bpm);
+			uiState::postEvent(uiState::SET_BPM, 0, jackState.bpm);
 
 	if (jackState.frame == 0 && jackState.frame != jackStatePrev.frame)
-		glue_rewindSeq(false, false);  // not from UI, don't notify jack (avoid loop)
+		uiState::postEvent(uiState::TRANSPORT_REWIND);
+
+	if (jackState.running != jackStatePrev.running || jackState.bpm != jackStatePrev.bpm ||
+	    jackState.frame != jackStatePrev.frame) {
+		float bpm = jackState.bpm;
+		int   bits;
+		memcpy(&bits, &bpm, sizeof(bits));
+		eventLog::capture(eventLog::JACK, bits, jackState.frame, jackState.running);
+	}
 
 	jackStatePrev = jackState;
 }
@@ -0,0 +1,114 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "../utils/log.h"
+#include "const.h"
+#include "pluginHost.h"
+#include "bufferPool.h"
+#include "columnBus.h"
+
+
+using namespace giada::m;
+
+
+int ColumnBus::idGenerator = 1;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+ColumnBus::ColumnBus()
+: id    (idGenerator++),
+	volume(G_DEFAULT_VOL),
+	mute  (false),
+	fed   (false)
+{
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+ColumnBus::~ColumnBus()
+{
+	bufferPool::release(vChan);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool ColumnBus::allocBuffers()
+{
+	if (!bufferPool::acquire(vChan)) {
+		gu_log("[ColumnBus::allocBuffers] unable to alloc memory for vChan!\n");
+		return false;
+	}
+	return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void ColumnBus::prepareBuffers()
+{
+	vChan.clear();
+	fed = false;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool ColumnBus::isActive() const
+{
+#ifdef WITH_VST
+	return fed || plugins.size() > 0;
+#else
+	return fed;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void ColumnBus::process(AudioBuffer& out)
+{
+#ifdef WITH_VST
+	pluginHost::processStack(vChan, plugins);
+#endif
+
+	if (mute)
+		return;
+
+	for (int i=0; i<out.countFrames(); i++)
+		for (int j=0; j<out.countChannels(); j++)
+			out[i][j] += vChan[i][j] * volume;
+}
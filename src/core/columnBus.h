@@ -0,0 +1,104 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_COLUMN_BUS_H
+#define G_COLUMN_BUS_H
+
+
+#include <vector>
+#include "audioBuffer.h"
+
+
+class Plugin;
+
+
+/* ColumnBus
+Submix bus of a keyboard column. Channels routed to a bus are summed into its 
+vChan instead of the master output; the sum goes through the bus plug-in stack
+and volume, once per block, before reaching the master. */
+
+class ColumnBus
+{
+private:
+
+	static int idGenerator;
+
+public:
+
+	ColumnBus();
+	~ColumnBus();
+
+	/* allocBuffers
+	Mandatory method to allocate memory for internal buffers. Call it after the
+	object has been constructed. */
+
+	bool allocBuffers();
+
+	/* prepareBuffers
+	Clears vChan at the beginning of each block. */
+
+	void prepareBuffers();
+
+	/* isActive
+	Tells whether the bus has to be rendered in the current block: some channel
+	has been summed into it, or it has plug-ins that might still ring. */
+
+	bool isActive() const;
+
+	/* process
+	Runs vChan through the plug-in stack, then mixes it into 'out' (unless
+	muted). */
+
+	void process(giada::m::AudioBuffer& out);
+
+	/* id
+	Unique id, used to address the plug-in stack. See pluginHost::COLUMN_BUS. */
+
+	int id;
+
+	float volume;
+	bool  mute;
+
+	/* fed
+	True if some channel has been summed into vChan in the current block. Set by
+	the mixer. */
+
+	bool fed;
+
+	/* vChan
+	Sum of the channels routed to this bus. */
+
+	giada::m::AudioBuffer vChan;
+
+#ifdef WITH_VST
+	std::vector<Plugin*> plugins;
+#endif
+};
+
+
+#endif
@@ -0,0 +1,292 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <thread>
+#include <vector>
+#include "../utils/log.h"
+#include "../utils/time.h"
+#include "const.h"
+#include "conf.h"
+#include "queue.h"
+#include "clock.h"
+#include "kernelAudio.h"
+#include "channel.h"
+#include "commandQueue.h"
+
+
+namespace giada {
+namespace m {
+namespace commandQueue
+{
+namespace
+{
+struct Command
+{
+	int      type;
+	Channel* ch;
+	uint32_t raw;
+	float    value;
+	int64_t  time;
+	int      frame;
+};
+
+/* queue
+Commands posted by the GUI and MIDI threads, waiting for the next block. */
+
+MpscQueue<Command, G_COMMAND_QUEUE> queue;
+
+/* commands, numCommands, next
+Commands of the current block, sorted by frame. 'next' is the first one not 
+applied yet. Audio thread only. */
+
+std::array<Command, G_COMMAND_QUEUE> commands;
+int numCommands = 0;
+int next      = 0;
+
+/* blocks
+Number of blocks started, for forget(). */
+
+std::atomic<uint64_t> blocks(0);
+
+/* latSum, latMin, latMax, latCount
+Latency accumulators for the current window, in nanoseconds. Audio thread 
+only. */
+
+int64_t latSum   = 0;
+int64_t latMin   = std::numeric_limits<int64_t>::max();
+int64_t latMax   = 0;
+int     latCount = 0;
+
+/* statAvg, statMin, statMax, statWindow
+Last complete window, published by the audio thread for logStats(). statWindow
+is bumped after the values are written. */
+
+std::atomic<int64_t> statAvg(0);
+std::atomic<int64_t> statMin(0);
+std::atomic<int64_t> statMax(0);
+std::atomic<int>     statWindow(0);
+
+int lastWindow = 0;  // MIDI thread only
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void measure(const Command& c, int64_t blockStart, int samplerate)
+{
+	int64_t lat = blockStart + (int64_t) c.frame * 1000000000LL / samplerate - c.time;
+
+	latSum += lat;
+	latMin  = std::min(latMin, lat);
+	latMax  = std::max(latMax, lat);
+
+	if (++latCount < G_MIDI_JITTER_WINDOW)
+		return;
+
+	statAvg.store(latSum / latCount, std::memory_order_relaxed);
+	statMin.store(latMin, std::memory_order_relaxed);
+	statMax.store(latMax, std::memory_order_relaxed);
+	statWindow.fetch_add(1, std::memory_order_release);
+
+	latSum   = 0;
+	latMin   = std::numeric_limits<int64_t>::max();
+	latMax   = 0;
+	latCount = 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void apply(const Command& c)
+{
+	Channel* ch = c.ch;
+
+	switch (c.type) {
+		case KEY_PRESS:
+			if (c.value >= 0.0f)
+				ch->setVolumeI(c.value);
+			ch->start(c.frame, true, clock::getQuantize(), clock::isRunning(), false, 
+				true);
+			break;
+		case KEY_RELEASE:
+			ch->stop();
+			break;
+		case KILL:
+			ch->kill(c.frame);
+			break;
+		case TOGGLE_MUTE:
+			ch->mute ? ch->unsetMute(false) : ch->setMute(false);
+			break;
+		case SET_VOLUME:
+			ch->volume = c.value;
+			break;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* schedule
+Inserts a command keeping the list sorted by frame. Producers on different 
+threads may push out of time order, but only slightly: the insertion is almost
+always an append. Commands on the same frame keep their queue order. The list
+must not be full, see prepare(). */
+
+void schedule(const Command& c)
+{
+	int i = numCommands++;
+	for (; i > 0 && commands[i - 1].frame > c.frame; i--)
+		commands[i] = commands[i - 1];
+	commands[i] = c;
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+bool post(int type, Channel* ch, int64_t time, uint32_t raw, float value)
+{
+	if (!kernelAudio::isRunning())
+		return false;
+	if (queue.push({ type, ch, raw, value, time != 0 ? time : u::time::now(), 0 }))
+		return true;
+	gu_log("[commandQueue::post] queue full, command %d applied by the caller\n", type);
+	return false;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void prepare(int64_t blockStart, int bufferSize)
+{
+	numCommands = 0;
+	next        = 0;
+	blocks.fetch_add(1, std::memory_order_release);
+
+	Command c;
+	if (!queue.pop(c))
+		return;
+
+	int     samplerate = conf::samplerate;
+	int64_t blockNs    = (int64_t) bufferSize * 1000000000LL / samplerate;
+	int64_t prevStart  = blockStart - blockNs;
+	bool    accurate   = conf::midiInTiming == MIDI_IN_TIMING_ACCURATE;
+
+	do {
+		if (accurate) {
+			int64_t f = (c.time - prevStart) * samplerate / 1000000000LL;
+			c.frame = (int) std::max<int64_t>(0, std::min<int64_t>(f, bufferSize - 1));
+		}
+		if (c.type == PROBE)
+			measure(c, blockStart, samplerate);
+		else
+		if (c.type == MIDI) {
+#ifdef WITH_VST
+			c.ch->addVstMidiEvent(c.raw, c.frame);
+#endif
+		}
+		else
+			schedule(c);
+	}
+	while (numCommands < G_COMMAND_QUEUE && queue.pop(c));
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void process(int frame)
+{
+	if (next == numCommands || commands[next].frame > frame)
+		return;
+
+	while (next < numCommands && commands[next].frame <= frame)
+		apply(commands[next++]);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void forget(Channel* ch)
+{
+	/* Commands posted before now are popped by the next block that starts, and 
+	applied before the one after it starts. The stream is started and stopped 
+	by this thread: it can't stop while waiting. */
+
+	uint64_t target = blocks.load(std::memory_order_acquire) + 2;
+	for (int i=1; kernelAudio::isRunning(); i++) {
+		if (blocks.load(std::memory_order_acquire) >= target)
+			return;
+		if (i % G_COMMAND_SYNC_TIMEOUT == 0)
+			gu_log("[commandQueue::forget] audio thread stalled, still waiting...\n");
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	/* Stream stopped: the last block has been completed, so this thread is the 
+	only consumer left. Keep commands for other channels for when the stream 
+	starts again. */
+
+	std::vector<Command> kept;
+	Command c;
+	while (queue.pop(c))
+		if (c.ch != ch)
+			kept.push_back(c);
+	for (const Command& k : kept)
+		queue.push(k);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void logStats()
+{
+	int window = statWindow.load(std::memory_order_acquire);
+	if (window == lastWindow)
+		return;
+	lastWindow = window;
+
+	double avg = statAvg.load(std::memory_order_relaxed) / 1000000.0;
+	double min = statMin.load(std::memory_order_relaxed) / 1000000.0;
+	double max = statMax.load(std::memory_order_relaxed) / 1000000.0;
+
+	gu_log("[commandQueue] latency over %d events: avg=%.3f ms, min=%.3f ms, max=%.3f ms, jitter=%.3f ms\n",
+		G_MIDI_JITTER_WINDOW, avg, min, max, max - min);
+}
+}}}; // giada::m::commandQueue::
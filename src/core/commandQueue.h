@@ -0,0 +1,105 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_COMMAND_QUEUE_H
+#define G_COMMAND_QUEUE_H
+
+
+#include <cstdint>
+
+
+class Channel;
+
+
+namespace giada {
+namespace m {
+namespace commandQueue
+{
+/* commandType
+Channel state changes requested by the GUI and MIDI threads. They are never 
+applied by the requesting thread: the audio thread picks them up at the start
+of the next block and applies each one on its own frame. PROBE does nothing: it
+only measures the input-to-output latency when the jitter log is enabled. */
+
+enum commandType
+{
+	KEY_PRESS,
+	KEY_RELEASE,
+	KILL,
+	TOGGLE_MUTE,
+	SET_VOLUME,
+	MIDI,
+	PROBE
+};
+
+/* post
+Queues a command for channel 'ch' (nullptr for PROBE). The audio thread uses 
+the pointer as is, without looking the channel up: see forget(). 'raw' is the 
+MIDI message for MIDI commands. 'value' is the new volume for SET_VOLUME, the velocity-driven 
+internal volume for KEY_PRESS (negative: leave it untouched). 'time' is the 
+time the command was issued, as returned by u::time::now(), or 0 for now. 
+Returns false if the queue is full or the audio stream is not running: the 
+command is dropped and the caller should apply it on its own. Any thread. */
+
+bool post(int type, Channel* ch, int64_t time, uint32_t raw=0, float value=-1.0f);
+
+/* prepare
+Collects the commands issued during the previous block and, with sample-accurate
+input timing, maps their time to a frame in the current one: they are played 
+back with one buffer of constant latency instead of being rounded to the block
+boundary. 'blockStart' is the time the audio callback was entered. MIDI 
+commands are delivered to plug-ins straight away. Commands that don't fit in
+the current block stay in the queue for the next one. Audio thread only. */
+
+void prepare(int64_t blockStart, int bufferSize);
+
+/* process
+Applies the commands scheduled at 'frame'. Audio thread only. */
+
+void process(int frame);
+
+/* forget
+Makes sure that no pending command points to channel 'ch'. Call it after the 
+channel has been removed from mixer::channels and before it is deleted. While 
+the stream runs, waits for the audio thread to apply every command posted so 
+far, however long it takes (a warning is logged every G_COMMAND_SYNC_TIMEOUT 
+ms). Otherwise nobody consumes the queue: drains it on its own and drops the 
+commands for 'ch'. Main thread only. */
+
+void forget(Channel* ch);
+
+/* logStats
+Logs average, minimum and maximum input-to-output latency, plus jitter, once a
+new window of G_MIDI_JITTER_WINDOW probes has been measured. MIDI thread 
+only. */
+
+void logStats();
+}}}; // giada::m::commandQueue::
+
+
+#endif
@@ -61,6 +61,8 @@ void sanitize()
 	if (channelsIn < 0)  channelsIn  = 0;
 	if (buffersize < G_MIN_BUF_SIZE || buffersize > G_MAX_BUF_SIZE) buffersize = G_DEFAULT_BUFSIZE;
 	if (delayComp < 0) delayComp = G_DEFAULT_DELAYCOMP;
+	if (nullSpeed <= 0.0f) nullSpeed = 1.0f;
+	if (rtPriority < 0 || rtPriority > 99) rtPriority = 0;
 	if (midiPortOut < -1) midiPortOut = G_DEFAULT_MIDI_SYSTEM;
 	if (midiPortOut < -1) midiPortOut = G_DEFAULT_MIDI_PORT_OUT;
 	if (midiPortIn < -1) midiPortIn = G_DEFAULT_MIDI_PORT_IN;
@@ -102,6 +104,7 @@ void sanitize()
 	if (aboutY < 0) aboutY = 0;
 	if (samplerate < 8000) samplerate = G_DEFAULT_SAMPLERATE;
 	if (rsmpQuality < 0 || rsmpQuality > 4) rsmpQuality = 0;
+	if (midiInTiming != MIDI_IN_TIMING_IMMEDIATE) midiInTiming = MIDI_IN_TIMING_ACCURATE;
 }
 
 
@@ -158,6 +161,12 @@ int  buffersize     = G_DEFAULT_BUFSIZE;
 int  delayComp      = G_DEFAULT_DELAYCOMP;
 bool limitOutput    = false;
 int  rsmpQuality    = 0;
+float  nullSpeed     = 1.0f;
+string nullInputPath = "";
+int  rtPriority       = 0;
+int  rtCpuMask        = 0;
+bool rtLockMemory     = false;
+bool rtFlushDenormals = false;
 
 int    midiSystem  = 0;
 int    midiPortOut = G_DEFAULT_MIDI_PORT_OUT;
@@ -167,6 +176,8 @@ string midiMapPath = "";
 string lastFileMap = "";
 int    midiSync    = MIDI_SYNC_NONE;
 float  midiTCfps   = 25.0f;
+int    midiInTiming    = MIDI_IN_TIMING_ACCURATE;
+bool   midiInJitterLog = false;
 
 bool midiIn               = false;
 int midiInFilter          = -1;
@@ -318,6 +329,12 @@ int read()
 	if (!storager::setInt(jRoot, CONF_KEY_DELAY_COMPENSATION, delayComp)) return 0;
 	if (!storager::setBool(jRoot, CONF_KEY_LIMIT_OUTPUT, limitOutput)) return 0;
 	if (!storager::setInt(jRoot, CONF_KEY_RESAMPLE_QUALITY, rsmpQuality)) return 0;
+	if (!storager::setFloat(jRoot, CONF_KEY_NULL_SPEED, nullSpeed)) return 0;
+	if (!storager::setString(jRoot, CONF_KEY_NULL_INPUT_PATH, nullInputPath)) return 0;
+	if (!storager::setInt(jRoot, CONF_KEY_RT_PRIORITY, rtPriority)) return 0;
+	if (!storager::setInt(jRoot, CONF_KEY_RT_CPU_MASK, rtCpuMask)) return 0;
+	if (!storager::setBool(jRoot, CONF_KEY_RT_LOCK_MEMORY, rtLockMemory)) return 0;
+	if (!storager::setBool(jRoot, CONF_KEY_RT_FLUSH_DENORMALS, rtFlushDenormals)) return 0;
 	if (!storager::setInt(jRoot, CONF_KEY_MIDI_SYSTEM, midiSystem)) return 0;
 	if (!storager::setInt(jRoot, CONF_KEY_MIDI_PORT_OUT, midiPortOut)) return 0;
 	if (!storager::setInt(jRoot, CONF_KEY_MIDI_PORT_IN, midiPortIn)) return 0;
@@ -326,6 +343,8 @@ int read()
 	if (!storager::setString(jRoot, CONF_KEY_LAST_MIDIMAP, lastFileMap)) return 0;
 	if (!storager::setInt(jRoot, CONF_KEY_MIDI_SYNC, midiSync)) return 0;
 	if (!storager::setFloat(jRoot, CONF_KEY_MIDI_TC_FPS, midiTCfps)) return 0;
+	if (!storager::setInt(jRoot, CONF_KEY_MIDI_IN_TIMING, midiInTiming)) return 0;
+	if (!storager::setBool(jRoot, CONF_KEY_MIDI_IN_JITTER_LOG, midiInJitterLog)) return 0;
 	if (!storager::setBool(jRoot, CONF_KEY_MIDI_IN, midiIn)) return 0; 
 	if (!storager::setInt(jRoot, CONF_KEY_MIDI_IN_FILTER, midiInFilter)) return 0; 
 	if (!storager::setUint32(jRoot, CONF_KEY_MIDI_IN_REWIND, midiInRewind)) return 0; 
@@ -428,6 +447,12 @@ int write()
 	json_object_set_new(jRoot, CONF_KEY_DELAY_COMPENSATION,        json_integer(delayComp));
 	json_object_set_new(jRoot, CONF_KEY_LIMIT_OUTPUT,              json_boolean(limitOutput));
 	json_object_set_new(jRoot, CONF_KEY_RESAMPLE_QUALITY,          json_integer(rsmpQuality));
+	json_object_set_new(jRoot, CONF_KEY_NULL_SPEED,                json_real(nullSpeed));
+	json_object_set_new(jRoot, CONF_KEY_NULL_INPUT_PATH,           json_string(nullInputPath.c_str()));
+	json_object_set_new(jRoot, CONF_KEY_RT_PRIORITY,               json_integer(rtPriority));
+	json_object_set_new(jRoot, CONF_KEY_RT_CPU_MASK,               json_integer(rtCpuMask));
+	json_object_set_new(jRoot, CONF_KEY_RT_LOCK_MEMORY,            json_boolean(rtLockMemory));
+	json_object_set_new(jRoot, CONF_KEY_RT_FLUSH_DENORMALS,        json_boolean(rtFlushDenormals));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_SYSTEM,               json_integer(midiSystem));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_PORT_OUT,             json_integer(midiPortOut));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_PORT_IN,              json_integer(midiPortIn));
@@ -436,6 +461,8 @@ int write()
 	json_object_set_new(jRoot, CONF_KEY_LAST_MIDIMAP,              json_string(lastFileMap.c_str()));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_SYNC,                 json_integer(midiSync));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_TC_FPS,               json_real(midiTCfps));
+	json_object_set_new(jRoot, CONF_KEY_MIDI_IN_TIMING,            json_integer(midiInTiming));
+	json_object_set_new(jRoot, CONF_KEY_MIDI_IN_JITTER_LOG,        json_boolean(midiInJitterLog));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_IN,                   json_boolean(midiIn));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_IN_FILTER,            json_integer(midiInFilter));
 	json_object_set_new(jRoot, CONF_KEY_MIDI_IN_REWIND,            json_integer(midiInRewind));
@@ -59,6 +59,12 @@ extern int  buffersize;
 extern int  delayComp;
 extern bool limitOutput;
 extern int  rsmpQuality;
+extern float       nullSpeed;      // null device only: 1.0 = real time
+extern std::string nullInputPath;  // null device only: input file, if any
+extern int  rtPriority;        // SCHED_FIFO priority of the audio thread, 0 = as given
+extern int  rtCpuMask;         // CPUs the audio thread may run on, bit n = CPU n, 0 = any
+extern bool rtLockMemory;      // mlockall() and prefault buffers on stream start
+extern bool rtFlushDenormals;  // FTZ/DAZ on the audio thread
 
 extern int  midiSystem;
 extern int  midiPortOut;
@@ -68,6 +74,8 @@ extern std::string midiMapPath;
 extern std::string lastFileMap;
 extern int   midiSync;  // see const.h
 extern float midiTCfps;
+extern int   midiInTiming;     // see const.h
+extern bool  midiInJitterLog;  // log input-to-output latency of MIDI events
 
 extern bool midiIn;
 extern int midiInFilter;
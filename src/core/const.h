@@ -64,6 +64,9 @@
 
 /* -- GUI ------------------------------------------------------------------- */
 #define G_GUI_REFRESH_RATE   1000/24
+#define G_GUI_IDLE_RATE      1000/6  // refresh rate when nothing changes
+#define G_GUI_IDLE_CYCLES    24      // unchanged refreshes before going idle
+#define G_GUI_PEAK_HOLD      24      // refreshes a meter holds its peak for
 #define G_GUI_PLUGIN_RATE    0.05  // refresh rate for plugin GUI
 #define G_GUI_FONT_SIZE_BASE 12
 #define G_GUI_INNER_MARGIN   4
@@ -110,6 +113,76 @@
 
 
 
+/* -- buffer pool ----------------------------------------------------------- */
+#define G_BUFFER_ALIGN      64  // bytes, one cache line
+#define G_BUFFER_POOL_CHUNK 16  // slots allocated at once when the pool grows
+
+
+
+/* -- command queue --------------------------------------------------------- */
+#define G_COMMAND_QUEUE        1024  // pending channel commands, power of two
+#define G_COMMAND_SYNC_TIMEOUT 1000  // ms, see commandQueue::forget()
+
+
+
+/* -- UI state -------------------------------------------------------------- */
+#define G_UI_STATE_CHANNELS 1024  // channels in the engine snapshot
+#define G_UI_EVENT_QUEUE    256   // pending engine-to-UI events, power of two
+
+
+
+/* -- profiler -------------------------------------------------------------- */
+#define G_PROFILER_QUEUE   32768  // pending timing events, power of two
+#define G_PROFILER_REFRESH 12     // GUI refreshes between profiler window updates
+
+
+
+/* -- realtime audit -------------------------------------------------------- */
+#define G_RT_AUDIT_QUEUE        4096  // pending violations
+#define G_RT_AUDIT_FRAMES       18    // backtrace depth, interceptor included
+#define G_RT_AUDIT_ALLOWED      8     // known engine mutexes, see rtAudit::allow()
+#define G_RT_AUDIT_KNOWN_TRACED 64    // known mutex locks traced before just counting
+
+
+
+/* -- realtime setup -------------------------------------------------------- */
+#define G_RT_REPORT_TIMEOUT 1000  // ms to wait for the first callback
+
+
+
+/* -- trace ----------------------------------------------------------------- */
+#define G_TRACE_THREADS 16    // traced threads
+#define G_TRACE_EVENTS  8192  // pending events, per thread
+
+
+
+/* -- stem export ----------------------------------------------------------- */
+#define G_STEMS_QUEUE 64  // rendered blocks waiting for the writer thread
+
+
+
+/* -- event log ------------------------------------------------------------- */
+#define G_EVENT_LOG_QUEUE 4096  // captured inputs waiting for collect(), power of two
+
+
+
+/* -- benchmark ------------------------------------------------------------- */
+#define G_BENCH_WARMUP           16      // untimed callbacks before timing
+#define G_BENCH_ITERATIONS       100000  // micro benchmarks, cheap ones
+#define G_BENCH_WAVE_ITERATIONS  20      // micro benchmarks, whole-Wave ones
+#define G_BENCH_PATCH_ITERATIONS 20
+#define G_BENCH_PEAKS            1024    // waveform width, in pixels
+
+
+
+/* -- plugin host ----------------------------------------------------------- */
+#define G_PLUGIN_SLEEP_THRESHOLD 0.00001f  // -100 dB, below which a block is silent
+#define G_MAX_SEND_BUSES         4
+#define G_PLUGIN_PARAM_QUEUE     256  // pending parameter changes, per plugin and producer
+#define G_CHANNEL_MIDI_QUEUE     256  // pending MIDI events per channel, power of two
+
+
+
 /* -- kernel audio ---------------------------------------------------------- */
 #define G_SYS_API_NONE		0x00  // 0000 0000
 #define G_SYS_API_JACK		0x01  // 0000 0001
@@ -119,13 +192,16 @@
 #define G_SYS_API_CORE		0x10  // 0001 0000
 #define G_SYS_API_PULSE   0x20  // 0010 0000
 #define G_SYS_API_WASAPI  0x40  // 0100 0000
-#define G_SYS_API_ANY     0x7F  // 0111 1111
+#define G_SYS_API_NULL    0x80  // 1000 0000, no device: timer-driven callback
+#define G_SYS_API_ANY     0xFF  // 1111 1111
 
 
 
 /* -- kernel midi ----------------------------------------------------------- */
 #define G_MIDI_API_JACK		0x01  // 0000 0001
 #define G_MIDI_API_ALSA		0x02  // 0000 0010
+#define G_MIDI_JITTER_WINDOW 64    // events per latency report
+#define G_MIDI_NOTES         128   // notes per MIDI channel
 
 
 
@@ -234,6 +310,9 @@
 #define LOG_MODE_STDOUT 0x01
 #define LOG_MODE_FILE   0x02
 #define LOG_MODE_MUTE   0x04
+#define G_LOG_QUEUE     2048  // pending messages, power of two
+#define G_LOG_LINE      512   // max message length, terminator included
+#define G_LOG_SLEEP     10    // writer thread idle time, in milliseconds
 
 
 
@@ -256,6 +335,9 @@
 #define WID_FX            -9
 #define WID_KEY_GRABBER   -10
 #define WID_SAMPLE_NAME   -11
+#define WID_CHANNEL_SENDS -12
+#define WID_COLUMN_BUS    -13
+#define WID_PROFILER      -14
 
 
 
@@ -334,6 +416,11 @@ const int MIDI_CHANS[16] = {
 #define MIDI_SYNC_MTC_M     0x04  // master
 #define MIDI_SYNC_MTC_S     0x08  // slave
 
+/* midi input timing constants */
+
+#define MIDI_IN_TIMING_ACCURATE  0x00  // frame offset in the next block, constant latency
+#define MIDI_IN_TIMING_IMMEDIATE 0x01  // frame 0 of the next block, jitter
+
 /* JSON patch keys */
 
 #define PATCH_KEY_HEADER                       "header"
@@ -354,6 +441,8 @@ const int MIDI_CHANS[16] = {
 #define PATCH_KEY_COLUMNS                      "columns"
 #define PATCH_KEY_MASTER_OUT_PLUGINS           "master_out_plugins"
 #define PATCH_KEY_MASTER_IN_PLUGINS            "master_in_plugins"
+#define PATCH_KEY_SEND_BUSES                   "send_buses"
+#define PATCH_KEY_SEND_BUS_PLUGINS             "plugins"
 #define PATCH_KEY_CHANNELS                     "channels"
 #define PATCH_KEY_CHANNEL_TYPE                 "type"
 #define PATCH_KEY_CHANNEL_INDEX                "index"
@@ -395,17 +484,23 @@ const int MIDI_CHANS[16] = {
 #define PATCH_KEY_CHANNEL_PLUGINS              "plugins"
 #define PATCH_KEY_CHANNEL_ACTIONS              "actions"
 #define PATCH_KEY_CHANNEL_ARMED                "armed"
+#define PATCH_KEY_CHANNEL_SEND_LEVELS          "send_levels"
 #define PATCH_KEY_ACTION_TYPE                  "type"
 #define PATCH_KEY_ACTION_FRAME                 "frame"
 #define PATCH_KEY_ACTION_F_VALUE               "f_value"
 #define PATCH_KEY_ACTION_I_VALUE               "i_value"
 #define PATCH_KEY_PLUGIN_PATH                  "path"
 #define PATCH_KEY_PLUGIN_BYPASS                "bypass"
+#define PATCH_KEY_PLUGIN_KEEP_AWAKE            "keep_awake"
 #define PATCH_KEY_PLUGIN_PARAMS                "params"
 #define PATCH_KEY_PLUGIN_MIDI_IN_PARAMS        "midi_in_params"
 #define PATCH_KEY_COLUMN_INDEX                 "index"
 #define PATCH_KEY_COLUMN_WIDTH                 "width"
 #define PATCH_KEY_COLUMN_CHANNELS              "channels"
+#define PATCH_KEY_COLUMN_BUS                   "bus"
+#define PATCH_KEY_COLUMN_BUS_VOLUME            "bus_volume"
+#define PATCH_KEY_COLUMN_BUS_MUTE              "bus_mute"
+#define PATCH_KEY_COLUMN_BUS_PLUGINS           "bus_plugins"
 
 /* JSON config keys */
 
@@ -420,6 +515,12 @@ const int MIDI_CHANS[16] = {
 #define CONF_KEY_BUFFER_SIZE              "buffer_size"
 #define CONF_KEY_DELAY_COMPENSATION       "delay_compensation"
 #define CONF_KEY_LIMIT_OUTPUT             "limit_output"
+#define CONF_KEY_NULL_SPEED               "null_speed"
+#define CONF_KEY_NULL_INPUT_PATH          "null_input_path"
+#define CONF_KEY_RT_PRIORITY              "rt_priority"
+#define CONF_KEY_RT_CPU_MASK              "rt_cpu_mask"
+#define CONF_KEY_RT_LOCK_MEMORY           "rt_lock_memory"
+#define CONF_KEY_RT_FLUSH_DENORMALS       "rt_flush_denormals"
 #define CONF_KEY_RESAMPLE_QUALITY         "resample_quality"
 #define CONF_KEY_MIDI_SYSTEM              "midi_system"
 #define CONF_KEY_MIDI_PORT_OUT            "midi_port_out"
@@ -429,6 +530,8 @@ const int MIDI_CHANS[16] = {
 #define CONF_KEY_LAST_MIDIMAP             "last_midimap"
 #define CONF_KEY_MIDI_SYNC                "midi_sync"
 #define CONF_KEY_MIDI_TC_FPS              "midi_tc_fps"
+#define CONF_KEY_MIDI_IN_TIMING           "midi_in_timing"
+#define CONF_KEY_MIDI_IN_JITTER_LOG       "midi_in_jitter_log"
 #define CONF_KEY_MIDI_IN                  "midi_in"
 #define CONF_KEY_MIDI_IN_FILTER           "midi_in_filter"
 #define CONF_KEY_MIDI_IN_REWIND           "midi_in_rewind"
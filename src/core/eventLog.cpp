@@ -0,0 +1,331 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include "../utils/log.h"
+#include "const.h"
+#include "conf.h"
+#include "queue.h"
+#include "eventLog.h"
+
+
+using std::string;
+using std::vector;
+
+
+namespace giada {
+namespace m {
+namespace eventLog
+{
+namespace
+{
+/* Record
+An Event on disk: 16 bytes, host byte order. Frames are relative to the 
+previous event. */
+
+struct Record
+{
+	uint32_t delta;
+	uint8_t  type;
+	uint8_t  flags;
+	uint16_t reserved;
+	int32_t  a;
+	int32_t  b;
+};
+
+static_assert(sizeof(Record) == 16, "Record must be 16 bytes");
+
+const char     MAGIC[8] = {'G', 'I', 'A', 'D', 'A', 'E', 'V', 'L'};
+const uint32_t VERSION  = 1;
+
+struct Header
+{
+	char     magic[8];
+	uint32_t version;
+	uint32_t samplerate;
+	uint32_t buffersize;
+	uint32_t count;
+};
+
+thread_local int derived = 0;
+
+std::atomic<int64_t> frames(0);       // processed by the audio thread
+std::atomic<int64_t> captureStart(0);
+std::atomic<bool>    capturing(false);
+std::atomic<int>     dropped(0);
+
+MpscQueue<Event, G_EVENT_LOG_QUEUE> queue;
+vector<Event> captured;  // collect() and stopCapture() only
+
+/* Replay data is shared between the GUI thread, which loads it, and the null
+device thread: not realtime, a mutex is fine. */
+
+std::mutex        replayMutex;
+std::atomic<bool> replaying(false);
+vector<Event>     replayed;
+size_t            replayNext  = 0;
+int64_t           replayStart = 0;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool writeFile(const string& path, const vector<Event>& events)
+{
+	FILE* f = fopen(path.c_str(), "wb");
+	if (f == nullptr) {
+		gu_log("[eventLog] unable to open %s\n", path.c_str());
+		return false;
+	}
+
+	Header h;
+	memcpy(h.magic, MAGIC, sizeof(MAGIC));
+	h.version    = VERSION;
+	h.samplerate = conf::samplerate;
+	h.buffersize = (uint32_t) conf::buffersize;
+	h.count      = events.size();
+	bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+
+	int64_t prev = 0;
+	for (const Event& e : events) {
+		Record r;
+		r.delta    = e.frame - prev;
+		r.type     = e.type;
+		r.flags    = e.flags;
+		r.reserved = 0;
+		r.a        = e.a;
+		r.b        = e.b;
+		ok  = ok && fwrite(&r, sizeof(r), 1, f) == 1;
+		prev = e.frame;
+	}
+	return fclose(f) == 0 && ok;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool readFile(const string& path, vector<Event>& events)
+{
+	FILE* f = fopen(path.c_str(), "rb");
+	if (f == nullptr) {
+		gu_log("[eventLog] unable to open %s\n", path.c_str());
+		return false;
+	}
+
+	Header h;
+	if (fread(&h, sizeof(h), 1, f) != 1 || memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0 ||
+	    h.version != VERSION) {
+		gu_log("[eventLog] %s is not a valid event log\n", path.c_str());
+		fclose(f);
+		return false;
+	}
+	if (h.samplerate != (uint32_t) conf::samplerate || 
+	    h.buffersize != (uint32_t) conf::buffersize)
+		gu_log("[eventLog] captured at %u Hz, %u frames: events will land elsewhere!\n", 
+			h.samplerate, h.buffersize);
+
+	events.clear();
+	int64_t frame = 0;
+	Record  r;
+	for (uint32_t i=0; i<h.count && fread(&r, sizeof(r), 1, f) == 1; i++) {
+		frame += r.delta;
+		events.push_back({frame, r.type, r.a, r.b, r.flags});
+	}
+	fclose(f);
+	return events.size() == h.count;
+}
+}; // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+Derived::Derived()  { derived++; }
+Derived::~Derived() { derived--; }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void capture(Type type, int a, int b, int flags)
+{
+	if (!capturing.load(std::memory_order_relaxed) || derived > 0)
+		return;
+	int64_t frame = frames.load(std::memory_order_relaxed) - captureStart.load();
+	if (!queue.push({frame, type, a, b, flags}))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void startCapture()
+{
+	collect();  // leftovers from a previous capture
+	captured.clear();
+	dropped.store(0);
+	captureStart.store(frames.load());
+	capturing.store(true);
+	gu_log("[eventLog] capture started\n");
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int stopCapture(const string& path)
+{
+	capturing.store(false);
+	collect();
+
+	/* Producers may run late: keep the log sorted, so that frame deltas are 
+	never negative. */
+
+	std::stable_sort(captured.begin(), captured.end(), 
+		[](const Event& x, const Event& y) { return x.frame < y.frame; });
+
+	if (dropped.load() > 0)
+		gu_log("[eventLog] %d events dropped, queue full!\n", dropped.load());
+
+	bool ok = writeFile(path, captured);
+	gu_log("[eventLog] capture stopped, %d events %s %s\n", (int) captured.size(),
+		ok ? "saved to" : "NOT saved to", path.c_str());
+	return ok ? G_RES_OK : G_RES_ERR_IO;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool isCapturing()
+{
+	return capturing.load();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void collect()
+{
+	Event e;
+	while (queue.pop(e))
+		captured.push_back(e);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void advance(int n)
+{
+	frames.fetch_add(n, std::memory_order_relaxed);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int startReplay(const string& path)
+{
+	if (conf::soundSystem != G_SYS_API_NULL) {
+		gu_log("[eventLog] replay requires the null sound system\n");
+		return G_RES_ERR_WRONG_DATA;
+	}
+
+	std::lock_guard<std::mutex> lock(replayMutex);
+	if (!readFile(path, replayed))
+		return G_RES_ERR_IO;
+	replayNext  = 0;
+	replayStart = frames.load();
+	replaying.store(true);
+	gu_log("[eventLog] replaying %d events from %s\n", (int) replayed.size(), 
+		path.c_str());
+	return G_RES_OK;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void stopReplay()
+{
+	std::lock_guard<std::mutex> lock(replayMutex);
+	replaying.store(false);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool isReplaying()
+{
+	return replaying.load();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void replay(std::function<void(const Event&)> f)
+{
+	if (!replaying.load(std::memory_order_relaxed))
+		return;
+
+	/* Due events are copied out and dispatched without the mutex: 'f' may take
+	the FLTK lock, which stopReplay() callers already hold. */
+
+	vector<Event> due;
+	{
+		std::lock_guard<std::mutex> lock(replayMutex);
+		if (!replaying.load())  // stopped meanwhile
+			return;
+		int64_t now = frames.load() - replayStart;
+		for (; replayNext<replayed.size() && replayed[replayNext].frame <= now; replayNext++)
+			due.push_back(replayed[replayNext]);
+		if (replayNext == replayed.size() && replaying.load()) {
+			replaying.store(false);
+			gu_log("[eventLog] replay done, %d events\n", (int) replayed.size());
+		}
+	}
+
+	Derived d;  // a replay doesn't capture itself
+	for (const Event& e : due)
+		f(e);
+}
+}}}; // giada::m::eventLog::
@@ -0,0 +1,125 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef G_EVENT_LOG_H
+#define G_EVENT_LOG_H
+
+
+#include <string>
+#include <functional>
+#include <cstdint>
+
+
+namespace giada {
+namespace m {
+namespace eventLog
+{
+/* Type
+What can be captured. Each type keeps the arguments needed to make the same
+call again on replay:
+
+	MIDI        a = raw message (status << 16 | data1 << 8 | data2)
+	KEY_PRESS   a = channel index, b = velocity, flags = ctrl | shift << 1
+	KEY_RELEASE a = channel index, flags = ctrl | shift << 1
+	START, STOP, REWIND
+	BPM         a = integer part, b = decimal digit, as in glue_setBpm()
+	BEATS       a = beats, b = bars, flags = expand
+	JACK        a = bpm (float bits), b = frame, flags = running */
+
+enum Type
+{
+	MIDI = 0, KEY_PRESS, KEY_RELEASE, START, STOP, REWIND, BPM, BEATS, JACK
+};
+
+struct Event
+{
+	int64_t frame;  // since the capture started
+	int     type;
+	int     a;
+	int     b;
+	int     flags;
+};
+
+/* Derived
+While alive, captures made by the current thread are ignored: what follows is
+the consequence of an event already captured (e.g. the glue calls made by a 
+MIDI message) and would be played twice on replay. */
+
+class Derived
+{
+public:
+	Derived();
+	~Derived();
+};
+
+/* capture
+Logs an external input, stamped with the audio frame it will be processed on,
+i.e. the beginning of the next block. Any thread, lock-free. Does nothing if 
+not capturing. */
+
+void capture(Type type, int a=0, int b=0, int flags=0);
+
+/* startCapture, stopCapture
+stopCapture() writes the events captured so far to 'path'. Returns G_RES_OK 
+on success. */
+
+void startCapture();
+int stopCapture(const std::string& path);
+bool isCapturing();
+
+/* collect
+Moves captured events from the queue to the log. Call it periodically from a 
+non-realtime thread, so that the queue never fills up. */
+
+void collect();
+
+/* advance
+Tells that a block of 'frames' frames has been processed. Audio thread only. */
+
+void advance(int frames);
+
+/* startReplay, stopReplay
+Loads events from 'path' and plays them back from the next block. Works with 
+the null sound system only (G_SYS_API_NULL), whose timer thread calls replay()
+before each block: events come in on the same frames every time, no matter 
+how fast the machine is. */
+
+int startReplay(const std::string& path);
+void stopReplay();
+bool isReplaying();
+
+/* replay
+Passes the events due on the upcoming block to 'f', which makes the calls 
+again. Null device thread only. */
+
+void replay(std::function<void(const Event&)> f);
+}}}; // giada::m::eventLog::
+
+
+#endif
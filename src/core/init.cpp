@@ -49,6 +49,9 @@
 #include "midiMapConf.h"
 #include "kernelMidi.h"
 #include "kernelAudio.h"
+#include "bufferPool.h"
+#include "rtAudit.h"
+#include "renderer.h"
 
 
 extern bool		 		   G_quit;
@@ -58,6 +61,37 @@ extern gdMainWindow *G_MainWin;
 using namespace giada::m;
 
 
+/* init_closeEngine__
+Releases what's left of the engine once the audio stream has stopped. Returns 
+the number of realtime audit violations. */
+
+static int init_closeEngine__()
+{
+	int violations = rtAudit::report();
+
+	recorder::clearAll();
+	gu_log("[init] Recorder cleaned up\n");
+
+	bufferPool::clear();
+	gu_log("[init] Buffer pool cleaned up\n");
+
+#ifdef WITH_VST
+
+	pluginHost::freeAllStacks(&mixer::channels, &mixer::mutex_plugins);
+  pluginHost::close();
+	gu_log("[init] PluginHost cleaned up\n");
+
+#endif
+
+	gu_log("[init] Giada " G_VERSION_STR " closed\n\n");
+	gu_logClose();
+	return violations;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void init_prepareParser()
 {
 	time_t t;
@@ -77,10 +111,16 @@ void init_prepareParser()
 /* -------------------------------------------------------------------------- */
 
 
-void init_prepareKernelAudio()
+void init_prepareKernelAudio(bool offline)
 {
-  kernelAudio::openDevice();
+	rtAudit::init();
+	if (offline)
+		kernelAudio::openOffline();
+	else
+		kernelAudio::openDevice();
   clock::init(conf::samplerate, conf::midiTCfps);
+	if (!bufferPool::init(kernelAudio::getRealBufSize(), G_MAX_IO_CHANS))
+		gu_log("[init] buffer pool init failed!\n");
 	mixer::init(clock::getFramesInLoop(), kernelAudio::getRealBufSize());
 	recorder::init();
 
@@ -163,6 +203,11 @@ void init_shutdown()
 {
 	G_quit = true;
 
+	/* A stem export in background works on copies that are about to lose their
+	plug-ins and buffers: stop it first. */
+
+	renderer::waitStems(true);
+
 	/* store position and size of the main window for the next startup */
 
 	conf::mainWindowX = G_MainWin->x();
@@ -193,17 +238,16 @@ void init_shutdown()
 		gu_log("[init] Mixer closed\n");
 	}
 
-	recorder::clearAll();
-	gu_log("[init] Recorder cleaned up\n");
+	init_closeEngine__();
+}
 
-#ifdef WITH_VST
 
-	pluginHost::freeAllStacks(&mixer::channels, &mixer::mutex_plugins);
-  pluginHost::close();
-	gu_log("[init] PluginHost cleaned up\n");
+/* -------------------------------------------------------------------------- */
 
-#endif
 
-	gu_log("[init] Giada " G_VERSION_STR " closed\n\n");
-	gu_logClose();
+int init_shutdownOffline()
+{
+	mixer::close();
+	gu_log("[init] Mixer closed\n");
+	return init_closeEngine__();
 }
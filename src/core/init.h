@@ -31,11 +31,24 @@
 
 void init_prepareParser();
 void init_startGUI(int argc, char** argv);
-void init_prepareKernelAudio();
+
+/* init_prepareKernelAudio
+Opens the audio device and sets up the engine. If 'offline', no device is 
+opened: the engine is driven by the offline renderer. */
+
+void init_prepareKernelAudio(bool offline=false);
 void init_prepareKernelMIDI();
 void init_prepareMidiMap();
 void init_startKernelAudio();
 void init_shutdown();
 
+/* init_shutdownOffline
+Tears down the engine set up by init_prepareKernelAudio(true). Unlike 
+init_shutdown(), there is no GUI to close and the configuration is left 
+untouched. Returns the number of violations found by the realtime audit mode, 
+always 0 without it. */
+
+int init_shutdownOffline();
+
 
 #endif
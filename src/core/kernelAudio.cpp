@@ -27,12 +27,20 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <sndfile.h>
 #include "../deps/rtaudio-mod/RtAudio.h"
 #include "../utils/log.h"
 #include "../glue/main.h"
+#include "../glue/io.h"
 #include "conf.h"
 #include "mixer.h"
 #include "const.h"
+#include "eventLog.h"
+#include "realtime.h"
 #include "kernelAudio.h"
 
 
@@ -53,6 +61,16 @@ bool     inputEnabled = false;
 unsigned realBufsize  = 0; 		// reale bufsize from the soundcard
 int      api          = 0;
 
+/* Null device: a thread calls mixer::masterPlay() at the pace of a real sound
+card, or conf::nullSpeed times faster. Input, if any, comes from a file that
+loops forever. */
+
+std::thread       nullThread;
+std::atomic<bool> nullRunning(false);
+
+std::atomic<bool> running(false);  // see isRunning()
+vector<float>     nullInput;  // interleaved, G_MAX_IO_CHANS channels
+
 #ifdef __linux__
 
 JackState jackState;
@@ -63,6 +81,118 @@ jack_client_t* jackGetHandle()
 }
 
 #endif
+
+
+/* -------------------------------------------------------------------------- */
+
+/* readNullInput
+Reads the whole input file into memory, as G_MAX_IO_CHANS interleaved 
+channels: a mono file goes to both sides, extra channels are dropped. No 
+resampling. */
+
+bool readNullInput(const string& path)
+{
+	SF_INFO header;
+	header.format = 0;
+	SNDFILE* file = sf_open(path.c_str(), SFM_READ, &header);
+	if (file == nullptr) {
+		gu_log("[KA] unable to read null device input %s: %s\n", path.c_str(), 
+			sf_strerror(file));
+		return false;
+	}
+	if (header.samplerate != conf::samplerate)
+		gu_log("[KA] null device input at %d Hz, not resampled!\n", header.samplerate);
+
+	vector<float> data(header.frames * header.channels);
+	sf_count_t frames = sf_readf_float(file, data.data(), header.frames);
+	sf_close(file);
+
+	nullInput.resize(frames * G_MAX_IO_CHANS);
+	for (sf_count_t i=0; i<frames; i++)
+		for (int j=0; j<G_MAX_IO_CHANS; j++)
+			nullInput[i * G_MAX_IO_CHANS + j] = 
+				data[i * header.channels + std::min(j, header.channels - 1)];
+	return frames > 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* openNull
+Null counterpart of openDevice(). */
+
+int openNull()
+{
+	realBufsize  = conf::buffersize;
+	inputEnabled = conf::nullInputPath != "" && readNullInput(conf::nullInputPath);
+	status       = true;
+	gu_log("[KA] null device, bufsize=%d, f=%d, speed=%.2fx, input=%s\n", 
+		realBufsize, conf::samplerate, conf::nullSpeed, 
+		inputEnabled ? conf::nullInputPath.c_str() : "none");
+	return 1;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* runNull
+Body of the null device thread. Deadlines are absolute, so timing errors don't
+pile up; the stream time follows the frame count, not the wall clock. A late 
+block is reported to the mixer as an underflow, as a real device would do, 
+and the schedule starts again from there. */
+
+void runNull()
+{
+	using clk = std::chrono::steady_clock;
+
+	vector<float> out(realBufsize * G_MAX_IO_CHANS);
+	vector<float> in (realBufsize * G_MAX_IO_CHANS, 0.0f);
+
+	clk::duration period = std::chrono::duration_cast<clk::duration>(
+		std::chrono::duration<double>(realBufsize / (conf::samplerate * conf::nullSpeed)));
+
+	clk::time_point     next   = clk::now();
+	uint64_t            frames = 0;
+	size_t              inPos  = 0;
+	RtAudioStreamStatus stat   = 0;
+
+	while (nullRunning.load()) {
+		realtime::enterAudioThread();
+		eventLog::replay(c::io::replay);
+		if (inputEnabled)
+			for (float& s : in) {
+				s = nullInput[inPos];
+				inPos = inPos + 1 == nullInput.size() ? 0 : inPos + 1;
+			}
+
+		mixer::masterPlay(out.data(), in.data(), realBufsize, 
+			frames / (double) conf::samplerate, stat, nullptr);
+		frames += realBufsize;
+		next   += period;
+
+		stat = 0;
+		if (clk::now() > next) {
+			stat = RTAUDIO_OUTPUT_UNDERFLOW;
+			next = clk::now();
+		}
+		std::this_thread::sleep_until(next);
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* callback
+Audio callback for RtAudio and JACK: configures the stream thread, then runs the
+mixer. */
+
+int callback(void* outBuf, void* inBuf, unsigned bufferSize, double streamTime,
+	RtAudioStreamStatus status, void* userData)
+{
+	realtime::enterAudioThread();
+	return mixer::masterPlay(outBuf, inBuf, bufferSize, streamTime, status, 
+		userData);
+}
 };  // {anonymous}
 
 
@@ -80,11 +210,23 @@ bool getStatus()
 /* -------------------------------------------------------------------------- */
 
 
+bool isRunning()
+{
+	return running.load();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 int openDevice()
 {
 	api = conf::soundSystem;
 	gu_log("[KA] using system 0x%x\n", api);
 
+	if (api == G_SYS_API_NULL)
+		return openNull();
+
 #if defined(__linux__)
 
 	if (api == G_SYS_API_JACK && hasAPI(RtAudio::UNIX_JACK))
@@ -175,7 +317,7 @@ int openDevice()
 			RTAUDIO_FLOAT32,			              // audio format
 			conf::samplerate, 					        // sample rate
 			&realBufsize, 				              // buffer size in byte
-			&mixer::masterPlay,                 // audio callback
+			&callback,                          // audio callback
 			nullptr,									          // user data (unused)
 			&options);
     status = true;
@@ -192,11 +334,40 @@ int openDevice()
 /* -------------------------------------------------------------------------- */
 
 
+void openOffline()
+{
+	api          = G_SYS_API_NONE;
+	status       = false;
+	inputEnabled = false;
+	realBufsize  = conf::buffersize;
+	gu_log("[KA] offline mode, bufsize=%d, f=%d\n", realBufsize, conf::samplerate);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 int startStream()
 {
+	/* Memory is locked while the stream is stopped; the audio thread configures
+	itself on its first callback. */
+
+	realtime::prepare();
+	if (conf::rtLockMemory)
+		mixer::prefault();
+
+	if (api == G_SYS_API_NULL) {
+		nullRunning.store(true);
+		nullThread = std::thread(runNull);
+		running.store(true);
+		realtime::report();
+		return 1;
+	}
 	try {
 		rtSystem->startStream();
+		running.store(true);
 		gu_log("[KA] latency = %lu\n", rtSystem->getStreamLatency());
+		realtime::report();
 		return 1;
 	}
 	catch (RtAudioError &e) {
@@ -211,8 +382,16 @@ int startStream()
 
 int stopStream()
 {
+	if (api == G_SYS_API_NULL) {
+		nullRunning.store(false);
+		if (nullThread.joinable())
+			nullThread.join();
+		running.store(false);
+		return 1;
+	}
 	try {
 		rtSystem->stopStream();
+		running.store(false);
 		return 1;
 	}
 	catch (RtAudioError &e) {
@@ -227,6 +406,8 @@ int stopStream()
 
 string getDeviceName(unsigned dev)
 {
+	if (rtSystem == nullptr)
+		return "";
 	try {
 		return static_cast<RtAudio::DeviceInfo>(rtSystem->getDeviceInfo(dev)).name;
 	}
@@ -242,13 +423,16 @@ string getDeviceName(unsigned dev)
 
 int closeDevice()
 {
-	if (rtSystem->isStreamOpen()) {
+	if (api == G_SYS_API_NULL)
+		stopStream();
+	if (rtSystem != nullptr && rtSystem->isStreamOpen()) {
 #if defined(__linux__) || defined(__APPLE__)
 		rtSystem->abortStream(); // stopStream seems to lock the thread
 #elif defined(_WIN32)
 		rtSystem->stopStream();	 // on Windows it's the opposite
 #endif
 		rtSystem->closeStream();
+		running.store(false);
 		delete rtSystem;
 		rtSystem = nullptr;
 	}
@@ -461,6 +645,16 @@ const JackState &jackTransportQuery()
 /* -------------------------------------------------------------------------- */
 
 
+void jackReplay(const JackState& state)
+{
+	if (api != G_SYS_API_JACK)
+		jackState = state;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void jackStart()
 {
 	if (api == G_SYS_API_JACK)
@@ -57,11 +57,30 @@ struct JackState
 #endif
 
 int openDevice();
+
+/* openOffline
+Sets up the engine parameters without a device, for rendering offline: the 
+caller drives mixer::masterPlay() itself, with buffers of conf::buffersize 
+frames and no input. */
+
+void openOffline();
+
 int closeDevice();
+
+/* startStream, stopStream
+Start and stop the audio callback. With the null device (G_SYS_API_NULL), they
+run and join the thread that emulates the sound card. */
+
 int startStream();
 int stopStream();
 
 bool getStatus();
+
+/* isRunning
+True between a successful startStream() and stopStream(), i.e. while the audio
+callback is being called. Any thread. */
+
+bool isRunning();
 bool isProbed(unsigned dev);
 bool isDefaultIn(unsigned dev);
 bool isDefaultOut(unsigned dev);
@@ -87,6 +106,12 @@ void jackSetPosition(uint32_t frame);
 void jackSetBpm(double bpm);
 const JackState &jackTransportQuery();
 
+/* jackReplay
+Makes jackTransportQuery() return 'state' when JACK is not in use. Replays a
+JACK transport change captured by m::eventLog. */
+
+void jackReplay(const JackState& state);
+
 #endif
 }}}; // giada::m::kernelAudio::
 
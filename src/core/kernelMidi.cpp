@@ -32,6 +32,7 @@
 	#include <rtmidi/RtMidi.h>
 #endif
 #include "../utils/log.h"
+#include "../utils/time.h"
 #include "midiDispatcher.h"
 #include "midiMapConf.h"
 #include "kernelMidi.h"
@@ -55,8 +56,14 @@ unsigned numOutPorts = 0;
 unsigned numInPorts  = 0;
 
 
+/* callback
+RtMidi's 't' is only the delta time from the previous message: the message is
+stamped here on arrival with the same monotonic clock the audio callback uses. */
+
 static void callback(double t, std::vector<unsigned char>* msg, void* data)
 {
+	int64_t time = u::time::now();
+
 	if (msg->size() < 3) {
 		//gu_log("[KM] MIDI received - unknown signal - size=%d, value=0x", (int) msg->size());
 		//for (unsigned i=0; i<msg->size(); i++)
@@ -64,7 +71,7 @@ static void callback(double t, std::vector<unsigned char>* msg, void* data)
 		//gu_log("\n");
 		return;
 	}
-	midiDispatcher::dispatch(msg->at(0), msg->at(1), msg->at(2));
+	midiDispatcher::dispatch(msg->at(0), msg->at(1), msg->at(2), time);
 }
 
 
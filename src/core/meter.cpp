@@ -0,0 +1,101 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+#include "const.h"
+#include "audioBuffer.h"
+#include "meter.h"
+
+
+namespace giada {
+namespace m {
+namespace meter
+{
+namespace
+{
+const int LANES = 8;  // a multiple of any audio channel count we deal with
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+Level measure(const AudioBuffer& buf, const float* gain)
+{
+	int frames   = buf.countFrames();
+	int channels = buf.countChannels();
+
+	if (frames == 0 || channels == 0)
+		return { 0.0f, 0.0f };
+
+	assert(channels <= G_MAX_IO_CHANS && LANES % channels == 0);
+
+	/* One pass over the interleaved samples, with a max and a sum of squares 
+	per lane. Lanes are independent and there are no branches nor gains in the 
+	loop, so that the compiler can vectorize it. Lane 'k' belongs to audio 
+	channel 'k % channels'. */
+
+	float peak[LANES] = {};
+	float sum[LANES]  = {};
+	const float* data = buf[0];
+	int samples = frames * channels;
+	int i = 0;
+
+	for (; i + LANES <= samples; i+=LANES)
+		for (int k=0; k<LANES; k++) {
+			float s = data[i + k];
+			peak[k] = std::max(peak[k], std::fabs(s));
+			sum[k] += s * s;
+		}
+	for (int k=0; i<samples; i++, k++) {
+		peak[k] = std::max(peak[k], std::fabs(data[i]));
+		sum[k] += data[i] * data[i];
+	}
+
+	/* Fold lanes into audio channels. */
+
+	for (int k=channels; k<LANES; k++) {
+		peak[k % channels] = std::max(peak[k % channels], peak[k]);
+		sum[k % channels] += sum[k];
+	}
+
+	Level level = { 0.0f, 0.0f };
+	float total = 0.0f;
+	for (int j=0; j<channels; j++) {
+		float g = gain != nullptr ? std::fabs(gain[j]) : 1.0f;
+		level.peak = std::max(level.peak, peak[j] * g);
+		total     += sum[j] * g * g;
+	}
+	level.rms = std::sqrt(total / samples);
+	return level;
+}
+}}}; // giada::m::meter::
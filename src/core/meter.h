@@ -0,0 +1,59 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_METER_H
+#define G_METER_H
+
+
+namespace giada {
+namespace m 
+{
+class AudioBuffer;
+
+namespace meter
+{
+/* Level
+Peak (absolute value) and RMS of a block of audio, audio channels merged. 
+Linear scale. */
+
+struct Level
+{
+	float peak;
+	float rms;
+};
+
+/* measure
+Computes the level of the whole 'buf'. If 'gain' is not nullptr, audio channel
+'i' is scaled by 'gain[i]' first, e.g. to meter a channel post-fader without
+touching its buffer. Real-time safe. */
+
+Level measure(const AudioBuffer& buf, const float* gain=nullptr);
+}}}; // giada::m::meter::
+
+
+#endif
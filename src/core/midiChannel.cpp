@@ -36,6 +36,7 @@
 #include "mixer.h"
 #include "pluginHost.h"
 #include "kernelMidi.h"
+#include "commandQueue.h"
 
 
 using std::string;
@@ -59,9 +60,10 @@ MidiChannel::~MidiChannel() {}
 /* -------------------------------------------------------------------------- */
 
 
-void MidiChannel::copy(const Channel* src_, pthread_mutex_t* pluginMutex)
+void MidiChannel::copy(const Channel* src_, pthread_mutex_t* pluginMutex,
+	bool withActions)
 {
-	Channel::copy(src_, pluginMutex);
+	Channel::copy(src_, pluginMutex, withActions);
 	const MidiChannel* src = static_cast<const MidiChannel*>(src_);
 	midiOut     = src->midiOut;
 	midiOutChan = src->midiOutChan;
@@ -71,23 +73,6 @@ void MidiChannel::copy(const Channel* src_, pthread_mutex_t* pluginMutex)
 /* -------------------------------------------------------------------------- */
 
 
-#ifdef WITH_VST
-
-void MidiChannel::addVstMidiEvent(uint32_t msg, int localFrame)
-{
-	juce::MidiMessage message = juce::MidiMessage(
-		kernelMidi::getB1(msg),
-		kernelMidi::getB2(msg),
-		kernelMidi::getB3(msg));
-	midiBuffer.addEvent(message, localFrame);
-}
-
-#endif
-
-
-/* -------------------------------------------------------------------------- */
-
-
 void MidiChannel::onBar(int frame) {}
 
 
@@ -146,7 +131,7 @@ void MidiChannel::setMute(bool internal)
 	if (midiOut)
 		kernelMidi::send(MIDI_ALL_NOTES_OFF);
 #ifdef WITH_VST
-		addVstMidiEvent(MIDI_ALL_NOTES_OFF, 0);
+		sendVstMidiEvent(MIDI_ALL_NOTES_OFF);
 #endif
 	sendMidiLmute();
 }
@@ -165,11 +150,38 @@ void MidiChannel::unsetMute(bool internal)
 /* -------------------------------------------------------------------------- */
 
 
+bool MidiChannel::isProducing() const
+{
+	/* Without plug-in instruments a MIDI channel only talks to the outside world:
+	no audio to render. */
+
+#ifdef WITH_VST
+	if (plugins.empty())
+		return false;
+	return isPlaying() || armed || Channel::isProducing();
+#else
+	return false;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void MidiChannel::process(giada::m::AudioBuffer& out, const giada::m::AudioBuffer& in)
 {
+	if (isFrozen()) {
+		producing = false;  // re-armed by sumFrozen() in the next block
 #ifdef WITH_VST
-	pluginHost::processStack(vChan, pluginHost::CHANNEL, this);
+		pluginHost::applyParams(pluginHost::CHANNEL, this);
 #endif
+	}
+	else {
+		updateTail();
+#ifdef WITH_VST
+		pluginHost::processStack(vChan, pluginHost::CHANNEL, this);
+#endif
+	}
 
 	/* TODO - isn't this useful only if WITH_VST ? */
 	for (int i=0; i<out.countFrames(); i++)
@@ -229,7 +241,7 @@ void MidiChannel::kill(int frame)
 		if (midiOut)
 			kernelMidi::send(MIDI_ALL_NOTES_OFF);
 #ifdef WITH_VST
-		addVstMidiEvent(MIDI_ALL_NOTES_OFF, 0);
+		sendVstMidiEvent(MIDI_ALL_NOTES_OFF, frame);
 #endif
 	}
 	status = STATUS_OFF;
@@ -269,7 +281,7 @@ void MidiChannel::sendMidi(uint32_t data)
 		if (midiOut)
 			kernelMidi::send(data | MIDI_CHANS[midiOutChan]);
 #ifdef WITH_VST
-		addVstMidiEvent(data, 0);
+		postMidiEvent(data);
 #endif
 	}
 }
@@ -283,7 +295,7 @@ void MidiChannel::rewind()
 	if (midiOut)
 		kernelMidi::send(MIDI_ALL_NOTES_OFF);
 #ifdef WITH_VST
-		addVstMidiEvent(MIDI_ALL_NOTES_OFF, 0);
+		sendVstMidiEvent(MIDI_ALL_NOTES_OFF);
 #endif
 }
 
@@ -315,14 +327,14 @@ void MidiChannel::receiveMidi(const MidiEvent& midiEvent)
 
 #ifdef WITH_VST
 
-	while (true) {
-		if (pthread_mutex_trylock(&pluginHost::mutex_midi) != 0)
-			continue;
-		gu_log("[Channel::processMidi] msg=%X\n", midiEventFlat.getRaw());
-		addVstMidiEvent(midiEventFlat.getRaw(), 0);
-		pthread_mutex_unlock(&pluginHost::mutex_midi);
-		break;
-	}
+	gu_log("[Channel::processMidi] msg=%X\n", midiEventFlat.getRaw());
+
+	/* Events are placed by commandQueue on the frame they were received at. Fall
+	back to the beginning of the next block if its queue is full. */
+
+	if (!commandQueue::post(commandQueue::MIDI, this, midiEvent.getTimestamp(), 
+	    midiEventFlat.getRaw()))
+		postMidiEvent(midiEventFlat.getRaw());
 
 #endif
 
@@ -41,12 +41,17 @@ class Patch;
 
 class MidiChannel : public Channel
 {
+private:
+
+	bool isProducing() const override;
+
 public:
 
 	MidiChannel(int bufferSize);
 	~MidiChannel();
 
-	void copy(const Channel* src, pthread_mutex_t* pluginMutex) override;
+	void copy(const Channel* src, pthread_mutex_t* pluginMutex, 
+		bool withActions=true) override;
 	void clear() override;
 	void process(giada::m::AudioBuffer& out, const giada::m::AudioBuffer& in) override;
 	void preview(giada::m::AudioBuffer& out) override;
@@ -75,17 +80,6 @@ public:
 	void sendMidi(giada::m::recorder::action* a, int localFrame);
 	void sendMidi(uint32_t data);
 
-#ifdef WITH_VST
-
-	/* addVstMidiEvent
-	 * Add a new Midi event to the midiEvent stack fom a composite uint32_t raw
-	 * Midi event. LocalFrame is the offset: it tells where to put the event
-	 * inside the buffer. */
-
-	void addVstMidiEvent(uint32_t msg, int localFrame);
-
-#endif
-
 	bool    midiOut;           // enable midi output
 	uint8_t midiOutChan;       // midi output channel
 };
@@ -39,6 +39,8 @@
 #include "mixer.h"
 #include "pluginHost.h"
 #include "plugin.h"
+#include "commandQueue.h"
+#include "eventLog.h"
 #include "midiDispatcher.h"
 
 
@@ -114,19 +116,20 @@ void processChannels(const MidiEvent& midiEvent)
 
 		if      (pure == ch->midiInKeyPress) {
 			gu_log("  >>> keyPress, ch=%d (pure=0x%X)\n", ch->index, pure);
-			c::io::keyPress(ch, false, false, midiEvent.getVelocity());
+			c::io::keyPress(ch, false, false, midiEvent.getVelocity(), 
+				midiEvent.getTimestamp());
 		}
 		else if (pure == ch->midiInKeyRel) {
 			gu_log("  >>> keyRel ch=%d (pure=0x%X)\n", ch->index, pure);
-			c::io::keyRelease(ch, false, false);
+			c::io::keyRelease(ch, false, false, midiEvent.getTimestamp());
 		}
 		else if (pure == ch->midiInMute) {
 			gu_log("  >>> mute ch=%d (pure=0x%X)\n", ch->index, pure);
-			c::channel::toggleMute(ch, false);
+			c::channel::toggleMute(ch, false, midiEvent.getTimestamp());
 		}		
 		else if (pure == ch->midiInKill) {
 			gu_log("  >>> kill ch=%d (pure=0x%X)\n", ch->index, pure);
-			c::channel::kill(ch);
+			c::channel::kill(ch, midiEvent.getTimestamp());
 		}		
 		else if (pure == ch->midiInArm) {
 			gu_log("  >>> arm ch=%d (pure=0x%X)\n", ch->index, pure);
@@ -140,7 +143,7 @@ void processChannels(const MidiEvent& midiEvent)
 			float vf = midiEvent.getVelocity() / 127.0f;
 			gu_log("  >>> volume ch=%d (pure=0x%X, value=%d, float=%f)\n",
 				ch->index, pure, midiEvent.getVelocity(), vf);
-			c::channel::setVolume(ch, vf, false);
+			c::channel::setVolume(ch, vf, false, false, midiEvent.getTimestamp());
 		}
 		else {
 			SampleChannel* sch = static_cast<SampleChannel*>(ch);
@@ -163,7 +166,7 @@ void processChannels(const MidiEvent& midiEvent)
 
 		/* Redirect full midi message (pure + velocity) to plugins. */
 
-		ch->receiveMidi(midiEvent.getRaw());
+		ch->receiveMidi(midiEvent);
 	}
 }
 
@@ -248,13 +251,29 @@ void stopMidiLearn()
 /* -------------------------------------------------------------------------- */
 
 
-void dispatch(int byte1, int byte2, int byte3)
+void dispatch(int byte1, int byte2, int byte3, int64_t time)
 {
 	/* Here we want to catch two things: a) note on/note off from a keyboard and 
 	b) knob/wheel/slider movements from a controller. */
 
 	MidiEvent midiEvent(byte1, byte2, byte3);
 
+	/* Only the raw message is logged: whatever it triggers comes from it. */
+
+	eventLog::capture(eventLog::MIDI, byte1 << 16 | byte2 << 8 | byte3);
+	eventLog::Derived derived;
+
+	/* A timestamp makes channel events land on the right frame of the next 
+	block. Without it they are applied at the beginning of the block, as soon as
+	they are read. Probes measure the resulting latency in both modes. */
+
+	if (conf::midiInTiming == MIDI_IN_TIMING_ACCURATE)
+		midiEvent.setTimestamp(time);
+	if (conf::midiInJitterLog && time != 0) {
+		commandQueue::post(commandQueue::PROBE, nullptr, time);
+		commandQueue::logStats();
+	}
+
 	gu_log("[midiDispatcher] MIDI received - 0x%X (chan %d)\n", midiEvent.getRaw(), 
 		midiEvent.getChannel());
 
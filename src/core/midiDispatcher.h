@@ -45,7 +45,12 @@ typedef void (cb_midiLearn) (uint32_t, void*);
 void startMidiLearn(cb_midiLearn* cb, void* data);
 void stopMidiLearn();
 
-void dispatch(int byte1, int byte2, int byte3);
+/* dispatch
+Processes an incoming MIDI message. 'time' is its arrival time, as returned by
+u::time::now(): channel events are scheduled on the matching frame of the next 
+block when sample-accurate input timing is enabled. */
+
+void dispatch(int byte1, int byte2, int byte3, int64_t time=0);
 
 }}}; // giada::m::midiDispatcher::
 
@@ -32,12 +32,13 @@ namespace giada {
 namespace m
 {
 MidiEvent::MidiEvent()
-	: m_raw     (0x0),
-	  m_status  (0),
-	  m_channel (0),
-	  m_note    (0),
-	  m_velocity(0),
-	  m_delta   (0)
+	: m_raw      (0x0),
+	  m_status   (0),
+	  m_channel  (0),
+	  m_note     (0),
+	  m_velocity (0),
+	  m_delta    (0),
+	  m_timestamp(0)
 {
 }
 
@@ -46,12 +47,13 @@ MidiEvent::MidiEvent()
 
 
 MidiEvent::MidiEvent(uint32_t raw)
-	: m_raw     (raw),
-	  m_status  ((raw & 0xF0000000) >> 24),
-	  m_channel ((raw & 0x0F000000) >> 24),
-	  m_note    ((raw & 0x00FF0000) >> 16),
-	  m_velocity((raw & 0x0000FF00) >> 8),
-	  m_delta   (0)  // not used
+	: m_raw      (raw),
+	  m_status   ((raw & 0xF0000000) >> 24),
+	  m_channel  ((raw & 0x0F000000) >> 24),
+	  m_note     ((raw & 0x00FF0000) >> 16),
+	  m_velocity ((raw & 0x0000FF00) >> 8),
+	  m_delta    (0),  // not used
+	  m_timestamp(0)
 {
 }
 
@@ -82,6 +84,12 @@ void MidiEvent::setChannel(int c)
 }
 
 
+void MidiEvent::setTimestamp(int64_t t)
+{
+	m_timestamp = t;
+}
+
+
 /* -------------------------------------------------------------------------- */
 
 
@@ -115,6 +123,12 @@ bool MidiEvent::isNoteOnOff() const
 }
 
 
+int64_t MidiEvent::getTimestamp() const
+{
+	return m_timestamp;
+}
+
+
 int MidiEvent::getDelta() const
 {
 	return m_delta;
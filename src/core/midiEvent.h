@@ -53,6 +53,12 @@ public:
 	bool isNoteOnOff() const;	
 	int getDelta() const;
 
+	/* getTimestamp
+	Returns the arrival time (see u::time::now()) of a timestamped event, or 0 if
+	the event has to be processed right away. */
+
+	int64_t getTimestamp() const;
+
 	/* getRaw
 	Returns the raw message. If 'velocity' is false, velocity byte is stripped
 	out. */
@@ -61,6 +67,7 @@ public:
 
 	void resetDelta();
 	void setChannel(int c);
+	void setTimestamp(int64_t t);
 
 private:
 
@@ -70,6 +77,7 @@ private:
 	int m_note;
 	int m_velocity;
 	int m_delta;
+	int64_t m_timestamp;
 };
 
 }} // giada::m::
@@ -29,6 +29,7 @@
 #include <cstring>
 #include "../deps/rtaudio-mod/RtAudio.h"
 #include "../utils/log.h"
+#include "../utils/time.h"
 #include "wave.h"
 #include "kernelAudio.h"
 #include "recorder.h"
@@ -41,6 +42,16 @@
 #include "sampleChannel.h"
 #include "midiChannel.h"
 #include "audioBuffer.h"
+#include "bufferPool.h"
+#include "columnBus.h"
+#include "commandQueue.h"
+#include "uiState.h"
+#include "meter.h"
+#include "profiler.h"
+#include "rtAudit.h"
+#include "trace.h"
+#include "eventLog.h"
+#include "realtime.h"
 #include "mixer.h"
 
 
@@ -86,25 +97,25 @@ Sample position while recording. */
 
 int inputTracker = 0;
 
+#ifdef WITH_VST
 
-/* -------------------------------------------------------------------------- */
+/* sendBuses, sendBusFed
+Send bus buffers, processed by their own plug-in stack and mixed into the 
+output. sendBusFed tells whether some channel has sent signal to the bus in the 
+current block. */
 
+AudioBuffer sendBuses[G_MAX_SEND_BUSES];
+bool        sendBusFed[G_MAX_SEND_BUSES];
 
-bool isChannelAudible(Channel* ch)
-{
-	return !hasSolos || (hasSolos && ch->solo);
-}
+#endif
 
 
 /* -------------------------------------------------------------------------- */
 
-/* computePeak */
 
-void computePeak(const AudioBuffer& buf, float& peak, unsigned frame)
+bool isChannelAudible(Channel* ch)
 {
-	for (int i=0; i<buf.countChannels(); i++)
-		if (buf[frame][i] > peak)
-			peak = buf[frame][i];
+	return !hasSolos || (hasSolos && ch->solo);
 }
 
 
@@ -139,15 +150,13 @@ void lineInRec(const AudioBuffer& inBuf, unsigned frame)
 /* -------------------------------------------------------------------------- */
 
 /* ProcessLineIn
-Computes line in peaks, plus handles "hear what you're playin'" thing. */
+Handles "hear what you're playin'" thing. */
 
 void processLineIn(const AudioBuffer& inBuf, unsigned frame)
 {
 	if (!kernelAudio::isInputEnabled())
 		return;
 
-	computePeak(inBuf, peakIn, frame);
-
 	/* "hear what you're playing" - process, copy and paste the input buffer onto 
 	the output buffer. */
 
@@ -167,9 +176,18 @@ void clearAllBuffers(AudioBuffer& outBuf)
 	outBuf.clear();
 	vChanInToOut.clear();
 
+#ifdef WITH_VST
+	for (int i=0; i<G_MAX_SEND_BUSES; i++) {
+		sendBuses[i].clear();
+		sendBusFed[i] = false;
+	}
+#endif
+
 	pthread_mutex_lock(&mutex_chans);
 	for (Channel* channel : channels)
-		channel->clear();
+		channel->prepareBuffers();
+	for (ColumnBus* bus : columnBuses)
+		bus->prepareBuffers();
 	pthread_mutex_unlock(&mutex_chans);
 }
 
@@ -224,13 +242,16 @@ void doQuantize(unsigned frame)
 
 /* sumChannels
 Sums channels, i.e. lets them add sample frames to their virtual channels.
-This is required for G_CHANNEL_SAMPLE only */
+This is required for playing G_CHANNEL_SAMPLE and frozen channels only */
 
 void sumChannels(unsigned frame)
 {
 	pthread_mutex_lock(&mutex_chans);
 	for (Channel* ch : channels)
-		if (ch->type == G_CHANNEL_SAMPLE)
+		if (ch->isFrozen())
+			ch->sumFrozen(frame, clock::getCurrentFrame(), clock::isRunning());
+		else
+		if (ch->type == G_CHANNEL_SAMPLE && ch->isPlaying())
 			static_cast<SampleChannel*>(ch)->sum(frame, clock::isRunning());
 	pthread_mutex_unlock(&mutex_chans);
 }
@@ -264,24 +285,105 @@ void renderMetronome(AudioBuffer& outBuf, unsigned frame)
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+#ifdef WITH_VST
+
+/* sendChannel
+Feeds the send buses the channel has a non-zero send level for. */
+
+void sendChannel(Channel* ch)
+{
+	for (int i=0; i<G_MAX_SEND_BUSES; i++) {
+		if (ch->sendLevels[i] <= 0.0f)
+			continue;
+		ch->sumSend(sendBuses[i], i);
+		sendBusFed[i] = true;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* renderSendBuses
+Runs each send bus through its plug-in stack, once per block, and mixes the
+result into the output buffer. Buses with no input and no plug-ins (i.e. no 
+tails) are skipped. */
+
+void renderSendBuses(AudioBuffer& outBuf)
+{
+	for (int i=0; i<G_MAX_SEND_BUSES; i++) {
+		int stackType = pluginHost::SEND_BUS + i;
+		if (!sendBusFed[i] && pluginHost::countPlugins(stackType) == 0)
+			continue;
+		pluginHost::processStack(sendBuses[i], stackType);
+		for (int j=0; j<outBuf.countFrames(); j++)
+			for (int k=0; k<outBuf.countChannels(); k++)
+				outBuf[j][k] += sendBuses[i][j][k];
+	}
+}
+
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+
+/* renderColumnBuses
+Renders each active column bus into the output buffer. Buses don't depend on 
+each other, so this is where they could be spread across threads. Called by
+renderIO() with mutex_chans held, which also guards the bus plug-in stacks (see
+getPluginMutex()). */
+
+void renderColumnBuses(AudioBuffer& outBuf)
+{
+	for (ColumnBus* bus : columnBuses)
+		if (bus->isActive())
+			bus->process(outBuf);
+}
+
+
 /* -------------------------------------------------------------------------- */
 
 /* renderIO
-Final processing stage. Take each channel and process it (i.e. copy its
-content to the output buffer). Process plugins too, if any. */
+Final processing stage. Take each active channel and process it (i.e. copy its
+content to the output buffer, or to its column bus). Process plugins too, if 
+any. Idle channels are skipped, apart from applying pending plug-in parameter
+changes. Channel levels are measured here, post-fader. */
 
 void renderIO(AudioBuffer& outBuf, const AudioBuffer& inBuf)
 {
 	pthread_mutex_lock(&mutex_chans);
 	for (Channel* ch : channels) {
-		if (isChannelAudible(ch))
-			ch->process(outBuf, inBuf);
-		ch->preview(outBuf);
+		if (ch->isActive() && isChannelAudible(ch)) {
+			int64_t t = profiler::begin();
+			if (ch->columnBus != nullptr) {
+				ch->process(ch->columnBus->vChan, inBuf);
+				ch->columnBus->fed = true;
+			}
+			else
+				ch->process(outBuf, inBuf);
+			profiler::end(profiler::CHANNEL, t, ch->index);
+			ch->updateLevel();
+#ifdef WITH_VST
+			sendChannel(ch);
+#endif
+		}
+		else {
+			ch->level = { 0.0f, 0.0f };
+#ifdef WITH_VST
+			pluginHost::applyParams(pluginHost::CHANNEL, ch);
+#endif
+		}
+		if (ch->isPreview())
+			ch->preview(outBuf);
+		uiState::addChannel(ch);
 	}
+	renderColumnBuses(outBuf);
 	pthread_mutex_unlock(&mutex_chans);
 
 #ifdef WITH_VST
 	pthread_mutex_lock(&mutex_plugins);
+	renderSendBuses(outBuf);
 	pluginHost::processStack(outBuf, pluginHost::MASTER_OUT);
 	pluginHost::processStack(vChanInToOut, pluginHost::MASTER_IN);
 	pthread_mutex_unlock(&mutex_plugins);
@@ -375,14 +477,15 @@ void testLastBeat()
 /* -------------------------------------------------------------------------- */
 
 
-std::vector<Channel*> channels;
+std::vector<Channel*>   channels;
+std::vector<ColumnBus*> columnBuses;
 
 bool   recording    = false;
 bool   ready        = true;
 float  outVol       = G_DEFAULT_OUT_VOL;
 float  inVol        = G_DEFAULT_IN_VOL;
-float  peakOut      = 0.0f;
-float  peakIn       = 0.0f;
+meter::Level levelOut = { 0.0f, 0.0f };
+meter::Level levelIn  = { 0.0f, 0.0f };
 bool	 metronome    = false;
 int    waitRec      = 0;
 bool   rewindWait   = false;
@@ -405,10 +508,17 @@ void init(int framesInSeq, int framesInBuffer)
 		gu_log("[Mixer::init] vChanInput alloc error!\n");	
 		return;
 	}
-	if (!vChanInToOut.alloc(framesInBuffer, G_MAX_IO_CHANS)) {
+	if (!bufferPool::acquire(vChanInToOut)) {
 		gu_log("[Mixer::init] vChanInToOut alloc error!\n");	
 		return;
 	}
+#ifdef WITH_VST
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		if (!bufferPool::acquire(sendBuses[i])) {
+			gu_log("[Mixer::init] send bus %d alloc error!\n", i);	
+			return;
+		}
+#endif
 
 	gu_log("[Mixer::init] buffers ready - framesInSeq=%d, framesInBuffer=%d\n", 
 		framesInSeq, framesInBuffer);	
@@ -419,6 +529,13 @@ void init(int framesInSeq, int framesInBuffer)
 	pthread_mutex_init(&mutex_chans, nullptr);
 	pthread_mutex_init(&mutex_plugins, nullptr);
 
+	/* The audio thread still shares these with the main thread: a known issue,
+	kept apart from new ones by the realtime audit. */
+
+	rtAudit::allow(&mutex_recs);
+	rtAudit::allow(&mutex_chans);
+	rtAudit::allow(&mutex_plugins);
+
 	rewind();
 }
 
@@ -441,6 +558,12 @@ int masterPlay(void* outBuf, void* inBuf, unsigned bufferSize,
 	if (!ready)
 		return 0;
 
+	rtAudit::enter();
+	G_TRACE_THREAD("audio");
+	G_TRACE_SCOPE("mixer::masterPlay");
+
+	int64_t blockStart = u::time::now();
+
 #ifdef __linux__
 	clock::recvJackSync();
 #endif
@@ -450,42 +573,75 @@ int masterPlay(void* outBuf, void* inBuf, unsigned bufferSize,
 	if (kernelAudio::isInputEnabled())
 		in.setData((float*) inBuf, bufferSize, G_MAX_IO_CHANS);
 
-	peakOut = 0.0f;  // reset peak calculator
-	peakIn  = 0.0f;  // reset peak calculator
-
 	clearAllBuffers(out);
+	commandQueue::prepare(blockStart, bufferSize);
+
+	G_TRACE_BEGIN(traceFrames);
 
+	/* Per-frame stages are profiled by laps: whatever runs between a skip() and
+	the next lap() is charged to that stage. */
+
+	profiler::Timer timer;
 	for (unsigned j=0; j<bufferSize; j++) {
+		timer.skip();
 		processLineIn(in, j);
+		timer.lap(profiler::LINE_IN);
+		commandQueue::process(j);
 		if (clock::isRunning()) {
 			lineInRec(in, j);
+			timer.skip();
 			doQuantize(j);
+			timer.lap(profiler::QUANTIZE);
 			testBar(j);
 			testFirstBeat(j);
+			timer.skip();
 			readActions(j);
+			timer.lap(profiler::ACTIONS);
 			clock::incrCurrentFrame();
 			testLastBeat();  // this test must be the last one
 			clock::sendMIDIsync();
 		}
+		timer.skip();
 		sumChannels(j);
+		timer.lap(profiler::SUM_CHANNELS);
 	}
+	timer.flush();
+	G_TRACE_END(traceFrames, "mixer::frames");
 
+	G_TRACE_BEGIN(traceRender);
+	int64_t t = profiler::begin();
 	renderIO(out, in);
+	profiler::end(profiler::RENDER, t);
+	G_TRACE_END(traceRender, "mixer::renderIO");
+
+	/* Post processing. Levels are measured once per block, before the 
+	metronome is added. */
 
-	/* Post processing. */
+	G_TRACE_BEGIN(tracePost);
+	t = profiler::begin();
 	for (unsigned j=0; j<bufferSize; j++) {
 		finalizeOutput(out, j); 
 		if (conf::limitOutput)
 			limitOutput(out, j);
-		computePeak(out, peakOut, j); 
-		renderMetronome(out, j);
 	}
+	levelOut = meter::measure(out);
+	levelIn  = in.isAllocd() ? meter::measure(in) : meter::Level{ 0.0f, 0.0f };
+	for (unsigned j=0; j<bufferSize; j++)
+		renderMetronome(out, j);
+	profiler::end(profiler::POST, t);
+	G_TRACE_END(tracePost, "mixer::post");
+
+	uiState::publish();
+	profiler::endBlock(blockStart, bufferSize, conf::samplerate, status != 0);
+	eventLog::advance(bufferSize);
 
 	/* Unset data in buffers. If you don't do this, buffers go out of scope and
 	destroy memory allocated by RtAudio ---> havoc. */
 	out.setData(nullptr, 0, 0);
 	in.setData(nullptr, 0, 0);
 
+	rtAudit::leave();
+
 	return 0;
 }
 
@@ -498,6 +654,13 @@ void close()
 	clock::stop();
 	while (channels.size() > 0)
 		mh::deleteChannel(channels.at(0));
+	while (columnBuses.size() > 0)
+		mh::deleteColumnBus(columnBuses.at(0));
+	bufferPool::release(vChanInToOut);
+#ifdef WITH_VST
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		bufferPool::release(sendBuses[i]);
+#endif
 }
 
 
@@ -538,6 +701,27 @@ void startInputRec()
 /* -------------------------------------------------------------------------- */
 
 
+void prefault()
+{
+	pthread_mutex_lock(&mutex_chans);
+	for (const Channel* ch : channels)
+		ch->prefault();
+	for (const ColumnBus* bus : columnBuses)
+		realtime::prefault(bus->vChan);
+	pthread_mutex_unlock(&mutex_chans);
+
+	realtime::prefault(vChanInput);
+	realtime::prefault(vChanInToOut);
+#ifdef WITH_VST
+	for (const AudioBuffer& b : sendBuses)
+		realtime::prefault(b);
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void mergeVirtualInput()
 {
 	for (Channel* ch : channels) {
@@ -551,4 +735,17 @@ void mergeVirtualInput()
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+#ifdef WITH_VST
+
+pthread_mutex_t* getPluginMutex(int stackType)
+{
+	if (stackType >= pluginHost::COLUMN_BUS)
+		return &mutex_chans;
+	return &mutex_plugins;
+}
+
+#endif
+
 }}}; // giada::m::mixer::
@@ -32,9 +32,11 @@
 #include <pthread.h>
 #include <vector>
 #include "../deps/rtaudio-mod/RtAudio.h"
+#include "meter.h"
 
 
 class Channel;
+class ColumnBus;
 
 
 namespace giada {
@@ -72,12 +74,29 @@ Starts input recording on frame clock::getCurrentFrame(). */
 
 void startInputRec();
 
+/* prefault
+Touches every page of channel, bus and Wave buffers, so that the audio thread 
+never maps them for the first time. Call it while the stream is stopped. */
+
+void prefault();
+
 /* mergeVirtualInput
 Copies the virtual channel input in the channels designed for input recording. 
 Called by mixerHandler on stopInputRec(). */
 
 void mergeVirtualInput();
 
+#ifdef WITH_VST
+
+/* getPluginMutex
+Returns the mutex to pass to pluginHost when editing the stack 'stackType'. 
+Column bus stacks are processed along with the channels, so they are guarded by
+mutex_chans; the other stacks by mutex_plugins. */
+
+pthread_mutex_t* getPluginMutex(int stackType);
+
+#endif
+
 enum {    // const - what to do when a fadeout ends
 	DO_STOP   = 0x01,
 	DO_MUTE   = 0x02,
@@ -91,12 +110,23 @@ enum {    // const - fade types
 
 extern std::vector<Channel*> channels;
 
+/* columnBuses
+Active column buses. Guarded by mutex_chans, like channels. */
+
+extern std::vector<ColumnBus*> columnBuses;
+
 extern bool   recording;         // is recording something?
 extern bool   ready;
 extern float  outVol;
 extern float  inVol;
-extern float  peakOut;
-extern float  peakIn;
+
+/* levelOut, levelIn
+Output (pre-metronome) and input levels of the last block. Audio thread only:
+read them through uiState. */
+
+extern meter::Level levelOut;
+extern meter::Level levelIn;
+
 extern bool	  metronome;
 extern int    waitRec;       // delayComp guard
 extern bool   rewindWait;	   // rewind guard, if quantized
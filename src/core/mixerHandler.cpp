@@ -27,6 +27,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <functional>
 #include "../utils/fs.h"
 #include "../utils/string.h"
 #include "../utils/log.h"
@@ -45,12 +46,15 @@
 #include "clock.h"
 #include "channel.h"
 #include "kernelAudio.h"
+#include "realtime.h"
 #include "midiMapConf.h"
 #include "sampleChannel.h"
 #include "midiChannel.h"
 #include "wave.h"
 #include "waveManager.h"
 #include "channelManager.h"
+#include "columnBus.h"
+#include "commandQueue.h"
 #include "mixerHandler.h"
 
 
@@ -73,9 +77,10 @@ int readPatchPlugins(vector<patch::plugin_t>* list, int type)
 		patch::plugin_t *ppl = &list->at(i);
 		// TODO use glue_addPlugin()
 		Plugin *plugin = pluginHost::addPlugin(ppl->path.c_str(), type,
-				&mixer::mutex_plugins, nullptr);
+				mixer::getPluginMutex(type), nullptr);
 		if (plugin != nullptr) {
 			plugin->setBypass(ppl->bypass);
+			plugin->setKeepAwake(ppl->keepAwake);
 			for (unsigned j=0; j<ppl->params.size(); j++)
 				plugin->setParameter(j, ppl->params.at(j));
 			ret &= 1;
@@ -109,6 +114,49 @@ int getNewChanIndex()
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+/* renderFreeze
+Renders a neutral copy of 'src', see cloneForRender(). Two loops are rendered 
+and only the second one is kept, so that tails crossing the loop boundary end 
+up at the beginning of the Wave, as they would when playing live. */
+
+int renderFreeze(const Channel* src, Wave** out)
+{
+	realtime::flushDenormals();
+
+	RenderContext ctx = getRenderContext();
+	int period = ctx.lastFrame + 1;
+
+	Wave* wave = nullptr;
+	int res = waveManager::createEmpty(period, G_MAX_IO_CHANS, conf::samplerate, 
+		src->name + "-frozen", &wave);
+	if (res != G_RES_OK)
+		return res;
+
+	Channel* ch = cloneForRender(src, true);
+	if (ch == nullptr) {
+		delete wave;
+		return G_RES_ERR_MEMORY;
+	}
+	res = renderChannel(ch, recorder::getActions(src->index, &mixer::mutex_recs),
+		ctx, period * 2, 
+		[&](const AudioBuffer& buf, int rendered, const vector<int>& seqFrames)
+	{
+		for (int j=0; j<buf.countFrames(); j++)
+			if (rendered + j >= period && rendered + j < period * 2)
+				wave->copyData(buf[j], 1, seqFrames[j]);
+		return true;
+	});
+	freeRenderCopy(ch);
+	if (res != G_RES_OK) {
+		delete wave;
+		return res;
+	}
+
+	*out = wave;
+	return G_RES_OK;
+}
 }; // {anonymous}
 
 
@@ -168,6 +216,7 @@ void deleteChannel(Channel* target)
 		if (it != mixer::channels.end()) 
 			mixer::channels.erase(it);
 		pthread_mutex_unlock(&mixer::mutex_chans);
+		commandQueue::forget(target);  // commands in flight may point to it
 		return;
 	}
 }
@@ -263,6 +312,8 @@ void readPatch()
 
 	readPatchPlugins(&patch::masterInPlugins, pluginHost::MASTER_IN);
 	readPatchPlugins(&patch::masterOutPlugins, pluginHost::MASTER_OUT);
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		readPatchPlugins(&patch::sendBusPlugins[i], pluginHost::SEND_BUS + i);
 
 #endif
 
@@ -354,4 +405,284 @@ bool hasArmedSampleChannels()
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+
+Channel* cloneForRender(const Channel* src, bool neutral)
+{
+	Channel* ch = nullptr;
+	if (channelManager::create(src->type, kernelAudio::getRealBufSize(), false, &ch) != G_RES_OK)
+		return nullptr;
+
+	/* No mute and no MIDI to the outside world. A neutral copy also leaves out
+	volume, panning and boost (they are still applied live on a frozen 
+	channel). The copy leaves no actions in the recorder: renderChannel() is 
+	given a snapshot of those of 'src'. */
+
+	ch->index       = src->index;
+	ch->copy(src, &mixer::mutex_plugins, false);
+	ch->armed       = false;
+	ch->mute        = false;
+	ch->midiOutL    = false;
+	ch->readActions = true;
+	ch->recStatus   = REC_STOPPED;
+	ch->unsetMute(true);
+	if (neutral) {
+		ch->volume = 1.0f;
+		ch->pan    = 0.5f;
+		ch->setVolumeI(1.0f);
+	}
+
+	bool mustStart = true;
+	if (ch->type == G_CHANNEL_SAMPLE) {
+		SampleChannel* sch = static_cast<SampleChannel*>(ch);
+		if (neutral)
+			sch->setBoost(1.0f);
+		mustStart = sch->mode & LOOP_ANY;
+	}
+	else
+		static_cast<MidiChannel*>(ch)->midiOut = false;
+
+	if (mustStart)  // will actually play on frame 0, see Channel::onZero()
+		ch->start(0, false, 0, true, false, false);
+
+	return ch;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void freeRenderCopy(Channel* ch)
+{
+#ifdef WITH_VST
+	pluginHost::freeStack(pluginHost::CHANNEL, &mixer::mutex_plugins, ch);
+#endif
+	delete ch;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+RenderContext getRenderContext()
+{
+	RenderContext ctx;
+	ctx.bufSize            = kernelAudio::getRealBufSize();
+	ctx.lastFrame          = clock::getFramesInLoop();
+	ctx.framesInBar        = clock::getFramesInBar();
+	ctx.recsStopOnChanHalt = conf::recsStopOnChanHalt;
+	return ctx;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int renderChannel(Channel* ch, const vector<recorder::action>& actions, 
+	const RenderContext& ctx, int frames, 
+	std::function<bool(const AudioBuffer&, int, const vector<int>&)> f)
+{
+	int bufSize = ctx.bufSize;
+
+	AudioBuffer outBuf, inBuf;
+	if (!outBuf.alloc(bufSize, G_MAX_IO_CHANS) || !inBuf.alloc(bufSize, G_MAX_IO_CHANS))
+		return G_RES_ERR_MEMORY;
+
+	vector<int> seqFrames(bufSize);
+	unsigned nextAction = 0;
+	int      frame      = 0;
+
+	for (int rendered=0; rendered<frames; rendered+=bufSize) {
+
+		ch->clear();
+		outBuf.clear();
+
+		for (int j=0; j<bufSize; j++) {
+			if (frame == 0) {
+				ch->onZero(j, ctx.recsStopOnChanHalt);
+				nextAction = 0;
+			}
+			else
+			if (frame % ctx.framesInBar == 0)
+				ch->onBar(j);
+			for (; nextAction<actions.size() && actions[nextAction].frame == frame; nextAction++) {
+				recorder::action a = actions[nextAction];
+				ch->parseAction(&a, j, frame, 0, true);
+			}
+			frame = frame == ctx.lastFrame ? 0 : frame + 1;
+			if (ch->type == G_CHANNEL_SAMPLE)
+				static_cast<SampleChannel*>(ch)->sum(j, true);
+			seqFrames[j] = frame;
+		}
+
+#ifdef WITH_VST
+		/* This is not the audio thread: MIDI events sent to plug-ins while 
+		parsing the block (actions, all-notes-off on rewind and kill) have been
+		queued. Deliver them now, at their frame in this block, as the audio 
+		thread would have done inline. */
+
+		ch->drainMidiQueue();
+#endif
+		ch->process(outBuf, inBuf);
+		if (!f(outBuf, rendered, seqFrames))
+			return G_RES_ERR;
+	}
+	return G_RES_OK;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int freezeChannel(Channel* ch)
+{
+	Wave* wave = nullptr;
+	int res = renderFreeze(ch, &wave);
+	if (res != G_RES_OK) {
+		gu_log("[freezeChannel] unable to render channel %d!\n", ch->index);
+		return res;
+	}
+
+	while (true) {
+		if (pthread_mutex_trylock(&mixer::mutex_chans) != 0)
+			continue;
+		ch->freeze(wave);
+		pthread_mutex_unlock(&mixer::mutex_chans);
+		break;
+	}
+
+	gu_log("[freezeChannel] channel %d frozen, %d frames\n", ch->index, 
+		wave->getSize());
+	return G_RES_OK;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void unfreezeChannel(Channel* ch)
+{
+	Wave* wave = nullptr;
+	while (true) {
+		if (pthread_mutex_trylock(&mixer::mutex_chans) != 0)
+			continue;
+		wave = ch->unfreeze();
+		pthread_mutex_unlock(&mixer::mutex_chans);
+		break;
+	}
+	delete wave;
+
+#ifdef WITH_VST
+
+	/* Note-off events sent while frozen never reached the plug-ins. */
+
+	if (ch->type == G_CHANNEL_MIDI)
+		ch->sendVstMidiEvent(MIDI_ALL_NOTES_OFF);
+
+#endif
+
+	gu_log("[unfreezeChannel] channel %d unfrozen\n", ch->index);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+ColumnBus* addColumnBus()
+{
+	ColumnBus* bus = new ColumnBus();
+	if (!bus->allocBuffers()) {
+		delete bus;
+		return nullptr;
+	}
+
+	while (true) {
+		if (pthread_mutex_trylock(&mixer::mutex_chans) != 0)
+			continue;
+		mixer::columnBuses.push_back(bus);
+		pthread_mutex_unlock(&mixer::mutex_chans);
+		break;
+	}
+
+	gu_log("[addColumnBus] column bus id=%d added, total=%d\n", bus->id,
+		mixer::columnBuses.size());
+	return bus;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void deleteColumnBus(ColumnBus* bus)
+{
+	/* Free plug-ins first: pluginHost looks up the stack through the list of 
+	active buses. */
+
+#ifdef WITH_VST
+	pluginHost::freeStack(pluginHost::COLUMN_BUS + bus->id, 
+		mixer::getPluginMutex(pluginHost::COLUMN_BUS));
+#endif
+
+	while (true) {
+		if (pthread_mutex_trylock(&mixer::mutex_chans) != 0)
+			continue;
+		auto it = std::find(mixer::columnBuses.begin(), mixer::columnBuses.end(), bus);
+		if (it != mixer::columnBuses.end()) 
+			mixer::columnBuses.erase(it);
+		for (Channel* ch : mixer::channels)
+			if (ch->columnBus == bus)
+				ch->columnBus = nullptr;
+		pthread_mutex_unlock(&mixer::mutex_chans);
+		break;
+	}
+
+	gu_log("[deleteColumnBus] column bus id=%d deleted\n", bus->id);
+	delete bus;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void setColumnBus(Channel* ch, ColumnBus* bus)
+{
+	while (true) {
+		if (pthread_mutex_trylock(&mixer::mutex_chans) != 0)
+			continue;
+		ch->columnBus = bus;
+		pthread_mutex_unlock(&mixer::mutex_chans);
+		break;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+ColumnBus* getColumnBusById(int id)
+{
+	for (ColumnBus* bus : mixer::columnBuses)
+		if (bus->id == id)
+			return bus;
+	return nullptr;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void readPatchColumnBus(ColumnBus* bus, int i)
+{
+	const patch::column_t& pcol = patch::columns.at(i);
+
+	bus->volume = pcol.busVolume;
+	bus->mute   = pcol.busMute;
+
+#ifdef WITH_VST
+	readPatchPlugins(&patch::columns.at(i).busPlugins, pluginHost::COLUMN_BUS + bus->id);
+#endif
+}
+
+
 }}}; // giada::m::mh::
@@ -30,14 +30,19 @@
 
 
 #include <string>
+#include <vector>
+#include <functional>
+#include "recorder.h"
 
 
 class Channel;
 class SampleChannel;
+class ColumnBus;
 
 
 namespace giada {
 namespace m {
+class AudioBuffer;
 namespace mh
 {
 /* addChannel
@@ -102,6 +107,88 @@ Tells whether Mixer has one or more sample channels armed for input
 recording. */
 
 bool hasArmedSampleChannels();
+
+/* cloneForRender
+Makes a private copy of channel 'src' for renderChannel(), started from the
+beginning of the sequencer. A 'neutral' copy leaves out volume, panning and 
+boost. It allocates pool buffers and clones plug-ins: main thread only. Returns
+nullptr on failure. */
+
+Channel* cloneForRender(const Channel* src, bool neutral);
+
+/* freeRenderCopy
+Deletes a copy made by cloneForRender(). Main thread only. */
+
+void freeRenderCopy(Channel* ch);
+
+/* RenderContext
+The sequencer as seen by renderChannel(). It is read on the main thread along
+with the copy, so that renderers never look at the live clock or configuration
+while the user changes them. */
+
+struct RenderContext
+{
+	int  bufSize;
+	int  lastFrame;    // clock runs from 0 to lastFrame included
+	int  framesInBar;
+	bool recsStopOnChanHalt;
+};
+
+/* getRenderContext
+Main thread only. */
+
+RenderContext getRenderContext();
+
+/* renderChannel
+Renders 'frames' frames of 'ch', a copy made by cloneForRender(), playing 
+'actions' (see recorder::getActions()) through its plug-in stack. 'f' is called 
+on each block with the frames rendered so far and the sequencer frame of each 
+block frame; if it returns false the render stops there. The copy is never 
+visible to the audio thread and nothing shared is read or modified, so workers
+can render different copies at the same time. Returns G_RES_OK on success, 
+G_RES_ERR if stopped by 'f'. */
+
+int renderChannel(Channel* ch, const std::vector<recorder::action>& actions, 
+	const RenderContext& ctx, int frames, 
+	std::function<bool(const AudioBuffer&, int, const std::vector<int>&)> f);
+
+/* freezeChannel
+Renders one loop of channel 'ch', recorded actions and plug-in stack included,
+into a Wave and plays it back in place of the live chain. Returns G_RES_OK on
+success. */
+
+int freezeChannel(Channel* ch);
+
+/* unfreezeChannel
+Drops the rendered Wave and restores the live chain of a frozen channel. */
+
+void unfreezeChannel(Channel* ch);
+
+/* addColumnBus
+Creates a new column bus and adds it to Mixer. Returns nullptr on error. */
+
+ColumnBus* addColumnBus();
+
+/* deleteColumnBus
+Frees the plug-in stack of 'bus', routes its channels back to the master output
+and deletes it. */
+
+void deleteColumnBus(ColumnBus* bus);
+
+/* setColumnBus
+Routes channel 'ch' to column bus 'bus' (nullptr: master output). */
+
+void setColumnBus(Channel* ch, ColumnBus* bus);
+
+/* getColumnBusById
+Returns the column bus with id 'id', or nullptr if not found. */
+
+ColumnBus* getColumnBusById(int id);
+
+/* readPatchColumnBus
+Fills 'bus' with data from patch column 'i'. */
+
+void readPatchColumnBus(ColumnBus* bus, int i);
 }}}  // giada::m::mh::
 
 
@@ -28,6 +28,7 @@
 #include "../utils/log.h"
 #include "../utils/string.h"
 #include "const.h"
+#include "trace.h"
 #include "storager.h"
 #include "conf.h"
 #include "mixer.h"
@@ -61,6 +62,7 @@ void sanitize()
 		column_t* col = &columns.at(i);
 		col->index = col->index < 0 ? 0 : col->index;
 		col->width = col->width < G_MIN_COLUMN_WIDTH ? G_MIN_COLUMN_WIDTH : col->width;
+		col->busVolume = col->busVolume < 0.0f || col->busVolume > 1.0f ? G_DEFAULT_VOL : col->busVolume;
 	}
 
 	for (unsigned i=0; i<channels.size(); i++) {
@@ -70,6 +72,10 @@ void sanitize()
 		ch->pan    = ch->pan < 0.0f || ch->pan > 1.0f ? 1.0f : ch->pan;
 		ch->boost  = ch->boost < 1.0f ? G_DEFAULT_BOOST : ch->boost;
 		ch->pitch  = ch->pitch < 0.1f || ch->pitch > G_MAX_PITCH ? G_DEFAULT_PITCH : ch->pitch;
+#ifdef WITH_VST
+		for (float& level : ch->sendLevels)
+			level = level < 0.0f || level > 1.0f ? 0.0f : level;
+#endif
 	}
 }
 
@@ -147,6 +153,7 @@ bool readPlugins(json_t* jContainer, vector<plugin_t>* container, const char* ke
 		plugin_t plugin;
 		if (!storager::setString(jPlugin, PATCH_KEY_PLUGIN_PATH,   plugin.path)) return 0;
 		if (!storager::setBool  (jPlugin, PATCH_KEY_PLUGIN_BYPASS, plugin.bypass)) return 0;
+		if (!storager::setBool  (jPlugin, PATCH_KEY_PLUGIN_KEEP_AWAKE, plugin.keepAwake)) return 0;
 
 		/* read plugin params */
 
@@ -173,6 +180,57 @@ bool readPlugins(json_t* jContainer, vector<plugin_t>* container, const char* ke
 	return 1;
 }
 
+
+/* -------------------------------------------------------------------------- */
+
+/* readSendLevels
+Send levels are optional: older patches don't have them. */
+
+bool readSendLevels(json_t* jContainer, channel_t* channel)
+{
+	json_t* jLevels = json_object_get(jContainer, PATCH_KEY_CHANNEL_SEND_LEVELS);
+	if (jLevels == nullptr)
+		return 1;
+	if (!storager::checkArray(jLevels, PATCH_KEY_CHANNEL_SEND_LEVELS))
+		return 0;
+
+	size_t levelIndex;
+	json_t* jLevel;
+	json_array_foreach(jLevels, levelIndex, jLevel) {
+		if (levelIndex >= G_MAX_SEND_BUSES)
+			break;
+		channel->sendLevels.push_back(json_real_value(jLevel));
+	}
+	return 1;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* readSendBuses
+Same as above, send buses are optional. */
+
+bool readSendBuses(json_t* jContainer)
+{
+	json_t* jBuses = json_object_get(jContainer, PATCH_KEY_SEND_BUSES);
+	if (jBuses == nullptr)
+		return 1;
+	if (!storager::checkArray(jBuses, PATCH_KEY_SEND_BUSES))
+		return 0;
+
+	size_t busIndex;
+	json_t* jBus;
+	json_array_foreach(jBuses, busIndex, jBus) {
+		if (busIndex >= G_MAX_SEND_BUSES)
+			break;
+		if (!storager::checkObject(jBus, PATCH_KEY_SEND_BUSES))
+			return 0;
+		if (!readPlugins(jBus, &sendBusPlugins[busIndex], PATCH_KEY_SEND_BUS_PLUGINS))
+			return 0;
+	}
+	return 1;
+}
+
 #endif
 
 /* -------------------------------------------------------------------------- */
@@ -264,6 +322,7 @@ bool readChannels(json_t* jContainer)
 
 #ifdef WITH_VST
 		readPlugins(jChannel, &channel.plugins, PATCH_KEY_CHANNEL_PLUGINS);
+		if (!readSendLevels(jChannel, &channel)) return 0;
 #endif
 		channels.push_back(channel);
 	}
@@ -289,8 +348,16 @@ bool readColumns(json_t* jContainer)
 			return 0;
 
 		column_t column;
-		if (!storager::setInt(jColumn, PATCH_KEY_COLUMN_INDEX, column.index)) return 0;
-		if (!storager::setInt(jColumn, PATCH_KEY_COLUMN_WIDTH, column.width)) return 0;
+		if (!storager::setInt  (jColumn, PATCH_KEY_COLUMN_INDEX,      column.index)) return 0;
+		if (!storager::setInt  (jColumn, PATCH_KEY_COLUMN_WIDTH,      column.width)) return 0;
+		if (!storager::setBool (jColumn, PATCH_KEY_COLUMN_BUS,        column.bus)) return 0;
+		if (!storager::setFloat(jColumn, PATCH_KEY_COLUMN_BUS_VOLUME, column.busVolume)) return 0;
+		if (!storager::setBool (jColumn, PATCH_KEY_COLUMN_BUS_MUTE,   column.busMute)) return 0;
+
+#ifdef WITH_VST
+		if (column.bus)
+			readPlugins(jColumn, &column.busPlugins, PATCH_KEY_COLUMN_BUS_PLUGINS);
+#endif
 
 		columns.push_back(column);
 	}
@@ -310,6 +377,7 @@ void writePlugins(json_t* jContainer, vector<plugin_t>* plugins, const char* key
 		plugin_t plugin  = plugins->at(j);
 		json_object_set_new(jPlugin, PATCH_KEY_PLUGIN_PATH,   json_string(plugin.path.c_str()));
 		json_object_set_new(jPlugin, PATCH_KEY_PLUGIN_BYPASS, json_boolean(plugin.bypass));
+		json_object_set_new(jPlugin, PATCH_KEY_PLUGIN_KEEP_AWAKE, json_boolean(plugin.keepAwake));
 		json_array_append_new(jPlugins, jPlugin);
 
 		/* plugin params */
@@ -329,6 +397,33 @@ void writePlugins(json_t* jContainer, vector<plugin_t>* plugins, const char* key
 	json_object_set_new(jContainer, key, jPlugins);
 }
 
+
+/* -------------------------------------------------------------------------- */
+
+
+void writeSendLevels(json_t* jContainer, vector<float>* levels)
+{
+	json_t* jLevels = json_array();
+	for (float level : *levels)
+		json_array_append_new(jLevels, json_real(level));
+	json_object_set_new(jContainer, PATCH_KEY_CHANNEL_SEND_LEVELS, jLevels);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void writeSendBuses(json_t* jContainer)
+{
+	json_t* jBuses = json_array();
+	for (int i=0; i<G_MAX_SEND_BUSES; i++) {
+		json_t* jBus = json_object();
+		writePlugins(jBus, &sendBusPlugins[i], PATCH_KEY_SEND_BUS_PLUGINS);
+		json_array_append_new(jBuses, jBus);
+	}
+	json_object_set_new(jContainer, PATCH_KEY_SEND_BUSES, jBuses);
+}
+
 #endif
 
 
@@ -341,8 +436,16 @@ void writeColumns(json_t* jContainer, vector<column_t>* columns)
 	for (unsigned i=0; i<columns->size(); i++) {
 		json_t*  jColumn = json_object();
 		column_t column  = columns->at(i);
-		json_object_set_new(jColumn, PATCH_KEY_COLUMN_INDEX, json_integer(column.index));
-		json_object_set_new(jColumn, PATCH_KEY_COLUMN_WIDTH, json_integer(column.width));
+		json_object_set_new(jColumn, PATCH_KEY_COLUMN_INDEX,      json_integer(column.index));
+		json_object_set_new(jColumn, PATCH_KEY_COLUMN_WIDTH,      json_integer(column.width));
+		json_object_set_new(jColumn, PATCH_KEY_COLUMN_BUS,        json_boolean(column.bus));
+		json_object_set_new(jColumn, PATCH_KEY_COLUMN_BUS_VOLUME, json_real(column.busVolume));
+		json_object_set_new(jColumn, PATCH_KEY_COLUMN_BUS_MUTE,   json_boolean(column.busMute));
+
+#ifdef WITH_VST
+		if (column.bus)
+			writePlugins(jColumn, &column.busPlugins, PATCH_KEY_COLUMN_BUS_PLUGINS);
+#endif
 		json_array_append_new(jColumns, jColumn);
 	}
 	json_object_set_new(jContainer, PATCH_KEY_COLUMNS, jColumns);
@@ -445,6 +548,7 @@ void writeChannels(json_t* jContainer, vector<channel_t>* channels)
 #ifdef WITH_VST
 
 		writePlugins(jChannel, &channel.plugins, PATCH_KEY_CHANNEL_PLUGINS);
+		writeSendLevels(jChannel, &channel.sendLevels);
 
 #endif
 	}
@@ -481,6 +585,7 @@ std::vector<channel_t> channels;
 #ifdef WITH_VST
 std::vector<plugin_t> masterInPlugins;
 std::vector<plugin_t> masterOutPlugins;
+std::vector<plugin_t> sendBusPlugins[G_MAX_SEND_BUSES];
 #endif
 
 
@@ -494,6 +599,8 @@ void init()
 #ifdef WITH_VST
 	masterInPlugins.clear();
 	masterOutPlugins.clear();
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		sendBusPlugins[i].clear();
 #endif
 	header     = "GIADAPTC";
 	lastTakeId = 0;
@@ -506,6 +613,8 @@ void init()
 
 int write(const string& file)
 {
+	G_TRACE_SCOPE("patch::write");
+
 	json_t* jRoot = json_object();
 
 	writeCommons(jRoot);
@@ -514,6 +623,7 @@ int write(const string& file)
 #ifdef WITH_VST
 	writePlugins(jRoot, &masterInPlugins, PATCH_KEY_MASTER_IN_PLUGINS);
 	writePlugins(jRoot, &masterOutPlugins, PATCH_KEY_MASTER_OUT_PLUGINS);
+	writeSendBuses(jRoot);
 #endif
 
 	if (json_dump_file(jRoot, file.c_str(), JSON_COMPACT) != 0) {
@@ -529,6 +639,8 @@ int write(const string& file)
 
 int read(const string& file)
 {
+	G_TRACE_SCOPE("patch::read");
+
 	json_error_t jError;
 	json_t* jRoot = json_load_file(file.c_str(), 0, &jError);
 	if (!jRoot) {
@@ -550,6 +662,7 @@ int read(const string& file)
 #ifdef WITH_VST
 	if (!readPlugins(jRoot, &masterInPlugins, PATCH_KEY_MASTER_IN_PLUGINS))   return setInvalid(jRoot);
 	if (!readPlugins(jRoot, &masterOutPlugins, PATCH_KEY_MASTER_OUT_PLUGINS)) return setInvalid(jRoot);
+	if (!readSendBuses(jRoot))                                                return setInvalid(jRoot);
 #endif
 
 	json_decref(jRoot);
@@ -32,6 +32,7 @@
 #include <string>
 #include <vector>
 #include <cstdint>
+#include "const.h"
 
 
 namespace giada {
@@ -51,6 +52,7 @@ struct plugin_t
 {
 	std::string           path;
 	bool                  bypass;
+	bool                  keepAwake;
 	std::vector<float>    params;
 	std::vector<uint32_t> midiInParams;
 };
@@ -103,14 +105,21 @@ struct channel_t
 
 #ifdef WITH_VST
 	std::vector<plugin_t> plugins;
+	std::vector<float>    sendLevels;
 #endif
 };
 
 struct column_t
 {
-	int index;
-	int width;
+	int   index;
+	int   width;
+	bool  bus;
+	float busVolume;
+	bool  busMute;
 	std::vector<int> channels;
+#ifdef WITH_VST
+	std::vector<plugin_t> busPlugins;
+#endif
 };
 
 extern std::string header;
@@ -135,6 +144,7 @@ extern std::vector<channel_t> channels;
 #ifdef WITH_VST
 extern std::vector<plugin_t> masterInPlugins;
 extern std::vector<plugin_t> masterOutPlugins;
+extern std::vector<plugin_t> sendBusPlugins[G_MAX_SEND_BUSES];
 #endif
 
 /* init
@@ -47,16 +47,24 @@ int Plugin::idGenerator = 1;
 
 Plugin::Plugin(juce::AudioPluginInstance *plugin, double samplerate,
 	int buffersize)
-	: ui    (nullptr),
-		plugin(plugin),
-		id    (idGenerator++),
-		bypass(false)
+	: ui          (nullptr),
+		plugin      (plugin),
+		id          (idGenerator++),
+		bypass      (false),
+		keepAwake   (false),
+		silentFrames(0),
+		sleeping    (false)
 {
 	/* Init midiInParams. All values are empty (0x0): they will be filled during
 	midi learning process. */
 
 	for (int i=0; i<plugin->getNumParameters(); i++)
 		midiInParams.push_back(0x0);
+
+	/* Index -1 marks a parameter with no pending change. */
+
+	pendingParams.resize(plugin->getNumParameters(), { -1, 0.0f, 0 });
+	dirtyParams.reserve(plugin->getNumParameters());
 	
 	plugin->prepareToPlay(samplerate, buffersize);
 
@@ -148,6 +156,48 @@ void Plugin::setParameter(int paramIndex, float value) const
 /* -------------------------------------------------------------------------- */
 
 
+bool Plugin::postParameter(int paramIndex, float value, bool gui, int frame)
+{
+	return gui ? guiParams.push({ paramIndex, value, frame }) :
+	             midiParams.push({ paramIndex, value, frame });
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Plugin::drainParams(giada::m::Queue<ParamChange, G_PLUGIN_PARAM_QUEUE>& q)
+{
+	ParamChange c;
+	while (q.pop(c)) {
+		if (c.index < 0 || (unsigned) c.index >= pendingParams.size())
+			continue;
+		if (pendingParams[c.index].index == -1)
+			dirtyParams.push_back(c.index);
+		pendingParams[c.index] = c;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Plugin::applyParams()
+{
+	drainParams(guiParams);
+	drainParams(midiParams);
+
+	for (int index : dirtyParams) {
+		plugin->setParameter(index, pendingParams[index].value);
+		pendingParams[index].index = -1;
+	}
+	dirtyParams.clear();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void Plugin::prepareToPlay(double samplerate, int buffersize) const
 {
 	plugin->prepareToPlay(samplerate, buffersize);
@@ -184,6 +234,15 @@ bool Plugin::acceptsMidi() const
 /* -------------------------------------------------------------------------- */
 
 
+double Plugin::getTailLengthSeconds() const
+{
+	return plugin->getTailLengthSeconds();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 bool Plugin::isBypassed() const { return bypass; }
 void Plugin::toggleBypass() { bypass = !bypass; }
 void Plugin::setBypass(bool b) { bypass = b; }
@@ -192,6 +251,35 @@ void Plugin::setBypass(bool b) { bypass = b; }
 /* -------------------------------------------------------------------------- */
 
 
+bool Plugin::isKeptAwake() const { return keepAwake; }
+void Plugin::toggleKeepAwake() { keepAwake = !keepAwake; }
+void Plugin::setKeepAwake(bool b) { keepAwake = b; }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool Plugin::isSleeping() const { return sleeping; }
+void Plugin::sleep() { sleeping = true; }
+
+
+void Plugin::wake()
+{
+	sleeping     = false;
+	silentFrames = 0;
+}
+
+
+int Plugin::addSilentFrames(int frames)
+{
+	silentFrames += frames;
+	return silentFrames;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 int Plugin::getId() const { return id; }
 
 
@@ -232,6 +320,24 @@ int Plugin::getCurrentProgram() const
 /* -------------------------------------------------------------------------- */
 
 
+void Plugin::getState(juce::MemoryBlock& out) const
+{
+	plugin->getStateInformation(out);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Plugin::setState(const juce::MemoryBlock& in) const
+{
+	plugin->setStateInformation(in.getData(), (int) in.getSize());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void Plugin::setCurrentProgram(int index) const
 {
 	plugin->setCurrentProgram(index);
@@ -33,21 +33,68 @@
 #define G_PLUGIN_H
 
 
+#include <vector>
 #include "../deps/juce-config.h"
+#include "const.h"
+#include "queue.h"
 
 
 class Plugin
 {
+public:
+
+	/* ParamChange
+	A parameter change waiting to be applied by the audio thread. 'frame' is the
+	offset within the block the change refers to: changes are applied at block 
+	boundaries for now, the offset is kept for sample-accurate automation. */
+
+	struct ParamChange
+	{
+		int   index;
+		float value;
+		int   frame;
+	};
+
 private:
 
 	static int idGenerator;
 
+	/* guiParams, midiParams
+	Parameter changes posted by the GUI thread and by the MIDI thread. One queue
+	per producer, as giada::m::Queue is single-producer. */
+
+	giada::m::Queue<ParamChange, G_PLUGIN_PARAM_QUEUE> guiParams;
+	giada::m::Queue<ParamChange, G_PLUGIN_PARAM_QUEUE> midiParams;
+
+	/* pendingParams, dirtyParams
+	Scratch space for applyParams(), owned by the audio thread: the last change
+	per parameter index and the list of indexes touched in the current block. 
+	Both sized at construction time. */
+
+	std::vector<ParamChange> pendingParams;
+	std::vector<int>         dirtyParams;
+
+	void drainParams(giada::m::Queue<ParamChange, G_PLUGIN_PARAM_QUEUE>& q);
+
 	juce::AudioProcessorEditor* ui;    // gui
 	juce::AudioPluginInstance* plugin; // core
 
 	int id;
 	bool bypass;
 
+	/* keepAwake
+	Opt-out from the automatic sleep: the plug-in is always processed, even on
+	silent input. */
+
+	bool keepAwake;
+
+	/* silentFrames, sleeping
+	Automatic sleep state, owned by the audio thread: how many frames of silent
+	input have been processed so far and whether processBlock is being skipped. */
+
+	int  silentFrames;
+	bool sleeping;
+
 public:
 
 	Plugin(juce::AudioPluginInstance* p, double samplerate, int buffersize);
@@ -84,9 +131,32 @@ public:
 	int getEditorW() const;
 	int getEditorH() const;
 	void setParameter(int index, float value) const;
+
+	/* postParameter
+	Queues a parameter change, applied by the audio thread at the beginning of the
+	next block. 'gui' tells the producer: true for the GUI thread, false for the 
+	MIDI thread. Returns false if the queue is full and the change was dropped. */
+
+	bool postParameter(int index, float value, bool gui, int frame=0);
+
+	/* applyParams
+	Applies the queued parameter changes. Bursts of changes to the same parameter
+	(e.g. a MIDI CC sweep) are coalesced into the last one. Audio thread only. */
+
+	void applyParams();
 	void prepareToPlay(double samplerate, int buffersize) const;
 	void setCurrentProgram(int index) const;
+
+	/* getState, setState
+	The whole internal state of the plug-in as an opaque chunk, as stored by the
+	plug-in itself: parameters alone miss programs, loaded files and the like. 
+	Main thread only. */
+
+	void getState(juce::MemoryBlock& out) const;
+	void setState(const juce::MemoryBlock& in) const;
+
 	bool acceptsMidi() const;
+	double getTailLengthSeconds() const;
 
 	void showEditor(void* parent);
 
@@ -98,6 +168,19 @@ public:
 	void toggleBypass();
 	void setBypass(bool b);
 
+	bool isKeptAwake() const;
+	void toggleKeepAwake();
+	void setKeepAwake(bool b);
+
+	/* isSleeping, sleep, wake, addSilentFrames
+	Automatic sleep management, see pluginHost::processStack(). Audio thread 
+	only. */
+
+	bool isSleeping() const;
+	void sleep();
+	void wake();
+	int  addSilentFrames(int frames);
+
 	/* midiInParams
 	A list of midiIn hex values for parameter automation. */
 
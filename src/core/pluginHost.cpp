@@ -28,13 +28,18 @@
 #ifdef WITH_VST
 
 
-#include <cassert>
+#include <cmath>
+#include <limits>
 #include "../utils/log.h"
 #include "../utils/fs.h"
 #include "../utils/string.h"
 #include "const.h"
 #include "channel.h"
+#include "columnBus.h"
+#include "mixerHandler.h"
 #include "plugin.h"
+#include "profiler.h"
+#include "trace.h"
 #include "pluginHost.h"
 
 
@@ -67,11 +72,14 @@ vector<string> unknownPluginList;
 
 vector<Plugin*> masterOut;
 vector<Plugin*> masterIn;
+vector<Plugin*> sendBuses[G_MAX_SEND_BUSES];
 
-/* Audio|MidiBuffer
- * Dynamic buffers. */
+/* audioBuffer
+Scratch buffer for processStack(). One per thread: offline renderers (freeze,
+stems) process their own channel copies while the audio thread is running. 
+Sized on first use. */
 
-juce::AudioBuffer<float> audioBuffer;
+thread_local juce::AudioBuffer<float> audioBuffer;
 
 int samplerate;
 int buffersize;
@@ -124,17 +132,46 @@ const juce::PluginDescription* findPluginDescription(const string& id)
 	}
 	return nullptr;
 }
-}; // {anonymous}
 
 
 /* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
-/* -------------------------------------------------------------------------- */
 
 
-pthread_mutex_t mutex_midi;
+/* processEffect
+Runs an effect plug-in on audioBuffer, unless it is sleeping. A plug-in falls 
+asleep once its input has been silent for longer than its tail and its output
+has decayed below G_PLUGIN_SLEEP_THRESHOLD. Non-silent input wakes it up. */
+
+void processEffect(Plugin* p)
+{
+	int frames = audioBuffer.getNumSamples();
+
+	if (p->isKeptAwake() || audioBuffer.getMagnitude(0, frames) >= G_PLUGIN_SLEEP_THRESHOLD) {
+		p->wake();
+		p->process(audioBuffer, juce::MidiBuffer());
+		return;
+	}
+
+	if (p->isSleeping()) {
+		audioBuffer.clear();
+		return;
+	}
+
+	p->process(audioBuffer, juce::MidiBuffer());
+
+	/* Infinite tails never satisfy the comparison below: such plug-ins stay 
+	awake. */
 
+	double tail = p->getTailLengthSeconds() * samplerate;
+	if (p->addSilentFrames(frames) > tail && 
+	    audioBuffer.getMagnitude(0, frames) < G_PLUGIN_SLEEP_THRESHOLD)
+		p->sleep();
+}
+}; // {anonymous}
 
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
 /* -------------------------------------------------------------------------- */
 
 
@@ -150,15 +187,12 @@ void close()
 void init(int buffersize_, int samplerate_)
 {
 	messageManager = juce::MessageManager::getInstance();
-	audioBuffer.setSize(G_MAX_IO_CHANS, buffersize_);
 	samplerate = samplerate_;
 	buffersize = buffersize_;
 	missingPlugins = false;
 	//unknownPluginList.empty();
 	loadList(gu_getHomePath() + G_SLASH + "plugins.xml");
 
-	pthread_mutex_init(&mutex_midi, nullptr);
-
 	gu_log("[pluginHost::init] initialized with buffersize=%d, samplerate=%d\n",
 	buffersize, samplerate);
 }
@@ -169,6 +203,8 @@ void init(int buffersize_, int samplerate_)
 
 int scanDirs(const string& dirs, const std::function<void(float)>& cb)
 {
+	G_TRACE_SCOPE("pluginHost::scanDirs");
+
 	gu_log("[pluginHost::scanDir] requested directories: '%s'\n", dirs.c_str());
 	gu_log("[pluginHost::scanDir] current plugins: %d\n", knownPluginList.getNumTypes());
 
@@ -304,6 +340,12 @@ vector<Plugin*>* getStack(int stackType, Channel* ch)
 		case CHANNEL:
 			return &ch->plugins;
 		default:
+			if (stackType >= COLUMN_BUS) {
+				ColumnBus* bus = mh::getColumnBusById(stackType - COLUMN_BUS);
+				return bus != nullptr ? &bus->plugins : nullptr;
+			}
+			if (stackType >= SEND_BUS)
+				return &sendBuses[stackType - SEND_BUS];
 			return nullptr;
 	}
 }
@@ -312,6 +354,27 @@ vector<Plugin*>* getStack(int stackType, Channel* ch)
 /* -------------------------------------------------------------------------- */
 
 
+int getStackTail(int stackType, Channel* ch)
+{
+	vector<Plugin*>* pStack = getStack(stackType, ch);
+	if (pStack == nullptr)
+		return 0;
+
+	double tail = 0.0;
+	for (const Plugin* plugin : *pStack)
+		if (!plugin->isBypassed() && plugin->getTailLengthSeconds() > tail)
+			tail = plugin->getTailLengthSeconds();
+
+	double frames = std::ceil(tail * samplerate);
+	if (std::isinf(frames) || frames >= std::numeric_limits<int>::max())
+		return std::numeric_limits<int>::max();
+	return static_cast<int>(frames);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 unsigned countPlugins(int stackType, Channel* ch)
 {
 	vector<Plugin*>* pStack = getStack(stackType, ch);
@@ -398,16 +461,49 @@ void freeStack(int stackType, pthread_mutex_t* mutex, Channel* ch)
 /* -------------------------------------------------------------------------- */
 
 
+void applyParams(int stackType, Channel* ch)
+{
+	vector<Plugin*>* pStack = getStack(stackType, ch);
+	if (pStack == nullptr)
+		return;
+	for (Plugin* plugin : *pStack)
+		plugin->applyParams();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void processStack(AudioBuffer& outBuf, int stackType, Channel* ch)
 {
 	vector<Plugin*>* pStack = getStack(stackType, ch);
 
-	/* Empty stack, stack not found or mixer not ready: do nothing. */
+	/* Stack not found or mixer not ready: do nothing. */
+
+	if (pStack == nullptr)
+		return;
+	processStack(outBuf, *pStack, ch);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void processStack(AudioBuffer& outBuf, vector<Plugin*>& stack, Channel* ch)
+{
+	vector<Plugin*>* pStack = &stack;
 
-	if (pStack == nullptr || pStack->size() == 0)
+	if (pStack->size() == 0)
 		return;
 
-	assert(outBuf.countFrames() == audioBuffer.getNumSamples());
+	/* Parameter changes posted since the last block go first, bypassed plug-ins
+	included. */
+
+	for (Plugin* plugin : *pStack)
+		plugin->applyParams();
+
+	if (audioBuffer.getNumSamples() != outBuf.countFrames())
+		audioBuffer.setSize(G_MAX_IO_CHANS, outBuf.countFrames());
 
 	/* MIDI channels must not process the current buffer: give them an empty one. 
 	Sample channels and Master in/out want audio data instead: let's convert the 
@@ -421,22 +517,17 @@ void processStack(AudioBuffer& outBuf, int stackType, Channel* ch)
 				audioBuffer.setSample(j, i, outBuf[i][j]);
 
 	/* Hardcore processing. At the end we swap input and output, so that he N-th
-	plugin will process the result of the plugin N-1. Part of this loop must be
-	guarded by mutexes, i.e. the MIDI process part. You definitely don't want
-	a situation like the following one:
-		this::processStack()
-		[a new midi event comes in from kernelMidi thread]
-		channel::clearMidiBuffer()
-	The midi event in between would be surely lost, deleted by the last call to
-	channel::clearMidiBuffer()! */
+	plugin will process the result of the plugin N-1. No locking here: MIDI 
+	events coming from other threads wait in the channel's queue, and are moved
+	into the MIDI buffer by the audio thread at the beginning of the block (see 
+	Channel::prepareBuffers()). */
 
-	if (ch != nullptr)
-		pthread_mutex_lock(&mutex_midi);
-
-	for (const Plugin* plugin : *pStack) {
+	for (Plugin* plugin : *pStack) {
 		if (plugin->isSuspended() || plugin->isBypassed())
 			continue;
 
+		int64_t t = profiler::begin();
+
 		/* If this is a Channel (ch != nullptr) and the current plugin is an 
 		instrument (i.e. accepts MIDI), don't let it fill the current audio buffer: 
 		create a new temporary one instead and then merge the result into the main
@@ -445,20 +536,21 @@ void processStack(AudioBuffer& outBuf, int stackType, Channel* ch)
 		set of MIDI events. */
 
 		if (ch != nullptr && plugin->acceptsMidi()) {
-			juce::AudioBuffer<float> tmp(audioBuffer.getNumChannels(), buffersize);
+			juce::AudioBuffer<float> tmp(audioBuffer.getNumChannels(), audioBuffer.getNumSamples());
 			plugin->process(tmp, ch->getPluginMidiEvents());
 			for (int i=0; i<audioBuffer.getNumSamples(); i++)
 				for (int j=0; j<audioBuffer.getNumChannels(); j++)
 					audioBuffer.addSample(j, i, tmp.getSample(j, i));	
 		}
 		else
-			plugin->process(audioBuffer, juce::MidiBuffer()); // Empty MIDI buffer
+			processEffect(plugin);
+
+		profiler::end(profiler::PLUGIN, t, ch != nullptr ? ch->index : -1, 
+			plugin->getId(), stackType);
 	}
 
-	if (ch != nullptr) {
+	if (ch != nullptr)
 		ch->clearMidiBuffer();
-		pthread_mutex_unlock(&mutex_midi);
-	}
 
 	/* Converting buffer from Juce to Giada. A note for the future: if we 
 	overwrite (=) (as we do now) it's SEND, if we add (+) it's INSERT. */
@@ -556,6 +648,8 @@ void freeAllStacks(vector<Channel*>* channels, pthread_mutex_t* mutex)
 {
 	freeStack(pluginHost::MASTER_OUT, mutex);
 	freeStack(pluginHost::MASTER_IN, mutex);
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		freeStack(pluginHost::SEND_BUS + i, mutex);
 	for (unsigned i=0; i<channels->size(); i++)
 		freeStack(pluginHost::CHANNEL, mutex, channels->at(i));
 	missingPlugins = false;
@@ -575,6 +669,17 @@ int clonePlugin(Plugin* src, int stackType, pthread_mutex_t* mutex,
 		return 0;
 	}
 
+	/* The state chunk first: it carries what parameters can't (programs, 
+	loaded files...). Parameters are set again on top of it for those plug-ins
+	that don't store them there. */
+
+	juce::MemoryBlock state;
+	src->getState(state);
+	if (state.getSize() > 0)
+		p->setState(state);
+
+	p->setKeepAwake(src->isKeptAwake());
+	p->setBypass(src->isBypassed());
 	for (int k=0; k<src->getNumParameters(); k++)
 		p->setParameter(k, src->getParameter(k));
 
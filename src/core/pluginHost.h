@@ -35,6 +35,7 @@
 #include <pthread.h>
 #include "../deps/juce-config.h"
 #include "audioBuffer.h"
+#include "const.h"
 
 
 class Plugin;
@@ -45,11 +46,18 @@ namespace giada {
 namespace m {
 namespace pluginHost
 {
+/* stackType
+SEND_BUS is the first of G_MAX_SEND_BUSES consecutive values: the stack of send
+bus 'i' is SEND_BUS + i. Likewise, the stack of the column bus with id 'id' is 
+COLUMN_BUS + id. */
+
 enum stackType
 {
 	MASTER_OUT,
 	MASTER_IN,
-	CHANNEL
+	CHANNEL,
+	SEND_BUS,
+	COLUMN_BUS = SEND_BUS + G_MAX_SEND_BUSES
 };
 
 enum sortMethod
@@ -70,8 +78,6 @@ struct PluginInfo
 	bool isInstrument;
 };
 
-extern pthread_mutex_t mutex_midi;
-
 void init(int bufSize, int samplerate);
 void close();
 
@@ -132,10 +138,31 @@ std::string getUnknownPluginInfo(int index);
 void freeStack(int stackType, pthread_mutex_t* mutex, Channel* ch=nullptr);
 
 /* processStack
-Applies the fx list to the buffer. */
+Applies the fx list to the buffer. Effects fed with silent input are put to 
+sleep once their tail has decayed, unless kept awake. */
 
 void processStack(AudioBuffer& outBuf, int stackType, Channel* ch=nullptr);
 
+/* processStack (2)
+Same as above, on a stack the caller already holds. Spares the stack lookup to
+objects that own their plug-ins, such as column buses. */
+
+void processStack(AudioBuffer& outBuf, std::vector<Plugin*>& stack, 
+	Channel* ch=nullptr);
+
+/* applyParams
+Applies the parameter changes queued by the GUI and MIDI threads to all 
+plug-ins in the stack. Already done by processStack(): call it for stacks that 
+are not processed in the current block. Audio thread only. */
+
+void applyParams(int stackType, Channel* ch=nullptr);
+
+/* getStackTail
+Returns the longest tail among the plug-ins in the stack, in frames. An infinite
+tail is reported as std::numeric_limits<int>::max(). */
+
+int getStackTail(int stackType, Channel* ch=nullptr);
+
 /* getStack
 * Return a std::vector <Plugin *> given the stackType. If stackType == CHANNEL
 * a pointer to Channel is also required. */
@@ -0,0 +1,343 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#include <atomic>
+#include <algorithm>
+#include <map>
+#include <thread>
+#include <tuple>
+#include "../utils/time.h"
+#include "const.h"
+#include "queue.h"
+#include "profiler.h"
+
+
+namespace giada {
+namespace m {
+namespace profiler
+{
+namespace
+{
+struct Event
+{
+	int     stage;
+	int     stack;
+	int     chan;
+	int     id;
+	int64_t ns;
+	int64_t period;  // CALLBACK only: buffer duration
+};
+
+using Key = std::tuple<int, int, int, int>;  // stage, stack, chan, id
+
+std::atomic<bool> enabled(false);
+
+/* audioThread
+Thread that ran the last callback. Events from other threads, e.g. offline 
+renderers processing channel copies, are ignored: the queue has a single 
+producer. */
+
+std::atomic<std::thread::id> audioThread;
+std::atomic<int>  xruns(0);
+std::atomic<int>  dropped(0);
+
+Queue<Event, G_PROFILER_QUEUE> queue;
+
+/* histograms, loadSum, loadMax, loadCount
+Collector side, touched by collect(), reset() and the getters only. */
+
+std::map<Key, Histogram> histograms;
+double   loadSum   = 0.0;
+double   loadMax   = 0.0;
+uint64_t loadCount = 0;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void push(const Event& e)
+{
+	if (!queue.push(e))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+Histogram::Histogram() : m_count(0), m_max(0)
+{
+	m_buckets.fill(0);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* toBucket
+Values below 16 have a bucket each. Above, the octave is given by the highest 
+bit set and the bucket within the octave by the next three bits. */
+
+int Histogram::toBucket(uint64_t v)
+{
+	if (v < 16)
+		return v;
+	int octave = 63 - __builtin_clzll(v);
+	return 16 + (octave - 4) * 8 + ((v >> (octave - 3)) & 7);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+uint64_t Histogram::upperBound(int bucket)
+{
+	if (bucket < 16)
+		return bucket;
+	int octave = 4 + (bucket - 16) / 8;
+	uint64_t lower = (uint64_t) (8 + (bucket - 16) % 8) << (octave - 3);
+	return lower + ((uint64_t) 1 << (octave - 3)) - 1;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Histogram::add(int64_t ns)
+{
+	if (ns < 0)
+		ns = 0;
+	m_buckets[toBucket(ns)]++;
+	m_count++;
+	m_max = std::max(m_max, ns);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int64_t Histogram::getPercentile(double p) const
+{
+	if (m_count == 0)
+		return 0;
+	uint64_t rank = std::max<uint64_t>(1, (uint64_t) (p * m_count + 0.999999));
+	uint64_t sum  = 0;
+	for (int i=0; i<BUCKETS; i++) {
+		sum += m_buckets[i];
+		if (sum >= rank)
+			return std::min<uint64_t>(upperBound(i), m_max);
+	}
+	return m_max;
+}
+
+
+int64_t  Histogram::getMax() const   { return m_max; }
+uint64_t Histogram::getCount() const { return m_count; }
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+Timer::Timer() 
+: m_enabled(isEnabled() && std::this_thread::get_id() == audioThread.load()),
+  m_last   (m_enabled ? u::time::now() : 0)
+{
+	m_acc.fill(-1);
+}
+
+
+Timer::~Timer()
+{
+	flush();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Timer::lap(int stage)
+{
+	if (!m_enabled)
+		return;
+	int64_t t = u::time::now();
+	m_acc[stage] = std::max<int64_t>(m_acc[stage], 0) + t - m_last;
+	m_last = t;
+}
+
+
+void Timer::skip()
+{
+	if (m_enabled)
+		m_last = u::time::now();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void Timer::flush()
+{
+	if (!m_enabled)
+		return;
+	for (int i=0; i<STAGES; i++)
+		if (m_acc[i] >= 0)
+			push({ i, -1, -1, -1, m_acc[i], 0 });
+	m_enabled = false;
+}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+void setEnabled(bool v) { enabled.store(v, std::memory_order_relaxed); }
+bool isEnabled()        { return enabled.load(std::memory_order_relaxed); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int64_t begin()
+{
+	if (!isEnabled() || std::this_thread::get_id() != audioThread.load())
+		return 0;
+	return u::time::now();
+}
+
+
+void end(int stage, int64_t begin, int chan, int id, int stack)
+{
+	if (begin != 0)
+		push({ stage, stack, chan, id, u::time::now() - begin, 0 });
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void endBlock(int64_t begin, int bufferSize, int samplerate, bool xrun)
+{
+	if (xrun)
+		xruns.fetch_add(1, std::memory_order_relaxed);
+	audioThread.store(std::this_thread::get_id());
+	if (!isEnabled())
+		return;
+	int64_t period = (int64_t) bufferSize * 1000000000LL / samplerate;
+	push({ CALLBACK, -1, -1, -1, u::time::now() - begin, period });
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void collect()
+{
+	Event e;
+	while (queue.pop(e)) {
+		histograms[Key(e.stage, e.stack, e.chan, e.id)].add(e.ns);
+		if (e.stage != CALLBACK || e.period <= 0)
+			continue;
+		double load = (double) e.ns / e.period;
+		loadSum += load;
+		loadMax  = std::max(loadMax, load);
+		loadCount++;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void reset()
+{
+	Event e;
+	while (queue.pop(e));
+	histograms.clear();
+	loadSum   = 0.0;
+	loadMax   = 0.0;
+	loadCount = 0;
+	xruns.store(0);
+	dropped.store(0);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+std::vector<Stats> getStats()
+{
+	std::vector<Stats> out;
+	for (const auto& kv : histograms) {
+		const Histogram& h = kv.second;
+		out.push_back({ std::get<0>(kv.first), std::get<1>(kv.first), 
+			std::get<2>(kv.first), std::get<3>(kv.first), h.getCount(), 
+			h.getPercentile(0.5), h.getPercentile(0.99), h.getMax() });
+	}
+	return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+float getLoadAvg()
+{
+	return loadCount == 0 ? 0.0f : loadSum / loadCount * 100.0;
+}
+
+
+float getLoadMax()  { return loadMax * 100.0; }
+int   getXruns()    { return xruns.load(std::memory_order_relaxed); }
+int   getDropped()  { return dropped.load(std::memory_order_relaxed); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+std::string getStageName(int stage)
+{
+	switch (stage) {
+		case CALLBACK:     return "Callback";
+		case LINE_IN:      return "Line in";
+		case ACTIONS:      return "Actions";
+		case QUANTIZE:     return "Quantizer";
+		case SUM_CHANNELS: return "Sum channels";
+		case RENDER:       return "Render";
+		case CHANNEL:      return "Channel";
+		case PLUGIN:       return "Plug-in";
+		case POST:         return "Post processing";
+		default:           return "";
+	}
+}
+}}}; // giada::m::profiler::
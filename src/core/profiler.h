@@ -0,0 +1,190 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef G_PROFILER_H
+#define G_PROFILER_H
+
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace giada {
+namespace m {
+namespace profiler
+{
+/* Stage
+Timed parts of the audio callback. CALLBACK is the whole block; CHANNEL and 
+PLUGIN are timed separately for each channel and plug-in. */
+
+enum Stage
+{
+	CALLBACK,
+	LINE_IN,
+	ACTIONS,
+	QUANTIZE,
+	SUM_CHANNELS,
+	RENDER,
+	CHANNEL,
+	PLUGIN,
+	POST,
+	STAGES
+};
+
+/* Histogram
+Distribution of durations in nanoseconds, on a log scale: exact below 16, then 
+8 buckets per power of two, i.e. percentiles are off by 12.5% at most. Constant
+size, no allocations on add(). */
+
+class Histogram
+{
+public:
+
+	Histogram();
+
+	void add(int64_t ns);
+	
+	/* getPercentile
+	Returns the value below which 'p' (0.0 - 1.0) of the samples fall, rounded 
+	up to the bucket boundary but never above the max. */
+
+	int64_t getPercentile(double p) const;
+	int64_t getMax() const;
+	uint64_t getCount() const;
+
+private:
+
+	static const int BUCKETS = 496;
+
+	static int toBucket(uint64_t v);
+	static uint64_t upperBound(int bucket);
+
+	std::array<uint32_t, BUCKETS> m_buckets;
+	uint64_t m_count;
+	int64_t  m_max;
+};
+
+/* Stats
+Summary of a stage. 'chan' is the channel index, 'id' the plug-in id and 
+'stack' the plug-in stack type, -1 when not applicable. */
+
+struct Stats
+{
+	int      stage;
+	int      stack;
+	int      chan;
+	int      id;
+	uint64_t count;
+	int64_t  p50;
+	int64_t  p99;
+	int64_t  max;
+};
+
+/* Timer
+Times the stages run once per frame in the callback loop, where an event per 
+frame would flood the queue. Durations are summed up and sent once by flush(). 
+Does nothing if the profiler is disabled when the Timer is created. */
+
+class Timer
+{
+public:
+
+	Timer();
+	~Timer();
+
+	/* lap
+	Adds the time passed since the last lap() or skip() to 'stage'. */
+
+	void lap(int stage);
+
+	/* skip
+	Discards the time passed since the last lap() or skip(). */
+
+	void skip();
+
+	void flush();
+
+private:
+
+	bool    m_enabled;
+	int64_t m_last;
+	std::array<int64_t, STAGES> m_acc;
+};
+
+/* setEnabled, isEnabled
+The profiler is off by default: begin() and Timer cost nothing but an atomic
+load in that case. */
+
+void setEnabled(bool v);
+bool isEnabled();
+
+/* begin, end
+Times a stage. begin() returns the start time, or 0 if disabled or not called 
+by the audio thread, i.e. the one calling endBlock(); end() sends an event to 
+the collector, unless 'begin' is 0. */
+
+int64_t begin();
+void end(int stage, int64_t begin, int chan=-1, int id=-1, int stack=-1);
+
+/* endBlock
+Closes the callback started at 'begin'. Xruns are counted even when the 
+profiler is disabled. Audio thread only. */
+
+void endBlock(int64_t begin, int bufferSize, int samplerate, bool xrun);
+
+/* collect
+Drains the pending events into the histograms. Call it periodically from a 
+non-realtime thread, as well as reset() and the getters: they are not 
+thread-safe among themselves. */
+
+void collect();
+void reset();
+
+std::vector<Stats> getStats();
+
+/* getLoadAvg, getLoadMax
+Callback duration over the buffer period, in percent, since the last reset. */
+
+float getLoadAvg();
+float getLoadMax();
+
+int getXruns();
+
+/* getDropped
+Events lost because the queue was full, i.e. collect() called too rarely. */
+
+int getDropped();
+
+std::string getStageName(int stage);
+}}}; // giada::m::profiler::
+
+
+#endif
@@ -0,0 +1,196 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_QUEUE_H
+#define G_QUEUE_H
+
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+
+namespace giada {
+namespace m 
+{
+/* Queue
+Bounded, lock-free FIFO for exactly one producer thread and one consumer 
+thread. Neither push() nor pop() allocate or block, so both are safe to call from
+the audio thread. One slot is kept empty to tell a full queue from an empty one:
+at most 'size - 1' items can be stored at once. */
+
+template<typename T, std::size_t size>
+class Queue
+{
+public:
+
+	Queue() : m_head(0), m_tail(0)
+	{
+		static_assert(size >= 2, "Queue size must be at least 2");
+	}
+
+	/* push
+	Producer only. Returns false if the queue is full: the item is dropped. */
+
+	bool push(const T& item)
+	{
+		std::size_t tail = m_tail.load(std::memory_order_relaxed);
+		std::size_t next = increment(tail);
+		if (next == m_head.load(std::memory_order_acquire))
+			return false;
+		m_data[tail] = item;
+		m_tail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	/* pop
+	Consumer only. Returns false if the queue is empty. */
+
+	bool pop(T& item)
+	{
+		std::size_t head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+		item = m_data[head];
+		m_head.store(increment(head), std::memory_order_release);
+		return true;
+	}
+
+	/* isEmpty
+	Approximate when called by the producer: the consumer might be popping in the
+	meantime. */
+
+	bool isEmpty() const
+	{
+		return m_head.load(std::memory_order_acquire) == 
+		       m_tail.load(std::memory_order_acquire);
+	}
+
+private:
+
+	std::size_t increment(std::size_t i) const
+	{
+		return (i + 1) % size;
+	}
+
+	/* m_head, m_tail
+	Read index (written by the consumer) and write index (written by the 
+	producer). The data array sits in between, so that they don't share a cache
+	line unless the queue is tiny. */
+
+	std::atomic<std::size_t> m_head;
+	std::array<T, size>      m_data;
+	std::atomic<std::size_t> m_tail;
+};
+
+
+/* -------------------------------------------------------------------------- */
+
+
+/* MpscQueue
+Bounded, lock-free FIFO for any number of producer threads and one consumer
+thread. Each slot carries a sequence number that tells whether it's free for 
+writing or ready for reading: producers claim a slot by advancing the write 
+index with a compare-and-swap, then publish it. 'size' must be a power of two.
+All 'size' slots are usable. */
+
+template<typename T, std::size_t size>
+class MpscQueue
+{
+public:
+
+	MpscQueue() : m_head(0), m_tail(0)
+	{
+		static_assert(size >= 2 && (size & (size - 1)) == 0, 
+			"MpscQueue size must be a power of two");
+		for (std::size_t i=0; i<size; i++)
+			m_cells[i].seq.store(i, std::memory_order_relaxed);
+	}
+
+	/* push
+	Any thread. Returns false if the queue is full: the item is dropped. */
+
+	bool push(const T& item)
+	{
+		Cell* cell;
+		std::size_t pos = m_tail.load(std::memory_order_relaxed);
+		while (true) {
+			cell = &m_cells[pos & (size - 1)];
+			std::size_t seq = cell->seq.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t) seq - (std::ptrdiff_t) pos;
+			if (diff == 0) {
+				if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					break;
+			}
+			else
+			if (diff < 0)
+				return false;
+			else
+				pos = m_tail.load(std::memory_order_relaxed);
+		}
+		cell->data = item;
+		cell->seq.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+
+	/* pop
+	Consumer only. Returns false if the queue is empty, or if the oldest item is
+	still being written by its producer. */
+
+	bool pop(T& item)
+	{
+		Cell& cell = m_cells[m_head & (size - 1)];
+		std::size_t seq = cell.seq.load(std::memory_order_acquire);
+		if ((std::ptrdiff_t) seq - (std::ptrdiff_t) (m_head + 1) < 0)
+			return false;
+		item = cell.data;
+		cell.seq.store(m_head + size, std::memory_order_release);
+		m_head++;
+		return true;
+	}
+
+private:
+
+	struct Cell
+	{
+		std::atomic<std::size_t> seq;
+		T data;
+	};
+
+	/* m_head, m_tail
+	Read index, touched by the consumer only, and write index, shared among 
+	producers. */
+
+	std::size_t              m_head;
+	std::array<Cell, size>   m_cells;
+	std::atomic<std::size_t> m_tail;
+};
+}} // giada::m::
+
+
+#endif
@@ -0,0 +1,286 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#if defined(__linux__) || defined(__APPLE__)
+	#include <pthread.h>
+	#include <sched.h>
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+#if defined(__SSE__) || defined(_M_X64)
+	#include <xmmintrin.h>
+#endif
+#include "../utils/log.h"
+#include "const.h"
+#include "conf.h"
+#include "audioBuffer.h"
+#include "wave.h"
+#include "realtime.h"
+
+
+namespace giada {
+namespace m {
+namespace realtime
+{
+namespace
+{
+/* Results of each setting: OFF if not requested, GRANTED, or the errno that 
+made it fail. Written by the audio thread before 'applied', read by report() 
+after it. */
+
+const int OFF     = -1;
+const int GRANTED = 0;
+
+std::atomic<unsigned> epoch(0);    // bumped by prepare()
+std::atomic<unsigned> applied(0);  // last epoch picked up by the audio thread
+std::atomic<int> priorityResult(OFF);
+std::atomic<int> cpuResult(OFF);
+std::atomic<int> denormalsResult(OFF);
+int memoryResult = OFF;
+
+thread_local unsigned threadEpoch = 0;
+thread_local bool     audioThread = false;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int setPriority()
+{
+	if (conf::rtPriority == 0)
+		return OFF;
+#if defined(__linux__) || defined(__APPLE__)
+
+	/* JACK might have given the thread a higher priority already: keep it. */
+
+	int         policy;
+	sched_param param;
+	pthread_getschedparam(pthread_self(), &policy, &param);
+	if ((policy == SCHED_FIFO || policy == SCHED_RR) && 
+	    param.sched_priority >= conf::rtPriority)
+		return GRANTED;
+
+	param.sched_priority = std::min(conf::rtPriority, sched_get_priority_max(SCHED_FIFO));
+	return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+#else
+	return ENOTSUP;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int setAffinity()
+{
+	if (conf::rtCpuMask == 0)
+		return OFF;
+#if defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (unsigned i=0; i<32; i++)
+		if (static_cast<unsigned>(conf::rtCpuMask) & (1u << i))
+			CPU_SET(i, &set);
+	return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+	return ENOTSUP;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int setDenormals()
+{
+	if (!conf::rtFlushDenormals)
+		return OFF;
+#if defined(__SSE__) || defined(_M_X64)
+	_mm_setcsr(_mm_getcsr() | 0x8040);  // FTZ (bit 15) | DAZ (bit 6)
+	return GRANTED;
+#elif defined(__aarch64__)
+	uint64_t fpcr;
+	__asm__ __volatile__("mrs %0, fpcr" : "=r"(fpcr));
+	__asm__ __volatile__("msr fpcr, %0" : : "r"(fpcr | (1 << 24)));  // FZ
+	return GRANTED;
+#else
+	return ENOTSUP;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int lockMemory()
+{
+	if (!conf::rtLockMemory)
+		return OFF;
+#if defined(__linux__) || defined(__APPLE__)
+
+	/* MCL_FUTURE also locks buffers allocated later on, e.g. samples loaded 
+	while the stream is running. */
+
+	return mlockall(MCL_CURRENT | MCL_FUTURE) == 0 ? GRANTED : errno;
+#else
+	return ENOTSUP;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+const char* describe(int result)
+{
+	if (result == OFF)
+		return "off";
+	if (result == GRANTED)
+		return "granted";
+	return strerror(result);
+}
+}; // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+void prepare()
+{
+	memoryResult = lockMemory();
+	epoch.fetch_add(1);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void enterAudioThread()
+{
+	audioThread = true;
+
+	unsigned e = epoch.load(std::memory_order_acquire);
+	if (threadEpoch == e)
+		return;
+	threadEpoch = e;
+	priorityResult.store(setPriority(), std::memory_order_relaxed);
+	cpuResult.store(setAffinity(), std::memory_order_relaxed);
+	denormalsResult.store(setDenormals(), std::memory_order_relaxed);
+	applied.store(e, std::memory_order_release);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void flushDenormals()
+{
+	setDenormals();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool isAudioThread()
+{
+	return audioThread;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void report()
+{
+	unsigned e = epoch.load();
+	for (int i=0; i<G_RT_REPORT_TIMEOUT && applied.load(std::memory_order_acquire) != e; i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	gu_log("[realtime] memory lock: %s\n", describe(memoryResult));
+	if (applied.load(std::memory_order_acquire) != e) {
+		gu_log("[realtime] no callback within %d ms, audio thread not configured\n", 
+			G_RT_REPORT_TIMEOUT);
+		return;
+	}
+	gu_log("[realtime] priority %d: %s\n", conf::rtPriority, describe(priorityResult.load()));
+	gu_log("[realtime] cpu mask 0x%x: %s\n", conf::rtCpuMask, describe(cpuResult.load()));
+	gu_log("[realtime] flush denormals: %s\n", describe(denormalsResult.load()));
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void prefault(void* data, size_t bytes)
+{
+#if defined(__linux__) || defined(__APPLE__)
+	static const size_t page = sysconf(_SC_PAGESIZE);
+#else
+	static const size_t page = 4096;
+#endif
+
+	/* Write back what's read: a read alone might map the shared zero page, 
+	which would be replaced on the first write. */
+
+	volatile char* p = static_cast<volatile char*>(data);
+	for (size_t i=0; i<bytes; i+=page)
+		p[i] = p[i];
+	if (bytes > 0)
+		p[bytes - 1] = p[bytes - 1];
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void prefault(const AudioBuffer& b)
+{
+	if (b.isAllocd())
+		prefault(b[0], b.countSamples() * sizeof(float));
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void prefault(const Wave* w)
+{
+	if (w != nullptr && w->getSize() > 0)
+		prefault(w->getFrame(0), w->getSize() * w->getChannels() * sizeof(float));
+}
+}}}; // giada::m::realtime::
@@ -0,0 +1,96 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_REALTIME_H
+#define G_REALTIME_H
+
+
+#include <cstddef>
+
+
+class Wave;
+
+
+namespace giada {
+namespace m {
+
+class AudioBuffer;
+
+namespace realtime
+{
+/* [realtime setup]
+Configures the audio thread as set in conf: SCHED_FIFO priority (rtPriority),
+CPU affinity (rtCpuMask), flush-to-zero/denormals-are-zero (rtFlushDenormals) and 
+process memory locking (rtLockMemory). The stream thread belongs to RtAudio, 
+JACK or the null device, so it configures itself on its first callback after 
+each prepare(). Settings the system refuses are reported, never fatal. */
+
+/* prepare
+Locks memory, if enabled, and asks the audio thread to configure itself again.
+Call it right before starting the stream. */
+
+void prepare();
+
+/* enterAudioThread
+Applies the settings to the calling thread, the first time it's called after
+prepare(). Does nothing the other times: call it at the top of each callback. */
+
+void enterAudioThread();
+
+/* flushDenormals
+Sets flush-to-zero/denormals-are-zero on the calling thread, if enabled in 
+conf. For the threads other than the audio one that drive the engine: offline
+render, freeze, stem workers, benchmarks. They must run the same arithmetic as
+the audio thread, at the same speed. The setting lasts as long as the thread. */
+
+void flushDenormals();
+
+/* isAudioThread
+True if the calling thread has entered the audio callback, see 
+enterAudioThread(). */
+
+bool isAudioThread();
+
+/* report
+Waits for the audio thread to configure itself (G_RT_REPORT_TIMEOUT ms at 
+most), then logs which settings were granted. */
+
+void report();
+
+/* prefault
+Touches every page of 'bytes' bytes starting at 'data', so that the audio 
+thread doesn't take a page fault on first access. The caller must make sure
+no other thread writes to that memory meanwhile. */
+
+void prefault(void* data, size_t bytes);
+void prefault(const AudioBuffer& b);
+void prefault(const Wave* w);
+}}}; // giada::m::realtime::
+
+
+#endif
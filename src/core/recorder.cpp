@@ -27,6 +27,8 @@
 
 #include <cassert>
 #include <cmath>
+#include <numeric>
+#include <algorithm>
 #include "../utils/log.h"
 #include "const.h"
 #include "sampleChannel.h"
@@ -346,12 +348,28 @@ void sortActions()
 {
 	if (sortedActions)
 		return;
-	for (unsigned i=0; i<frames.size(); i++)
-		for (unsigned j=0; j<frames.size(); j++)
-			if (frames.at(j) > frames.at(i)) {
-				std::swap(frames.at(j), frames.at(i));
-				std::swap(global.at(j), global.at(i));
-			}
+
+	/* Sort the indexes, then move frames and actions in place following the
+	cycles of the permutation: 'order[i]' is where the i-th element comes from.
+	Frames are unique, no need for a stable sort. */
+
+	vector<size_t> order(frames.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::sort(order.begin(), order.end(), [] (size_t a, size_t b) { 
+		return frames.at(a) < frames.at(b); 
+	});
+
+	for (size_t i=0; i<order.size(); i++) {
+		size_t curr = i;
+		while (order.at(curr) != i) {
+			size_t next = order.at(curr);
+			std::swap(frames.at(curr), frames.at(next));
+			std::swap(global.at(curr), global.at(next));
+			order.at(curr) = curr;
+			curr = next;
+		}
+		order.at(curr) = curr;
+	}
 	sortedActions = true;
 	//print();
 }
@@ -516,8 +534,7 @@ int getNextAction(int chan, char type, int fromFrame, action** out,
 	/* Increase 'i' until it reaches 'fromFrame'. That's the point where to start
 	to look for the next action. */
 
-	unsigned i = 0;
-	while (i < frames.size() && frames.at(i) <= fromFrame) i++;
+	unsigned i = std::upper_bound(frames.begin(), frames.end(), fromFrame) - frames.begin();
 
 	/* No other actions past 'fromFrame': there are no more actions to look for.
 	Return -1. */
@@ -667,4 +684,39 @@ void forEachAction(std::function<void(const action*)> f)
 		for (const action* action : actions)
 			f(action);
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+vector<action> getActions(int chan, pthread_mutex_t* mixerMutex)
+{
+	vector<action> out;
+	pthread_mutex_lock(mixerMutex);
+	for (const vector<action*>& actions : global)
+		for (const action* a : actions)
+			if (a->chan == chan)
+				out.push_back(*a);
+	pthread_mutex_unlock(mixerMutex);
+
+	std::stable_sort(out.begin(), out.end(), 
+		[](const action& a, const action& b) { return a.frame < b.frame; });
+	return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void forEachAction(int chan, int frameA, int frameB, 
+	std::function<void(const action*)> f)
+{
+	sortActions();  // mandatory
+
+	unsigned i = std::lower_bound(frames.begin(), frames.end(), frameA) - frames.begin();
+	for (; i<frames.size() && frames.at(i) < frameB; i++)
+		for (const action* a : global.at(i))
+			if (a->chan == chan)
+				f(a);
+}
 }}}; // giada::m::recorder::
@@ -181,10 +181,24 @@ pressing Mute button on a channel with some existing mute actions. */
 void startOverdub(int chan, char action, int frame, unsigned bufferSize);
 void stopOverdub(int currentFrame, int totalFrames, pthread_mutex_t *mixerMutex);
 
+/* getActions
+Returns a copy of the actions recorded for channel 'chan', sorted by frame. The
+copy stays valid whatever happens to the recorder later on. */
+
+std::vector<action> getActions(int chan, pthread_mutex_t* mixerMutex);
+
 /* forEachAction
 Applies a read-only callback on each action recorded. */
 
 void forEachAction(std::function<void(const action*)> f);
+
+/* forEachAction (range)
+Applies a read-only callback on each action of channel 'chan' in the range of
+frames [frameA, frameB). Actions get sorted first: the range is then found with
+a binary search, so the cost depends on the range, not on the whole session. */
+
+void forEachAction(int chan, int frameA, int frameB, 
+	std::function<void(const action*)> f);
 }}}; // giada::m::recorder::
 
 #endif
@@ -0,0 +1,536 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#include <algorithm>
+#include <cctype>
+#include <vector>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <sndfile.h>
+#include "../utils/log.h"
+#include "../utils/fs.h"
+#include "const.h"
+#include "conf.h"
+#include "patch.h"
+#include "clock.h"
+#include "mixer.h"
+#include "mixerHandler.h"
+#include "kernelAudio.h"
+#include "realtime.h"
+#include "recorder.h"
+#include "channel.h"
+#include "sampleChannel.h"
+#include "midiChannel.h"
+#include "audioBuffer.h"
+#include "columnBus.h"
+#include "renderer.h"
+
+
+using std::string;
+using std::vector;
+
+
+namespace giada {
+namespace m {
+namespace renderer
+{
+namespace
+{
+/* openFile
+Opens the output file, format chosen by extension: FLAC or WAV. */
+
+SNDFILE* openFile(const string& path)
+{
+	string ext = gu_getExt(path);
+
+	SF_INFO header;
+	header.samplerate = conf::samplerate;
+	header.channels   = G_MAX_IO_CHANS;
+	header.format     = ext == "flac" || ext == "FLAC" ? 
+		SF_FORMAT_FLAC | SF_FORMAT_PCM_24 : SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+	SNDFILE* file = sf_open(path.c_str(), SFM_WRITE, &header);
+	if (file == nullptr)
+		gu_log("[renderer::render] unable to open %s: %s\n", path.c_str(), 
+			sf_strerror(file));
+	return file;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void startLoopChannels()
+{
+	for (Channel* ch : mixer::channels) {
+		if (ch->type != G_CHANNEL_SAMPLE)
+			continue;
+		SampleChannel* sch = static_cast<SampleChannel*>(ch);
+		if (sch->wave != nullptr && sch->mode & LOOP_ANY)
+			sch->start(0, false, 0, true, false, false);  // plays on frame 0, see Channel::onZero()
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* Block
+A chunk of interleaved audio rendered by a stem worker, on its way to the 
+writer thread. */
+
+struct Block
+{
+	int           stem;
+	vector<float> data;
+};
+
+
+/* BlockQueue
+Bounded queue between stem workers and the writer thread. Workers wait when it
+is full, so memory stays constant no matter how long the render is. Not used
+by the audio thread: a mutex is fine here. */
+
+class BlockQueue
+{
+public:
+
+	void push(Block&& b)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_notFull.wait(lock, [this] { return m_blocks.size() < G_STEMS_QUEUE; });
+		m_blocks.push_back(std::move(b));
+		m_notEmpty.notify_one();
+	}
+
+	/* pop
+	Returns false when the queue is empty and closed. */
+
+	bool pop(Block& b)
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_notEmpty.wait(lock, [this] { return !m_blocks.empty() || m_closed; });
+		if (m_blocks.empty())
+			return false;
+		b = std::move(m_blocks.front());
+		m_blocks.pop_front();
+		m_notFull.notify_one();
+		return true;
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_closed = true;
+		m_notEmpty.notify_all();
+	}
+
+private:
+
+	std::mutex              m_mutex;
+	std::condition_variable m_notFull;
+	std::condition_variable m_notEmpty;
+	std::deque<Block>       m_blocks;
+	bool                    m_closed = false;
+};
+
+
+/* -------------------------------------------------------------------------- */
+
+/* hasAudio
+True if channel 'ch' can make any sound on its own: sample channels need a 
+Wave, MIDI channels a plug-in. */
+
+bool hasAudio(const Channel* ch)
+{
+	if (ch->type == G_CHANNEL_SAMPLE)
+		return static_cast<const SampleChannel*>(ch)->wave != nullptr;
+#ifdef WITH_VST
+	return !ch->plugins.empty();
+#else
+	return false;
+#endif
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* getStemPath
+Returns the output file for channel 'ch': its index and name, with anything 
+that would upset a file system replaced. */
+
+string getStemPath(const string& dir, const Channel* ch)
+{
+	string name = ch->name;
+	for (char& c : name)
+		if (!isalnum((unsigned char) c) && c != '-' && c != '_' && c != '.')
+			c = '_';
+	return dir + G_SLASH + std::to_string(ch->index) + (name.empty() ? "" : "-" + name) + ".wav";
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+int loadPatch(const string& path)
+{
+	string file     = path;
+	string basePath = "";
+	if (gu_isProject(path)) {
+		file     = path + G_SLASH + gu_stripExt(gu_basename(path)) + ".gptc";
+		basePath = path + G_SLASH;
+	}
+
+	if (patch::read(file) != PATCH_READ_OK) {
+		gu_log("[renderer::loadPatch] unable to read %s\n", file.c_str());
+		return G_RES_ERR_IO;
+	}
+
+	for (unsigned i=0; i<patch::columns.size(); i++) {
+		const patch::column_t& col = patch::columns.at(i);
+
+		ColumnBus* bus = nullptr;
+		if (col.bus) {
+			bus = mh::addColumnBus();
+			if (bus != nullptr)
+				mh::readPatchColumnBus(bus, i);
+		}
+
+		for (unsigned k=0; k<patch::channels.size(); k++) {
+			const patch::channel_t& pch = patch::channels.at(k);
+			if (pch.column != col.index)
+				continue;
+			Channel* ch = mh::addChannel(pch.type);
+			if (ch == nullptr)
+				return G_RES_ERR_MEMORY;
+			ch->column = col.index;
+			ch->readPatch(basePath, k);
+			if (bus != nullptr)
+				mh::setColumnBus(ch, bus);
+		}
+	}
+
+	mh::updateSoloCount();
+	mh::readPatch();
+	recorder::updateSamplerate(conf::samplerate, patch::samplerate);
+
+	gu_log("[renderer::loadPatch] %s loaded, %d channels\n", path.c_str(), 
+		mixer::channels.size());
+	return G_RES_OK;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int render(const string& path, int frameA, int frameB, bool startLoops)
+{
+	realtime::flushDenormals();
+
+	int bufSize = kernelAudio::getRealBufSize();
+	if (bufSize <= 0 || frameA < 0 || frameB <= frameA)
+		return G_RES_ERR_WRONG_DATA;
+
+	SNDFILE* file = openFile(path);
+	if (file == nullptr)
+		return G_RES_ERR_IO;
+
+	/* Interleaved buffers, as a sound card would provide. The input one stays
+	silent. */
+
+	vector<float> out(bufSize * G_MAX_IO_CHANS);
+	vector<float> in (bufSize * G_MAX_IO_CHANS, 0.0f);
+
+	mixer::rewind();
+	clock::rewind();
+	clock::start();
+	if (startLoops)
+		startLoopChannels();
+
+	int res = G_RES_OK;
+	for (int frame=0; frame<frameB; frame+=bufSize) {
+		mixer::masterPlay(out.data(), in.data(), bufSize, 0.0, 0, nullptr);
+
+		int a = std::max(frameA, frame) - frame;
+		int b = std::min(frameB, frame + bufSize) - frame;
+		if (a >= b)
+			continue;
+		if (sf_writef_float(file, out.data() + a * G_MAX_IO_CHANS, b - a) != b - a) {
+			gu_log("[renderer::render] write error: %s\n", sf_strerror(file));
+			res = G_RES_ERR_IO;
+			break;
+		}
+	}
+
+	clock::stop();
+	sf_close(file);
+
+	gu_log("[renderer::render] frames %d-%d rendered to %s\n", frameA, frameB, 
+		path.c_str());
+	return res;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+struct StemJob
+{
+	string             dir;
+	int                frames;
+	mh::RenderContext  ctx;
+	vector<Channel*>   copies;  // made and freed on the main thread
+	vector<SNDFILE*>   files;
+	std::atomic<bool>  cancel;
+
+	/* actions
+	Snapshot of the actions of each copy, taken with the copy. */
+
+	vector<vector<recorder::action>> actions;
+};
+
+
+/* -------------------------------------------------------------------------- */
+
+
+namespace
+{
+/* bgJob, bgThread, bgRes
+The export started by startStems(), if any. Main thread only. */
+
+StemJob*    bgJob = nullptr;
+std::thread bgThread;
+int         bgRes = G_RES_OK;
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int prepareStems(const string& dir, int loops, StemJob** out)
+{
+	mh::RenderContext ctx = mh::getRenderContext();
+	int period = ctx.lastFrame + 1;
+	if (ctx.bufSize <= 0 || loops <= 0)
+		return G_RES_ERR_WRONG_DATA;
+
+	if (!gu_dirExists(dir) && !gu_mkdir(dir)) {
+		gu_log("[renderer::prepareStems] unable to create %s\n", dir.c_str());
+		return G_RES_ERR_IO;
+	}
+
+	StemJob* job = new StemJob;
+	job->dir    = dir;
+	job->frames = loops * period;
+	job->ctx    = ctx;
+	job->cancel = false;
+
+	/* Files are opened up front, so that errors show up before any work is 
+	done. Copies take buffers from the pool and clone plug-ins, none of which 
+	can be done by several threads at once. */
+
+	for (const Channel* ch : mixer::channels) {
+		if (!hasAudio(ch))
+			continue;
+		SNDFILE* file = openFile(getStemPath(dir, ch));
+		if (file == nullptr) {
+			finishStems(job);
+			return G_RES_ERR_IO;
+		}
+		job->files.push_back(file);
+		Channel* copy = mh::cloneForRender(ch, false);
+		if (copy == nullptr) {
+			gu_log("[renderer::prepareStems] unable to copy channel %d\n", ch->index);
+			finishStems(job);
+			return G_RES_ERR_MEMORY;
+		}
+		job->copies.push_back(copy);
+		job->actions.push_back(recorder::getActions(ch->index, &mixer::mutex_recs));
+	}
+
+	*out = job;
+	return G_RES_OK;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int runStems(StemJob* job)
+{
+	int              frames = job->frames;
+	BlockQueue       queue;
+	std::atomic<int> next(0);
+	std::atomic<int> res(G_RES_OK);
+
+	/* Writer thread: streams blocks to their files in the order they come. 
+	Blocks of the same stem are pushed by a single worker, so they are never 
+	out of order. */
+
+	std::thread writer([&]
+	{
+		Block b;
+		while (queue.pop(b)) {
+			sf_count_t count = b.data.size() / G_MAX_IO_CHANS;
+			if (sf_writef_float(job->files[b.stem], b.data.data(), count) != count) {
+				gu_log("[renderer::runStems] write error: %s\n", 
+					sf_strerror(job->files[b.stem]));
+				res.store(G_RES_ERR_IO);
+			}
+		}
+	});
+
+	/* Workers: each one takes the next copy to render. Copies are independent 
+	from each other, each with its own sequencer position, see 
+	mh::renderChannel(). */
+
+	auto work = [&]
+	{
+		realtime::flushDenormals();
+		for (int i=next++; i<(int) job->copies.size() && res.load() == G_RES_OK; i=next++) {
+			int r = mh::renderChannel(job->copies[i], job->actions[i], job->ctx, 
+				frames, [&](const AudioBuffer& buf, int rendered, const vector<int>&)
+			{
+				if (job->cancel.load())
+					return false;
+				int count = std::min(buf.countFrames(), frames - rendered);
+				queue.push({i, vector<float>(buf[0], buf[0] + count * G_MAX_IO_CHANS)});
+				return true;
+			});
+			if (job->cancel.load()) {
+				res.store(G_RES_ERR);
+				break;
+			}
+			if (r != G_RES_OK) {
+				gu_log("[renderer::runStems] unable to render channel %d\n", 
+					job->copies[i]->index);
+				res.store(r);
+			}
+		}
+	};
+
+	unsigned numWorkers = std::max(1u, std::min<unsigned>(
+		std::thread::hardware_concurrency(), job->copies.size()));
+	vector<std::thread> workers;
+	for (unsigned i=0; i<numWorkers; i++)
+		workers.emplace_back(work);
+	for (std::thread& t : workers)
+		t.join();
+
+	queue.close();
+	writer.join();
+
+	gu_log("[renderer::runStems] %d stems, %d frames rendered to %s with %u threads\n", 
+		(int) job->copies.size(), frames, job->dir.c_str(), numWorkers);
+	return res.load();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void finishStems(StemJob* job)
+{
+	for (Channel* c : job->copies)
+		mh::freeRenderCopy(c);
+	for (SNDFILE* f : job->files)
+		sf_close(f);
+	delete job;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int renderStems(const string& dir, int loops)
+{
+	StemJob* job = nullptr;
+	int res = prepareStems(dir, loops, &job);
+	if (res != G_RES_OK)
+		return res;
+	res = runStems(job);
+	finishStems(job);
+	return res;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int startStems(const string& dir, int loops, std::function<void(int)> done)
+{
+	if (bgJob != nullptr)
+		return G_RES_ERR;
+	StemJob* job = nullptr;
+	int res = prepareStems(dir, loops, &job);
+	if (res != G_RES_OK)
+		return res;
+	bgJob    = job;
+	bgRes    = G_RES_OK;
+	bgThread = std::thread([job, done]
+	{
+		int r = runStems(job);
+		bgRes = r;  // read by waitStems() after join()
+		done(r);
+	});
+	return G_RES_OK;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool isExportingStems()
+{
+	return bgJob != nullptr;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int waitStems(bool cancel)
+{
+	if (bgJob == nullptr)
+		return G_RES_OK;
+	if (cancel)
+		bgJob->cancel.store(true);
+	bgThread.join();
+	finishStems(bgJob);
+	bgJob = nullptr;
+	if (cancel)
+		gu_log("[renderer::waitStems] stem export cancelled\n");
+	return bgRes;
+}
+}}}; // giada::m::renderer::
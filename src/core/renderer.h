@@ -0,0 +1,117 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef G_RENDERER_H
+#define G_RENDERER_H
+
+
+#include <string>
+#include <functional>
+
+
+namespace giada {
+namespace m {
+namespace renderer
+{
+/* loadPatch
+Loads a patch, or a project if 'path' is a project folder, into the engine. 
+Headless counterpart of glue_loadPatch(): columns exist only as channel 
+routing, there are no widgets. Returns G_RES_OK on success. */
+
+int loadPatch(const std::string& path);
+
+/* render
+Drives mixer::masterPlay() in a tight loop, as fast as the CPU allows, from the
+beginning of the sequencer. Frames in [frameA, frameB) are written to 'path', 
+a WAV (32 bit float) or FLAC (24 bit) file depending on its extension; the 
+ones before frameA are rendered and thrown away, so that the state at frameA 
+is the same as when playing live. If 'startLoops', loop channels are started 
+on the first frame, as if their keys were pressed. Requires the engine to be 
+set up with init_prepareKernelAudio(true). Returns G_RES_OK on success. */
+
+int render(const std::string& path, int frameA, int frameB, bool startLoops);
+
+/* StemJob
+A stem export, see renderStems(). Opaque. */
+
+struct StemJob;
+
+/* prepareStems
+Opens a WAV file in 'dir' for each channel that can make sound and makes a 
+private copy of it, to be rendered for 'loops' loops. Main thread only. Returns
+G_RES_OK on success and the job in 'out'. */
+
+int prepareStems(const std::string& dir, int loops, StemJob** out);
+
+/* runStems
+Renders a job made by prepareStems(), recorded actions, volume, panning and 
+plug-ins included. Loop channels are started on the first frame. Channels 
+render in parallel on worker threads while a writer thread streams the results
+to disk. Doesn't touch mixer::masterPlay(): it is safe to call while the audio
+device is running, from any thread. Returns G_RES_OK on success. */
+
+int runStems(StemJob* job);
+
+/* finishStems
+Closes the files and frees the job. Main thread only. */
+
+void finishStems(StemJob* job);
+
+/* renderStems
+Renders 'loops' loops of each channel that can make sound to its own file in 
+'dir': prepareStems(), runStems() and finishStems() in a row. Returns G_RES_OK
+on success. */
+
+int renderStems(const std::string& dir, int loops);
+
+/* startStems
+Same as renderStems(), with runStems() on a background thread so that the 
+caller is not blocked. 'done' is called on that thread with the result when 
+the render is over; the job is released by waitStems(). Only one export at a
+time. Main thread only. Returns G_RES_OK if the export has started. */
+
+int startStems(const std::string& dir, int loops, std::function<void(int)> done);
+
+/* isExportingStems
+True from startStems() until the matching waitStems(). Main thread only. */
+
+bool isExportingStems();
+
+/* waitStems
+Joins the export started by startStems(), if any, and releases it. If 
+'cancel', workers stop at the next block and the files are left incomplete. 
+Must be called before anything that tears down the engine (shutdown, reset, 
+patch loading). Main thread only. Returns the result of the export, G_RES_OK 
+if there was none. */
+
+int waitStems(bool cancel);
+}}}; // giada::m::renderer::
+
+
+#endif
@@ -0,0 +1,486 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifdef WITH_RT_AUDIT
+
+
+/* Fortified stdio and unistd functions are inlined wrappers: they can't be 
+redefined below. */
+
+#undef _FORTIFY_SOURCE
+
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <atomic>
+#include <map>
+#include <new>
+#include <tuple>
+#include <vector>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#include "../utils/log.h"
+#include "const.h"
+#include "queue.h"
+#include "rtAudit.h"
+
+
+#ifndef __GLIBC__
+	#error "The realtime audit mode requires glibc"
+#endif
+
+
+extern "C"
+{
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t n, size_t size);
+void* __libc_realloc(void* p, size_t size);
+void* __libc_memalign(size_t align, size_t size);
+void  __libc_free(void* p);
+}
+
+
+namespace giada {
+namespace m {
+namespace rtAudit
+{
+namespace
+{
+struct Record
+{
+	int   type;
+	int   depth;
+	void* frames[G_RT_AUDIT_FRAMES];
+};
+
+/* realtime, busy
+Whether the current thread is marked as realtime, and whether it is recording
+a violation already: backtrace() might end up in an intercepted function. */
+
+thread_local bool realtime = false;
+thread_local bool busy     = false;
+
+Queue<Record, G_RT_AUDIT_QUEUE> queue;
+std::atomic<int> dropped(0);
+
+/* allowed
+Mutexes registered with allow(). Written before the audio stream starts, read
+by the lock interceptor. */
+
+std::atomic<pthread_mutex_t*> allowed[G_RT_AUDIT_ALLOWED];
+std::atomic<int> numAllowed(0);
+
+/* knownLocks
+How many times known mutexes have been locked. Only the first ones are traced:
+they hit the same few sites on every block and would fill the queue, leaving 
+no room for new violations. */
+
+std::atomic<int> knownLocks(0);
+
+/* real*
+Next definition of the intercepted functions, i.e. the libc ones. */
+
+using LockFn      = int     (*)(pthread_mutex_t*);
+using ReadFn      = ssize_t (*)(int, void*, size_t);
+using WriteFn     = ssize_t (*)(int, const void*, size_t);
+using FopenFn     = FILE*   (*)(const char*, const char*);
+using FwriteFn    = size_t  (*)(const void*, size_t, size_t, FILE*);
+using FflushFn    = int     (*)(FILE*);
+using VfprintfFn  = int     (*)(FILE*, const char*, va_list);
+using UsleepFn    = int     (*)(useconds_t);
+using NanosleepFn = int     (*)(const struct timespec*, struct timespec*);
+
+LockFn      realLock      = nullptr;
+ReadFn      realRead      = nullptr;
+WriteFn     realWrite     = nullptr;
+FopenFn     realFopen     = nullptr;
+FwriteFn    realFwrite    = nullptr;
+FflushFn    realFflush    = nullptr;
+VfprintfFn  realVfprintf  = nullptr;
+UsleepFn    realUsleep    = nullptr;
+NanosleepFn realNanosleep = nullptr;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+template<typename F>
+F resolve(F& f, const char* name)
+{
+	if (f == nullptr)
+		f = reinterpret_cast<F>(dlsym(RTLD_NEXT, name));
+	return f;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+/* record
+Never inlined: the first two frames of each backtrace are this function and 
+the interceptor, skipped by report(). */
+
+__attribute__((noinline)) void record(int type)
+{
+	if (!realtime || busy)
+		return;
+	if (type == KNOWN_LOCK && 
+	    knownLocks.fetch_add(1, std::memory_order_relaxed) >= G_RT_AUDIT_KNOWN_TRACED)
+		return;
+	busy = true;
+	Record r;
+	r.type  = type;
+	r.depth = backtrace(r.frames, G_RT_AUDIT_FRAMES);
+	if (!queue.push(r))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	busy = false;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool isAllowed(const pthread_mutex_t* m)
+{
+	int n = numAllowed.load();
+	for (int i=0; i<n; i++)
+		if (allowed[i].load() == m)
+			return true;
+	return false;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+const char* getName(int type)
+{
+	switch (type) {
+		case ALLOC:      return "memory allocation";
+		case FREE:       return "memory release";
+		case OP_NEW:     return "operator new";
+		case OP_DELETE:  return "operator delete";
+		case LOCK:       return "mutex lock";
+		case IO:         return "blocking I/O";
+		case SLEEP:      return "sleep";
+		case KNOWN_LOCK: return "known engine mutex lock";
+		default:         return "";
+	}
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+void init()
+{
+	resolve(realLock,      "pthread_mutex_lock");
+	resolve(realRead,      "read");
+	resolve(realWrite,     "write");
+	resolve(realFopen,     "fopen");
+	resolve(realFwrite,    "fwrite");
+	resolve(realFflush,    "fflush");
+	resolve(realVfprintf,  "vfprintf");
+	resolve(realUsleep,    "usleep");
+	resolve(realNanosleep, "nanosleep");
+
+	void* frames[1];
+	backtrace(frames, 1);
+
+	gu_log("[rtAudit] realtime audit enabled\n");
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void allow(pthread_mutex_t* m)
+{
+	if (isAllowed(m))
+		return;
+	int i = numAllowed.load();
+	if (i == G_RT_AUDIT_ALLOWED) {
+		gu_log("[rtAudit] too many known mutexes, %p not registered\n", (void*) m);
+		return;
+	}
+	allowed[i].store(m);
+	numAllowed.store(i + 1);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void enter() { realtime = true; }
+void leave() { realtime = false; }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int report()
+{
+	/* Group by type and call site: the audio thread repeats the same mistakes 
+	on every block. Known engine locks are kept apart, see allow(). */
+
+	using Site = std::tuple<int, std::vector<void*>>;
+
+	std::map<Site, int> sites;
+	std::map<Site, int> knownSites;
+	int total = 0;
+	Record r;
+	while (queue.pop(r)) {
+		Site site(r.type, std::vector<void*>(r.frames, r.frames + r.depth));
+		if (r.type == KNOWN_LOCK)
+			knownSites[site]++;
+		else {
+			sites[site]++;
+			total++;
+		}
+	}
+	int known = knownLocks.exchange(0);
+
+	auto logSites = [](const std::map<Site, int>& m)
+	{
+		for (const auto& kv : m) {
+			const std::vector<void*>& frames = std::get<1>(kv.first);
+			gu_log("[rtAudit] %s, %d times:\n", getName(std::get<0>(kv.first)), kv.second);
+			char** symbols = backtrace_symbols(frames.data(), frames.size());
+			if (symbols == nullptr)
+				continue;
+			for (unsigned i=2; i<frames.size(); i++)
+				gu_log("[rtAudit]   %s\n", symbols[i]);
+			free(symbols);
+		}
+	};
+
+	gu_log("[rtAudit] %d violations in the audio thread, %d call sites, %d dropped\n",
+		total, (int) sites.size(), dropped.exchange(0));
+	logSites(sites);
+
+	if (known > 0) {
+		gu_log("[rtAudit] %d known engine mutex locks, not counted. Call sites of the "
+			"first %d:\n", known, G_RT_AUDIT_KNOWN_TRACED);
+		logSites(knownSites);
+	}
+	return total;
+}
+}}}; // giada::m::rtAudit::
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+/* Interceptors. Definitions in the executable take precedence over the libc 
+ones for every caller, shared libraries included. Allocation goes straight to 
+the glibc allocator: dlsym() itself may allocate. */
+
+using namespace giada::m::rtAudit;
+
+
+extern "C"
+{
+void* malloc(size_t size) __THROW
+{
+	record(ALLOC);
+	return __libc_malloc(size);
+}
+
+
+void* calloc(size_t n, size_t size) __THROW
+{
+	record(ALLOC);
+	return __libc_calloc(n, size);
+}
+
+
+void* realloc(void* p, size_t size) __THROW
+{
+	record(ALLOC);
+	return __libc_realloc(p, size);
+}
+
+
+void* memalign(size_t align, size_t size) __THROW
+{
+	record(ALLOC);
+	return __libc_memalign(align, size);
+}
+
+
+void* aligned_alloc(size_t align, size_t size) __THROW
+{
+	record(ALLOC);
+	return __libc_memalign(align, size);
+}
+
+
+int posix_memalign(void** p, size_t align, size_t size) __THROW
+{
+	record(ALLOC);
+	if (align == 0 || align % sizeof(void*) != 0 || (align & (align - 1)) != 0)
+		return EINVAL;
+	void* q = __libc_memalign(align, size);
+	if (q == nullptr)
+		return ENOMEM;
+	*p = q;
+	return 0;
+}
+
+
+void free(void* p) __THROW
+{
+	if (p != nullptr)
+		record(FREE);
+	__libc_free(p);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int pthread_mutex_lock(pthread_mutex_t* m) __THROWNL
+{
+	record(isAllowed(m) ? KNOWN_LOCK : LOCK);
+	return resolve(realLock, "pthread_mutex_lock")(m);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+ssize_t read(int fd, void* buf, size_t n)
+{
+	record(IO);
+	return resolve(realRead, "read")(fd, buf, n);
+}
+
+
+ssize_t write(int fd, const void* buf, size_t n)
+{
+	record(IO);
+	return resolve(realWrite, "write")(fd, buf, n);
+}
+
+
+FILE* fopen(const char* path, const char* mode)
+{
+	record(IO);
+	return resolve(realFopen, "fopen")(path, mode);
+}
+
+
+size_t fwrite(const void* p, size_t size, size_t n, FILE* f)
+{
+	record(IO);
+	return resolve(realFwrite, "fwrite")(p, size, n, f);
+}
+
+
+int fflush(FILE* f)
+{
+	record(IO);
+	return resolve(realFflush, "fflush")(f);
+}
+
+
+int vfprintf(FILE* f, const char* format, va_list args)
+{
+	record(IO);
+	return resolve(realVfprintf, "vfprintf")(f, format, args);
+}
+
+
+int vprintf(const char* format, va_list args)
+{
+	record(IO);
+	return resolve(realVfprintf, "vfprintf")(stdout, format, args);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int usleep(useconds_t usec)
+{
+	record(SLEEP);
+	return resolve(realUsleep, "usleep")(usec);
+}
+
+
+int nanosleep(const struct timespec* req, struct timespec* rem)
+{
+	record(SLEEP);
+	return resolve(realNanosleep, "nanosleep")(req, rem);
+}
+} // extern "C"
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void* operator new(std::size_t size)
+{
+	record(OP_NEW);
+	void* p = __libc_malloc(size != 0 ? size : 1);
+	if (p == nullptr)
+		throw std::bad_alloc();
+	return p;
+}
+
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+
+void operator delete(void* p) noexcept
+{
+	if (p != nullptr)
+		record(OP_DELETE);
+	__libc_free(p);
+}
+
+
+void operator delete[](void* p) noexcept
+{
+	operator delete(p);
+}
+
+
+#endif // #ifdef WITH_RT_AUDIT
@@ -0,0 +1,100 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef G_RT_AUDIT_H
+#define G_RT_AUDIT_H
+
+
+#include <pthread.h>
+
+
+namespace giada {
+namespace m {
+namespace rtAudit
+{
+/* [realtime audit]
+Debug mode, enabled by --enable-rt-audit (Linux only). Calls that might block 
+the audio thread are intercepted: memory allocation, mutex locking, file and 
+console I/O, sleeping. When made by a thread between enter() and leave(), each
+one is recorded with its backtrace and logged by report(). Without 
+WITH_RT_AUDIT all the functions below do nothing. */
+
+enum Violation
+{
+	ALLOC,
+	FREE,
+	OP_NEW,
+	OP_DELETE,
+	LOCK,
+	IO,
+	SLEEP,
+	KNOWN_LOCK  // a mutex registered with allow()
+};
+
+#ifdef WITH_RT_AUDIT
+
+/* init
+Resolves the intercepted functions and warms up the backtrace machinery, which 
+allocates on first use. Call it before the audio stream starts. */
+
+void init();
+
+/* enter, leave
+Marks the calling thread as realtime, or not anymore. */
+
+void enter();
+void leave();
+
+/* allow
+Registers 'm' as a known engine mutex. Locking it is recorded as KNOWN_LOCK: 
+reported apart and not counted by report(), so that only new violations fail
+a run. Up to G_RT_AUDIT_ALLOWED mutexes, registering one twice is harmless.
+Call it before the audio stream starts. */
+
+void allow(pthread_mutex_t* m);
+
+/* report
+Logs the violations recorded so far, grouped by call site, and forgets them. 
+Returns their number, known locks excluded. Not realtime safe. */
+
+int report();
+
+#else
+
+inline void init()  {}
+inline void enter() {}
+inline void leave() {}
+inline void allow(pthread_mutex_t* m) {}
+inline int report() { return 0; }
+
+#endif
+}}}; // giada::m::rtAudit::
+
+
+#endif
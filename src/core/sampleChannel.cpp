@@ -44,6 +44,8 @@
 #include "mixerHandler.h"
 #include "kernelMidi.h"
 #include "kernelAudio.h"
+#include "bufferPool.h"
+#include "realtime.h"
 #include "sampleChannel.h"
 
 
@@ -87,6 +89,8 @@ SampleChannel::~SampleChannel()
 		delete wave;
 	if (rsmp_state != nullptr)
 		src_delete(rsmp_state);
+	bufferPool::release(pChan);
+	bufferPool::release(vChanPreview);
 }
 
 
@@ -104,12 +108,12 @@ bool SampleChannel::allocBuffers()
 		return false;
 	}
 
-	if (!pChan.alloc(bufferSize, G_MAX_IO_CHANS)) {
+	if (!bufferPool::acquire(pChan)) {
 		gu_log("[SampleChannel::allocBuffers] unable to alloc memory for pChan!\n");
 		return false;
 	}
 
-	if (!vChanPreview.alloc(bufferSize, G_MAX_IO_CHANS)) {
+	if (!bufferPool::acquire(vChanPreview)) {
 		gu_log("[SampleChannel::allocBuffers] unable to alloc memory for vChanPreview!\n");
 		return false;
 	}
@@ -121,9 +125,22 @@ bool SampleChannel::allocBuffers()
 /* -------------------------------------------------------------------------- */
 
 
-void SampleChannel::copy(const Channel* src_, pthread_mutex_t* pluginMutex)
+void SampleChannel::prefault() const
 {
-	Channel::copy(src_, pluginMutex);
+	Channel::prefault();
+	realtime::prefault(pChan);
+	realtime::prefault(vChanPreview);
+	realtime::prefault(wave);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void SampleChannel::copy(const Channel* src_, pthread_mutex_t* pluginMutex,
+	bool withActions)
+{
+	Channel::copy(src_, pluginMutex, withActions);
 	const SampleChannel* src = static_cast<const SampleChannel*>(src_);
 	tracker         = src->tracker;
 	begin           = src->begin;
@@ -366,6 +383,8 @@ void SampleChannel::sum(int frame, bool running)
 	if (wave == nullptr || status & ~(STATUS_PLAY | STATUS_ENDING))
 		return;
 
+	producing = true;  // might have ended in this very block: render it anyway
+
 	if (frame != frameRewind) {
 
 		/* volume envelope, only if seq is running */
@@ -779,24 +798,46 @@ void SampleChannel::pushWave(Wave* w)
 /* -------------------------------------------------------------------------- */
 
 
+bool SampleChannel::isProducing() const
+{
+	return isPlaying() || (armed && inputMonitor) || Channel::isProducing();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void SampleChannel::process(giada::m::AudioBuffer& out, const giada::m::AudioBuffer& in)
 {
 	assert(out.countSamples() == vChan.countSamples());
 	assert(in.countSamples()  == vChan.countSamples());
 
-	/* If armed and inbuffer is not nullptr (i.e. input device available) and
-  input monitor is on, copy input buffer to vChan: this enables the input
-  monitoring. The vChan will be overwritten later by pluginHost::processStack,
-  so that you would record "clean" audio (i.e. not plugin-processed). */
+	/* Frozen channels have their vChan already filled by sumFrozen(), plug-ins
+	included. */
 
-	if (armed && in.isAllocd() && inputMonitor)
-		for (int i=0; i<vChan.countFrames(); i++)
-			for (int j=0; j<vChan.countChannels(); j++)
-				vChan[i][j] += in[i][j];   // add, don't overwrite
+	if (isFrozen()) {
+		producing = false;  // re-armed by sumFrozen() in the next block
+#ifdef WITH_VST
+		pluginHost::applyParams(pluginHost::CHANNEL, this);
+#endif
+	}
+	else {
+		updateTail();
+
+		/* If armed and inbuffer is not nullptr (i.e. input device available) and
+		input monitor is on, copy input buffer to vChan: this enables the input
+		monitoring. The vChan will be overwritten later by pluginHost::processStack,
+		so that you would record "clean" audio (i.e. not plugin-processed). */
+
+		if (armed && in.isAllocd() && inputMonitor)
+			for (int i=0; i<vChan.countFrames(); i++)
+				for (int j=0; j<vChan.countChannels(); j++)
+					vChan[i][j] += in[i][j];   // add, don't overwrite
 
 #ifdef WITH_VST
-	pluginHost::processStack(vChan, pluginHost::CHANNEL, this);
+		pluginHost::processStack(vChan, pluginHost::CHANNEL, this);
 #endif
+	}
 
 		for (int i=0; i<out.countFrames(); i++)
 			for (int j=0; j<out.countChannels(); j++)
@@ -807,6 +848,15 @@ void SampleChannel::process(giada::m::AudioBuffer& out, const giada::m::AudioBuf
 /* -------------------------------------------------------------------------- */
 
 
+float SampleChannel::getOutputGain(int ch)
+{
+	return volume * calcPanning(ch) * boost;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void SampleChannel::preview(giada::m::AudioBuffer& out)
 {
 	if (previewMode == G_PREVIEW_NONE)
@@ -73,6 +73,9 @@ private:
 	void setFadeOut(int actionPostFadeout);
 	void setXFade(int frame);
 
+	bool isProducing() const override;
+	float getOutputGain(int ch) override;
+
 	/* rsmp_state, rsmp_data
 	Structs from libsamplerate. */
 
@@ -113,7 +116,8 @@ public:
 	SampleChannel(int bufferSize, bool inputMonitor);
 	~SampleChannel();
 
-	void copy(const Channel* src, pthread_mutex_t* pluginMutex) override;
+	void copy(const Channel* src, pthread_mutex_t* pluginMutex, 
+		bool withActions=true) override;
 	void clear() override;
 	void process(giada::m::AudioBuffer& out, const giada::m::AudioBuffer& in) override;
 	void preview(giada::m::AudioBuffer& out) override;
@@ -135,6 +139,7 @@ public:
 			int quantize, bool mixerIsRunning) override;
 	bool canInputRec() override;
 	bool allocBuffers() override;
+	void prefault() const override;
 
 	float getBoost() const;	
 	int   getBegin() const;
@@ -0,0 +1,237 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifdef WITH_TRACE
+
+
+#include <atomic>
+#include <array>
+#include <cstdio>
+#include <vector>
+#include "../utils/log.h"
+#include "../utils/time.h"
+#include "const.h"
+#include "queue.h"
+#include "trace.h"
+
+
+namespace giada {
+namespace m {
+namespace trace
+{
+namespace
+{
+struct Event
+{
+	const char* name;
+	int64_t     begin;
+	int64_t     end;
+};
+
+/* Buffer
+Events of a single thread: the owner thread is the only producer, dump() the
+only consumer. A buffer released by an exiting thread can be claimed by a new 
+one: events not dumped yet go under the new thread name. */
+
+struct Buffer
+{
+	std::atomic<bool>            used;
+	std::atomic<const char*>     name;
+	Queue<Event, G_TRACE_EVENTS> events;
+};
+
+std::atomic<bool> enabled(false);
+std::atomic<int>  dropped(0);
+std::atomic<bool> exhausted(false);
+
+std::array<Buffer, G_TRACE_THREADS> buffers;
+std::atomic<int> numBuffers(0);  // highest buffer ever claimed, plus one
+
+/* Slot
+Buffer of the calling thread, claimed on first use and released when the 
+thread exits, so that short-lived threads don't use all buffers up. Stays 
+nullptr if all buffers are taken. */
+
+struct Slot
+{
+	Buffer* buffer  = nullptr;
+	bool    claimed = false;
+
+	~Slot()
+	{
+		if (buffer != nullptr)
+			buffer->used.store(false, std::memory_order_release);
+	}
+};
+
+thread_local Slot slot;
+
+int64_t epoch = u::time::now();
+
+
+/* -------------------------------------------------------------------------- */
+
+
+Buffer* getBuffer()
+{
+	if (slot.claimed)
+		return slot.buffer;
+	slot.claimed = true;
+
+	for (int i=0; i<G_TRACE_THREADS; i++) {
+		bool expected = false;
+		if (!buffers[i].used.compare_exchange_strong(expected, true, 
+		    std::memory_order_acquire))
+			continue;
+		buffers[i].name.store(nullptr, std::memory_order_relaxed);
+		int n = numBuffers.load();
+		while (n < i + 1 && !numBuffers.compare_exchange_weak(n, i + 1));
+		slot.buffer = &buffers[i];
+		return slot.buffer;
+	}
+
+	if (!exhausted.exchange(true))
+		gu_log("[trace] more than %d threads traced, events of the others are dropped\n",
+			G_TRACE_THREADS);
+	return nullptr;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* escape
+Event and thread names are literals chosen by us: quotes and backslashes are 
+the only characters to take care of. */
+
+std::string escape(const char* s)
+{
+	std::string out;
+	for (; *s != '\0'; s++) {
+		if (*s == '"' || *s == '\\')
+			out += '\\';
+		out += *s;
+	}
+	return out;
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+void setEnabled(bool v) { enabled.store(v, std::memory_order_relaxed); }
+bool isEnabled()        { return enabled.load(std::memory_order_relaxed); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int64_t begin()
+{
+	return isEnabled() ? u::time::now() : 0;
+}
+
+
+void end(const char* name, int64_t begin)
+{
+	if (begin == 0)
+		return;
+	Buffer* b = getBuffer();
+	if (b == nullptr || !b->events.push({ name, begin, u::time::now() }))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void setThreadName(const char* name)
+{
+	Buffer* b = getBuffer();
+	if (b != nullptr)
+		b->name.store(name, std::memory_order_relaxed);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool dump(const std::string& path)
+{
+	FILE* f = fopen(path.c_str(), "w");
+	if (f == nullptr) {
+		gu_log("[trace] unable to open %s\n", path.c_str());
+		return false;
+	}
+
+	/* Timestamps are in microseconds, relative to startup. Complete events 
+	('X') carry their duration. */
+
+	fprintf(f, "{\"traceEvents\":[\n");
+	fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Giada\"}}");
+
+	int count = 0;
+	int n     = numBuffers.load();
+	for (int i=0; i<n; i++) {
+		const char* name = buffers[i].name.load(std::memory_order_relaxed);
+		std::string tname = name != nullptr ? escape(name) : "thread " + std::to_string(i);
+		fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+			i, tname.c_str());
+
+		Event e;
+		while (buffers[i].events.pop(e)) {
+			fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				escape(e.name).c_str(), i, (e.begin - epoch) / 1000.0, (e.end - e.begin) / 1000.0);
+			count++;
+		}
+	}
+
+	fprintf(f, "\n]}\n");
+	bool ok = ferror(f) == 0;
+	ok = fclose(f) == 0 && ok;
+
+	gu_log("[trace] %d events saved to %s, %d dropped\n", count, path.c_str(), 
+		dropped.exchange(0));
+	return ok;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int getDropped()
+{
+	return dropped.load(std::memory_order_relaxed);
+}
+}}}; // giada::m::trace::
+
+
+#endif // #ifdef WITH_TRACE
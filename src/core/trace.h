@@ -0,0 +1,122 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef G_TRACE_H
+#define G_TRACE_H
+
+
+#include <cstdint>
+#include <string>
+
+
+/* [trace]
+Timeline of what each thread is doing, saved as a Chrome trace (JSON) to be 
+opened with chrome://tracing or Perfetto. Compiled in by --enable-trace only:
+otherwise the G_TRACE_* macros expand to nothing. Event names must be string 
+literals. Usage:
+
+	G_TRACE_SCOPE("patch::read");      // from here to the end of the scope
+
+	G_TRACE_BEGIN(t);                  // between BEGIN and END
+	...
+	G_TRACE_END(t, "mixer::renderIO"); 
+
+	G_TRACE_THREAD("audio");           // name of the calling thread */
+
+#ifdef WITH_TRACE
+
+#define G_TRACE_CONCAT_(a, b) a##b
+#define G_TRACE_CONCAT(a, b)  G_TRACE_CONCAT_(a, b)
+
+#define G_TRACE_SCOPE(name)   giada::m::trace::Scope G_TRACE_CONCAT(traceScope_, __LINE__)(name)
+#define G_TRACE_BEGIN(id)     int64_t id = giada::m::trace::begin()
+#define G_TRACE_END(id, name) giada::m::trace::end(name, id)
+#define G_TRACE_THREAD(name)  giada::m::trace::setThreadName(name)
+
+#else
+
+#define G_TRACE_SCOPE(name)
+#define G_TRACE_BEGIN(id)
+#define G_TRACE_END(id, name)
+#define G_TRACE_THREAD(name)
+
+#endif
+
+
+#ifdef WITH_TRACE
+
+namespace giada {
+namespace m {
+namespace trace
+{
+/* setEnabled, isEnabled
+Tracing is off by default: while disabled, each macro costs an atomic load. */
+
+void setEnabled(bool v);
+bool isEnabled();
+
+/* begin, end
+Records an event from 'begin' to now in the calling thread's buffer, unless
+'begin' is 0 (tracing disabled). Lock-free: events are dropped if the buffer is
+full, or if more than G_TRACE_THREADS threads are traced at the same time. */
+
+int64_t begin();
+void end(const char* name, int64_t begin);
+
+void setThreadName(const char* name);
+
+/* dump
+Moves all pending events to a Chrome trace file. Returns false on I/O error. 
+One caller at a time. */
+
+bool dump(const std::string& path);
+
+/* getDropped
+Events lost since the last dump(). */
+
+int getDropped();
+
+class Scope
+{
+public:
+
+	Scope(const char* name) : m_name(name), m_begin(begin()) {}
+	~Scope() { end(m_name, m_begin); }
+
+private:
+
+	const char* m_name;
+	int64_t     m_begin;
+};
+}}}; // giada::m::trace::
+
+#endif
+
+
+#endif
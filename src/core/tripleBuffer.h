@@ -0,0 +1,120 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_TRIPLE_BUFFER_H
+#define G_TRIPLE_BUFFER_H
+
+
+#include <array>
+#include <atomic>
+
+
+namespace giada {
+namespace m 
+{
+/* TripleBuffer
+Lock-free single-value channel from exactly one writer thread to exactly one 
+reader thread. The writer fills the back buffer and publishes it, the reader 
+picks up the latest published one: neither ever blocks nor waits for the other,
+intermediate values are simply skipped. The back buffer handed out after 
+publish() holds stale data: the writer must rewrite every field it cares 
+about. */
+
+template<typename T>
+class TripleBuffer
+{
+public:
+
+	TripleBuffer() : m_back(0), m_middle(1), m_front(2), m_version(0), m_buffers() {}
+
+	/* getWriteBuffer
+	Writer only. */
+
+	T& getWriteBuffer()
+	{
+		return m_buffers[m_back];
+	}
+
+	/* publish
+	Writer only. Makes the write buffer available to the reader. */
+
+	void publish()
+	{
+		m_back = m_middle.exchange(m_back | DIRTY, std::memory_order_acq_rel) & INDEX;
+	}
+
+	/* update
+	Reader only. Takes the latest published buffer, if any. Returns false if 
+	nothing has been published since the last call: the read buffer is left 
+	untouched. */
+
+	bool update()
+	{
+		if ((m_middle.load(std::memory_order_relaxed) & DIRTY) == 0)
+			return false;
+		m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+		m_version++;
+		return true;
+	}
+
+	/* getReadBuffer
+	Reader only. Stable until the next call to update(). */
+
+	const T& getReadBuffer() const
+	{
+		return m_buffers[m_front];
+	}
+
+	/* getVersion
+	Reader only. Number of successful update() calls so far. */
+
+	unsigned getVersion() const
+	{
+		return m_version;
+	}
+
+private:
+
+	static constexpr int INDEX = 0x3;
+	static constexpr int DIRTY = 0x4;
+
+	/* m_back, m_middle, m_front
+	Buffer indexes owned by the writer, shared, and owned by the reader. The 
+	shared one carries the DIRTY flag when it holds unread data. */
+
+	int              m_back;
+	std::atomic<int> m_middle;
+	int              m_front;
+	unsigned         m_version;
+
+	std::array<T, 3> m_buffers;
+};
+}} // giada::m::
+
+
+#endif
@@ -0,0 +1,178 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include <unordered_map>
+#include "queue.h"
+#include "tripleBuffer.h"
+#include "clock.h"
+#include "mixer.h"
+#include "const.h"
+#include "channel.h"
+#include "sampleChannel.h"
+#include "uiState.h"
+
+
+namespace giada {
+namespace m {
+namespace uiState
+{
+namespace
+{
+TripleBuffer<State> state;
+
+MpscQueue<Event, G_UI_EVENT_QUEUE> events;
+
+/* byIndex
+Position of each channel in the read buffer, by channel index. GUI side 
+only. */
+
+std::unordered_map<int, int> byIndex;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void fillChannel(ChannelState& cs, Channel* ch)
+{
+	cs.index     = ch->index;
+	cs.status    = ch->status;
+	cs.recStatus = ch->recStatus;
+	cs.position  = 0;
+	cs.length    = 0;
+	cs.level     = ch->level;
+
+	if (ch->type == G_CHANNEL_SAMPLE) {
+		SampleChannel* sch = static_cast<SampleChannel*>(ch);
+		cs.position = sch->getPosition();
+		cs.length   = sch->getEnd() - sch->getBegin();
+	}
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
+void addChannel(Channel* ch)
+{
+	State& s = state.getWriteBuffer();
+	if (s.numChannels < G_UI_STATE_CHANNELS)
+		fillChannel(s.channels[s.numChannels++], ch);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void publish()
+{
+	State& s = state.getWriteBuffer();
+
+	s.running      = clock::isRunning();
+	s.recording    = mixer::recording;
+	s.currentFrame = clock::getCurrentFrame();
+	s.framesInLoop = clock::getFramesInLoop();
+	s.currentBeat  = clock::getCurrentBeat();
+	s.beats        = clock::getBeats();
+	s.bars         = clock::getBars();
+	s.bpm          = clock::getBpm();
+	s.out          = mixer::levelOut;
+	s.in           = mixer::levelIn;
+
+	state.publish();
+
+	/* The next write buffer holds stale channels: start it over. */
+
+	state.getWriteBuffer().numChannels = 0;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool update()
+{
+	if (!state.update())
+		return false;
+	const State& s = state.getReadBuffer();
+	byIndex.clear();
+	for (int i=0; i<s.numChannels; i++)
+		byIndex[s.channels[i].index] = i;
+	return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+const State& get()
+{
+	return state.getReadBuffer();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+const ChannelState* getChannel(int index)
+{
+	auto it = byIndex.find(index);
+	if (it == byIndex.end())
+		return nullptr;
+	return &state.getReadBuffer().channels[it->second];
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+unsigned getVersion()
+{
+	return state.getVersion();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool postEvent(int type, uint32_t iValue, float fValue)
+{
+	return events.push({ type, iValue, fValue });
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool popEvent(Event& e)
+{
+	return events.pop(e);
+}
+}}}; // giada::m::uiState::
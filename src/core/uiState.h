@@ -0,0 +1,154 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_UI_STATE_H
+#define G_UI_STATE_H
+
+
+#include <array>
+#include <cstdint>
+#include "const.h"
+#include "meter.h"
+
+
+class Channel;
+
+
+namespace giada {
+namespace m {
+namespace uiState
+{
+/* ChannelState
+What the GUI needs to know about a channel that is changed by the audio 
+thread. 'position' is the playhead relative to the sample begin, -1 if not 
+playing; 'length' is the playable range. Both 0 for MIDI channels. 'level' is 
+the output of the last block: peak hold and decay are up to the GUI. */
+
+struct ChannelState
+{
+	int index;
+	int status;
+	int recStatus;
+	int position;
+	int length;
+	meter::Level level;
+};
+
+/* State
+Snapshot of the engine, published by the audio thread at the end of each 
+callback. Only the first 'numChannels' channels are valid. */
+
+struct State
+{
+	bool  running;
+	bool  recording;
+	int   currentFrame;
+	int   framesInLoop;
+	int   currentBeat;
+	int   beats;
+	int   bars;
+	float bpm;
+	meter::Level out;
+	meter::Level in;
+	int   numChannels;
+	std::array<ChannelState, G_UI_STATE_CHANNELS> channels;
+};
+
+/* eventType
+Discrete requests that must not be carried out by the audio thread: they are
+picked up by the video thread (see gu_refreshUI()), which may call into glue
+code or send MIDI. */
+
+enum eventType
+{
+	TRANSPORT_START,  // start the sequencer, not from UI
+	TRANSPORT_STOP,   // stop the sequencer, not from UI
+	TRANSPORT_REWIND, // rewind the sequencer, not from UI, don't notify Jack
+	SET_BPM,          // fValue = new bpm
+	MIDI_LIGHTNING    // iValue = MIDI message to send
+};
+
+struct Event
+{
+	int      type;
+	uint32_t iValue;
+	float    fValue;
+};
+
+/* addChannel
+Adds the state of channel 'ch' to the snapshot being written. Called by the 
+mixer for each channel while it renders them, so that no extra locking is 
+needed. Audio thread only. */
+
+void addChannel(Channel* ch);
+
+/* publish
+Completes the snapshot with the global state and makes it available to the 
+GUI. Audio thread only. */
+
+void publish();
+
+/* update
+Picks up the latest snapshot, if a new one has been published. Returns false 
+otherwise. update() and the getters below are for the GUI side only: calls 
+from different threads (video thread, FLTK drawing) must be serialized by the
+FLTK lock. */
+
+bool update();
+
+/* get
+Current snapshot, stable until the next update(). */
+
+const State& get();
+
+/* getChannel
+Returns the state of channel with index 'index' in the current snapshot, or
+nullptr if not there (e.g. just added). Constant time: the snapshot is indexed
+by update(). */
+
+const ChannelState* getChannel(int index);
+
+/* getVersion
+Number of snapshots picked up so far. */
+
+unsigned getVersion();
+
+/* postEvent
+Queues an event for the video thread. Returns false if the queue is full: the
+event is dropped. Any thread. */
+
+bool postEvent(int type, uint32_t iValue=0, float fValue=0.0f);
+
+/* popEvent
+Video thread only. Returns false if there are no more events. */
+
+bool popEvent(Event& e);
+}}}; // giada::m::uiState::
+
+
+#endif
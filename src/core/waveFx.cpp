@@ -304,4 +304,27 @@ void reverse(Wave& w, int a, int b)
 	w.setEdited(true);
 }
 
+
+/* -------------------------------------------------------------------------- */
+
+
+void getPeaks(const Wave& w, int a, int b, float& sup, float& inf)
+{
+	sup = 0.0f;
+	inf = 0.0f;
+	for (int i=a; i<b; i++) {
+
+		/* Compute average of stereo signal. */
+
+		float avg = 0.0f;
+		float* frame = w.getFrame(i);
+		for (int j=0; j<w.getChannels(); j++)
+			avg += frame[j];
+		avg /= w.getChannels();
+
+		if      (avg > sup)  sup = avg;
+		else if (avg <= inf) inf = avg;
+	}
+}
+
 }}}; // giada::m::wfx::
\ No newline at end of file
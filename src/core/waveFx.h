@@ -77,6 +77,12 @@ void reverse(Wave& w, int a, int b);
 
 void shift(Wave& w, int offset);
 
+/* getPeaks
+Finds the highest and the lowest values of the channel average in range a-b.
+Both start from 0.0. Used to draw waveforms. */
+
+void getPeaks(const Wave& w, int a, int b, float& sup, float& inf);
+
 }}}; // giada::m::wfx::
 
 #endif
@@ -31,6 +31,7 @@
 #include "../utils/log.h"
 #include "../utils/fs.h"
 #include "const.h"
+#include "trace.h"
 #include "wave.h"
 #include "waveFx.h"
 #include "waveManager.h"
@@ -73,6 +74,8 @@ int getBits(SF_INFO& header)
 
 int create(const string& path, Wave** out)
 {
+	G_TRACE_SCOPE("waveManager::create");
+
 	if (path == "" || gu_isDir(path)) {
 		gu_log("[waveManager::create] malformed path (was '%s')\n", path.c_str());
 		return G_RES_ERR_NO_DATA;
@@ -174,6 +177,8 @@ int createFromWave(const Wave* src, int a, int b, Wave** out)
 
 int resample(Wave* w, int quality, int samplerate)
 {
+	G_TRACE_SCOPE("waveManager::resample");
+
 	float ratio = samplerate / (float) w->getRate();
 	int newSizeFrames = ceil(w->getSize() * ratio);
 
@@ -40,6 +40,7 @@
 #include "../gui/elems/sampleEditor/rangeTool.h"
 #include "../gui/elems/sampleEditor/waveform.h"
 #include "../gui/elems/mainWindow/keyboard/keyboard.h"
+#include "../gui/elems/mainWindow/keyboard/column.h"
 #include "../gui/elems/mainWindow/keyboard/channel.h"
 #include "../gui/elems/mainWindow/keyboard/sampleChannel.h"
 #include "../gui/elems/mainWindow/keyboard/channelButton.h"
@@ -58,6 +59,7 @@
 #include "../core/midiChannel.h"
 #include "../core/plugin.h"
 #include "../core/waveManager.h"
+#include "../core/commandQueue.h"
 #include "main.h"
 #include "channel.h"
 
@@ -115,9 +117,14 @@ int loadChannel(SampleChannel* ch, const string& fname)
 
 Channel* addChannel(int column, int type, int size)
 {
-	Channel* ch    = m::mh::addChannel(type);
-	geChannel* gch = G_MainWin->keyboard->addChannel(column, ch, size);
-	ch->guiChannel = gch;
+	Channel* ch = m::mh::addChannel(type);
+	G_MainWin->keyboard->addChannel(column, ch, size);
+
+	/* Route the new channel to the column group bus, if any. */
+
+	geColumn* gcol = G_MainWin->keyboard->getColumnByIndex(column);
+	if (gcol != nullptr && gcol->bus != nullptr)
+		m::mh::setColumnBus(ch, gcol->bus);
 	return ch;
 }
 
@@ -137,7 +144,7 @@ void deleteChannel(Channel* ch)
 	pluginHost::freeStack(pluginHost::CHANNEL, &mixer::mutex_plugins, ch);
 #endif
 	Fl::lock();
-	G_MainWin->keyboard->deleteChannel(ch->guiChannel);
+	G_MainWin->keyboard->deleteChannel(ch);
 	Fl::unlock();
 	mh::deleteChannel(ch);
 	gu_closeAllSubwindows();
@@ -157,6 +164,9 @@ void freeChannel(Channel* ch)
 	if (!gdConfirmWin("Warning", "Free channel: are you sure?"))
 		return;
 
+	if (ch->isFrozen())
+		m::mh::unfreezeChannel(ch);
+
 	G_MainWin->keyboard->freeChannel(ch->guiChannel);
 	m::recorder::clearChan(ch->index);
 	ch->hasActions = false;
@@ -177,8 +187,13 @@ void freeChannel(Channel* ch)
 void toggleArm(Channel* ch, bool gui)
 {
 	ch->armed = !ch->armed;
-	if (!gui)
-		ch->guiChannel->arm->value(ch->armed);
+	if (!gui) {
+		Fl::lock();
+		geChannel* gch = ch->guiChannel;
+		if (gch != nullptr)
+			gch->arm->value(ch->armed);
+		Fl::unlock();
+	}
 }
 
 
@@ -199,12 +214,11 @@ int cloneChannel(Channel* src)
 {
 	using namespace giada::m;
 
-	Channel* ch    = mh::addChannel(src->type);
-	geChannel* gch = G_MainWin->keyboard->addChannel(src->guiChannel->getColumnIndex(), 
-		ch, src->guiChannel->getSize());
+	Channel* ch = mh::addChannel(src->type);
+	G_MainWin->keyboard->addChannel(src->column, ch, src->size);
 
-	ch->guiChannel = gch;
 	ch->copy(src, &mixer::mutex_plugins);
+	mh::setColumnBus(ch, src->columnBus);
 
 	G_MainWin->keyboard->updateChannel(ch->guiChannel);
 	return true;
@@ -214,11 +228,49 @@ int cloneChannel(Channel* src)
 /* -------------------------------------------------------------------------- */
 
 
-void setVolume(Channel* ch, float v, bool gui, bool editor)
+void toggleFreeze(Channel* ch)
+{
+	using namespace giada::m;
+
+	if (ch->isFrozen())
+		mh::unfreezeChannel(ch);
+	else
+	if (mh::freezeChannel(ch) != G_RES_OK)
+		gdAlert("Unable to freeze channel!");
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+#ifdef WITH_VST
+
+void setSendLevel(Channel* ch, int bus, float v)
+{
+	ch->sendLevels[bus] = v;
+}
+
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void setVolume(Channel* ch, float v, bool gui, bool editor, int64_t time)
 {
-	ch->volume = v;
+	if (!m::commandQueue::post(m::commandQueue::SET_VOLUME, ch, time, 0, v))
+		ch->volume = v;
 
-	/* Changing channel volume? Update wave editor (if it's shown). */
+	/* The volume dial holds the new value until the audio thread applies it: 
+	update it first, the wave editor (if it's shown) reads from there. */
+
+	if (!gui) {
+		Fl::lock();
+		geChannel* gch = ch->guiChannel;
+		if (gch != nullptr)
+			gch->vol->value(v);
+		Fl::unlock();
+	}
 
 	if (!editor) {
 		gdSampleEditor* gdEditor = static_cast<gdSampleEditor*>(gu_getSubwindow(G_MainWin, WID_SAMPLE_EDITOR));
@@ -228,12 +280,6 @@ void setVolume(Channel* ch, float v, bool gui, bool editor)
 			Fl::unlock();
 		}
 	}
-
-	if (!gui) {
-		Fl::lock();
-		ch->guiChannel->vol->value(v);
-		Fl::unlock();
-	}
 }
 
 
@@ -270,7 +316,7 @@ void setPanning(SampleChannel* ch, float val)
 /* -------------------------------------------------------------------------- */
 
 
-void toggleMute(Channel* ch, bool gui)
+void toggleMute(Channel* ch, bool gui, int64_t time)
 {
 	using namespace giada::m;
 
@@ -285,11 +331,18 @@ void toggleMute(Channel* ch, bool gui)
 			&mixer::mutex_recs);
 	}
 
-	ch->mute ? ch->unsetMute(false) : ch->setMute(false);
+	/* The toggle is applied later by the audio thread: show the state the channel
+	is going to be in. */
+
+	bool mute = !ch->mute;
+	if (!commandQueue::post(commandQueue::TOGGLE_MUTE, ch, time))
+		ch->mute ? ch->unsetMute(false) : ch->setMute(false);
 
 	if (!gui) {
 		Fl::lock();
-		ch->guiChannel->mute->value(ch->mute);
+		geChannel* gch = ch->guiChannel;
+		if (gch != nullptr)
+			gch->mute->value(mute);
 		Fl::unlock();
 	}
 }
@@ -307,7 +360,9 @@ void toggleSolo(Channel* ch, bool gui)
 	
 	if (!gui) {
 		Fl::lock();
-		ch->guiChannel->solo->value(ch->solo);
+		geChannel* gch = ch->guiChannel;
+		if (gch != nullptr)
+			gch->solo->value(ch->solo);
 		Fl::unlock();
 	}
 }
@@ -316,9 +371,10 @@ void toggleSolo(Channel* ch, bool gui)
 /* -------------------------------------------------------------------------- */
 
 
-void kill(Channel* ch)
+void kill(Channel* ch, int64_t time)
 {
-	ch->kill(0); // on frame 0: it's a user-generated event
+	if (!m::commandQueue::post(m::commandQueue::KILL, ch, time))
+		ch->kill(0); // on frame 0: it's a user-generated event
 }
 
 
@@ -343,7 +399,7 @@ void setBoost(SampleChannel* ch, float val)
 void setName(Channel* ch, const string& name)
 {
 	ch->name = name;
-	ch->guiChannel->update();
+	G_MainWin->keyboard->updateChannel(ch->guiChannel);
 }
 
 
@@ -381,7 +437,9 @@ void startReadingRecs(SampleChannel* ch, bool gui)
 		ch->setReadActions(true, conf::recsStopOnChanHalt);
 	if (!gui) {
 		Fl::lock();
-		static_cast<geSampleChannel*>(ch->guiChannel)->readActions->value(1);
+		geChannel* gch = ch->guiChannel;
+		if (gch != nullptr)
+			static_cast<geSampleChannel*>(gch)->readActions->value(1);
 		Fl::unlock();
 	}
 }
@@ -416,7 +474,9 @@ void stopReadingRecs(SampleChannel* ch, bool gui)
 
 	if (!gui) {
 		Fl::lock();
-		static_cast<geSampleChannel*>(ch->guiChannel)->readActions->value(0);
+		geChannel* gch = ch->guiChannel;
+		if (gch != nullptr)
+			static_cast<geSampleChannel*>(gch)->readActions->value(0);
 		Fl::unlock();
 	}
 }
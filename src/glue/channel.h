@@ -30,6 +30,7 @@
 
 
 #include <string>
+#include <cstdint>
 
 
 class Channel;
@@ -65,21 +66,37 @@ Makes an exact copy of Channel *ch. */
 
 int cloneChannel(Channel* ch);
 
+/* toggleFreeze
+Renders a channel to audio and plays it back in place of its live chain, or
+brings a frozen channel back to life. */
+
+void toggleFreeze(Channel* ch);
+
 /* toggle/set*
 Toggles or set several channel properties. If gui == true the signal comes from 
 a manual interaction on the GUI, otherwise it's a MIDI/Jack/external signal. */
 
 void toggleArm(Channel* ch, bool gui=true);
 void toggleInputMonitor(Channel* ch);
-void kill(Channel* ch);
-void toggleMute(Channel* ch, bool gui=true);
+void kill(Channel* ch, int64_t time=0);
+void toggleMute(Channel* ch, bool gui=true, int64_t time=0);
 void toggleSolo(Channel* ch, bool gui=true);
-void setVolume(Channel* ch, float v, bool gui=true, bool editor=false);
+void setVolume(Channel* ch, float v, bool gui=true, bool editor=false, 
+	int64_t time=0);
 void setName(Channel* ch, const std::string& name);
 void setPitch(SampleChannel* ch, float val);
 void setPanning(SampleChannel* ch, float val);
 void setBoost(SampleChannel* ch, float val);
 
+#ifdef WITH_VST
+
+/* setSendLevel
+Sets how much signal channel 'ch' sends to send bus 'bus'. */
+
+void setSendLevel(Channel* ch, int bus, float v);
+
+#endif
+
 /* toggleReadingRecs
 Handles the 'R' button. If gui == true the signal comes from an user interaction
 on the GUI, otherwise it's a MIDI/Jack/external signal. */
@@ -0,0 +1,86 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "../gui/elems/mainWindow/keyboard/column.h"
+#include "../gui/dialogs/gd_warnings.h"
+#include "../utils/gui.h"
+#include "../utils/log.h"
+#include "../core/mixerHandler.h"
+#include "../core/columnBus.h"
+#include "column.h"
+
+
+namespace giada {
+namespace c     {
+namespace column 
+{
+void setBus(geColumn* gcol, bool on)
+{
+	using namespace giada::m;
+
+	if (on == (gcol->bus != nullptr))
+		return;
+
+	if (on) {
+		ColumnBus* bus = mh::addColumnBus();
+		if (bus == nullptr) {
+			gdAlert("Unable to create group bus!");
+			return;
+		}
+		for (int i=0; i<gcol->countChannels(); i++)
+			mh::setColumnBus(gcol->getChannel(i), bus);
+		gcol->bus = bus;
+	}
+	else {
+		gu_closeAllSubwindows();
+		mh::deleteColumnBus(gcol->bus);
+		gcol->bus = nullptr;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void setBusVolume(geColumn* gcol, float v)
+{
+	if (gcol->bus != nullptr)
+		gcol->bus->volume = v;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void toggleBusMute(geColumn* gcol)
+{
+	if (gcol->bus != nullptr)
+		gcol->bus->mute = !gcol->bus->mute;
+}
+
+}}}; // giada::c::column::
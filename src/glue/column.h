@@ -0,0 +1,53 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef G_GLUE_COLUMN_H
+#define G_GLUE_COLUMN_H
+
+
+class geColumn;
+
+
+namespace giada {
+namespace c     {
+namespace column 
+{
+/* setBus
+Creates (on == true) or removes the group bus of column 'gcol'. Channels in the
+column are routed to the new bus, or back to the master output. */
+
+void setBus(geColumn* gcol, bool on);
+
+/* setBusVolume, toggleBusMute */
+
+void setBusVolume(geColumn* gcol, float v);
+void toggleBusMute(geColumn* gcol);
+}}}; // giada::c::column::
+
+
+#endif
@@ -25,6 +25,7 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <cstring>
 #include <FL/Fl.H>
 #include "../gui/dialogs/gd_mainWindow.h"
 #include "../gui/dialogs/gd_warnings.h"
@@ -36,6 +37,7 @@
 #include "../utils/gui.h"
 #include "../utils/log.h"
 #include "../utils/math.h"
+#include "../utils/string.h"
 #include "../core/recorder.h"
 #include "../core/kernelAudio.h"
 #include "../core/mixer.h"
@@ -45,6 +47,9 @@
 #include "../core/clock.h"
 #include "../core/sampleChannel.h"
 #include "../core/midiChannel.h"
+#include "../core/commandQueue.h"
+#include "../core/midiDispatcher.h"
+#include "../core/eventLog.h"
 #include "main.h"
 #include "channel.h"
 #include "transport.h"
@@ -60,16 +65,43 @@ namespace io
 {
 namespace
 {
-void ctrlPress(SampleChannel* ch)
+/* startChannel, stopChannel
+Hand the user-generated event over to the audio thread. It's applied right away 
+on frame 0 only if the command queue can't take it. 'volumeI' is the internal 
+volume to set before starting, negative to leave it untouched. */
+
+void startChannel(Channel* ch, int64_t time, float volumeI=-1.0f)
 {
-	c::channel::toggleMute(ch);
+	using namespace giada::m;
+
+	if (commandQueue::post(commandQueue::KEY_PRESS, ch, time, 0, volumeI))
+		return;
+	if (volumeI >= 0.0f)
+		ch->setVolumeI(volumeI);
+	ch->start(0, true, clock::getQuantize(), clock::isRunning(), false, true);
+}
+
+
+void stopChannel(Channel* ch, int64_t time)
+{
+	if (!m::commandQueue::post(m::commandQueue::KEY_RELEASE, ch, time))
+		ch->stop();
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void shiftPress(SampleChannel* ch)
+void ctrlPress(SampleChannel* ch, bool gui)
+{
+	c::channel::toggleMute(ch, gui);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void shiftPress(SampleChannel* ch, bool gui)
 {
 	/* action recording on:
 			if sequencer is running, rec a killchan
@@ -82,7 +114,7 @@ void shiftPress(SampleChannel* ch)
 	if (m::recorder::active) {
 		if (!m::clock::isRunning()) 
 			return;
-		ch->kill(0); // on frame 0: user-generated event
+		c::channel::kill(ch);
 		if (m::recorder::canRec(ch, m::clock::isRunning(), m::mixer::recording) &&
 				!(ch->mode & LOOP_ANY))
 		{   // don't record killChan actions for LOOP channels
@@ -93,12 +125,13 @@ void shiftPress(SampleChannel* ch)
 	else {
 		if (ch->hasActions) {
 			if (m::clock::isRunning() || ch->status == STATUS_OFF)
-				ch->readActions ? c::channel::stopReadingRecs(ch) : c::channel::startReadingRecs(ch);
+				ch->readActions ? c::channel::stopReadingRecs(ch, gui) : 
+					c::channel::startReadingRecs(ch, gui);
 			else
-				ch->kill(0);  // on frame 0: user-generated event
+				c::channel::kill(ch);
 		}
 		else
-			ch->kill(0);    // on frame 0: user-generated event
+			c::channel::kill(ch);
 	}
 }
 
@@ -106,7 +139,7 @@ void shiftPress(SampleChannel* ch)
 /* -------------------------------------------------------------------------- */
 
 
-void cleanPress(SampleChannel* ch, int velocity)
+void cleanPress(SampleChannel* ch, int velocity, int64_t time)
 {
 	/* Record now if the quantizer is off, otherwise let mixer to handle it when a
 	quantoWait has passed. Moreover, KEYPRESS and KEYREL are meaningless for loop 
@@ -137,13 +170,13 @@ void cleanPress(SampleChannel* ch, int velocity)
 		}
 	}
 
-	/* This is a user-generated event, so it's on frame 0. For one-shot modes,
-	velocity drives the internal volume. */
+	/* For one-shot modes, velocity drives the internal volume. */
 
+	float volumeI = -1.0f;
 	if (ch->mode & SINGLE_ANY && ch->midiInVeloAsVol)
-		ch->setVolumeI(u::math::map((float)velocity, 0.0f, 127.0f, 0.0f, 1.0f));
+		volumeI = u::math::map((float)velocity, 0.0f, 127.0f, 0.0f, 1.0f);
 
-	ch->start(0, true, m::clock::getQuantize(), m::clock::isRunning(), false, true);
+	startChannel(ch, time, volumeI);
 }
 
 } // {anonymous}
@@ -154,65 +187,74 @@ void cleanPress(SampleChannel* ch, int velocity)
 /* -------------------------------------------------------------------------- */
 
 
-void keyPress(Channel* ch, bool ctrl, bool shift, int velocity)
+void keyPress(Channel* ch, bool ctrl, bool shift, int velocity, int64_t time, 
+	bool gui)
 {
 	if (ch->type == G_CHANNEL_SAMPLE)
-		keyPress(static_cast<SampleChannel*>(ch), ctrl, shift, velocity);
+		keyPress(static_cast<SampleChannel*>(ch), ctrl, shift, velocity, time, gui);
 	else
-		keyPress(static_cast<MidiChannel*>(ch), ctrl, shift);
+		keyPress(static_cast<MidiChannel*>(ch), ctrl, shift, time, gui);
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void keyRelease(Channel* ch, bool ctrl, bool shift)
+void keyRelease(Channel* ch, bool ctrl, bool shift, int64_t time)
 {
 	if (ch->type == G_CHANNEL_SAMPLE)
-		keyRelease(static_cast<SampleChannel*>(ch), ctrl, shift);
+		keyRelease(static_cast<SampleChannel*>(ch), ctrl, shift, time);
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void keyPress(MidiChannel* ch, bool ctrl, bool shift)
+void keyPress(MidiChannel* ch, bool ctrl, bool shift, int64_t time, bool gui)
 {
+	m::eventLog::capture(m::eventLog::KEY_PRESS, ch->index, 0x7F, ctrl | shift << 1);
+
 	if (ctrl)
-		c::channel::toggleMute(ch);
+		c::channel::toggleMute(ch, gui);
 	else
 	if (shift)
-		ch->kill(0);        // on frame 0: user-generated event
+		c::channel::kill(ch);
 	else
-		ch->start(0, true, m::clock::getQuantize(), m::clock::isRunning(), false, true); // on frame 0: user-generated event
+		startChannel(ch, time);
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void keyPress(SampleChannel* ch, bool ctrl, bool shift, int velocity)
+void keyPress(SampleChannel* ch, bool ctrl, bool shift, int velocity, 
+	int64_t time, bool gui)
 {
+	m::eventLog::capture(m::eventLog::KEY_PRESS, ch->index, velocity, 
+		ctrl | shift << 1);
+
 	if (ctrl)
-		ctrlPress(ch);
+		ctrlPress(ch, gui);
 	else if (shift)
-		shiftPress(ch);
+		shiftPress(ch, gui);
 	else
-		cleanPress(ch, velocity);
+		cleanPress(ch, velocity, time);
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void keyRelease(SampleChannel* ch, bool ctrl, bool shift)
+void keyRelease(SampleChannel* ch, bool ctrl, bool shift, int64_t time)
 {
 	using namespace giada::m;
 
+	eventLog::capture(eventLog::KEY_RELEASE, ch->index, 0, ctrl | shift << 1);
+
 	if (ctrl || shift)
 		return;
 
-	ch->stop();
+	stopChannel(ch, time);
 
 	/* record a key release only if channel is single_press. For any
 	 * other mode the KEY REL is meaningless. */
@@ -229,6 +271,73 @@ void keyRelease(SampleChannel* ch, bool ctrl, bool shift)
 /* -------------------------------------------------------------------------- */
 
 
+void replay(const m::eventLog::Event& e)
+{
+	using namespace giada::m;
+
+	bool ctrl  = e.flags & 1;
+	bool shift = e.flags & 2;
+
+	switch (e.type) {
+		case eventLog::MIDI:
+			midiDispatcher::dispatch(e.a >> 16 & 0xFF, e.a >> 8 & 0xFF, e.a & 0xFF);
+			break;
+		case eventLog::KEY_PRESS:
+		case eventLog::KEY_RELEASE: {
+
+			/* The main thread may be adding or removing channels meanwhile. A 
+			channel removed right after the lookup is still alive until the end
+			of this call: it's deleted only after the next blocks, which this 
+			thread runs, see commandQueue::forget(). */
+
+			pthread_mutex_lock(&mixer::mutex_chans);
+			Channel* ch = mh::getChannelByIndex(e.a);
+			pthread_mutex_unlock(&mixer::mutex_chans);
+			if (ch == nullptr)
+				break;
+
+			/* Not from the main window: widgets must be updated by hand. */
+
+			if (e.type == eventLog::KEY_PRESS)
+				keyPress(ch, ctrl, shift, e.b, 0, false);
+			else
+				keyRelease(ch, ctrl, shift);
+			break;
+		}
+		case eventLog::START:
+			glue_startSeq(false);
+			break;
+		case eventLog::STOP:
+			glue_stopSeq(false);
+			break;
+		case eventLog::REWIND:
+			glue_rewindSeq(false);
+			break;
+		case eventLog::BPM:
+			Fl::lock();
+			glue_setBpm(gu_iToString(e.a).c_str(), gu_iToString(e.b).c_str());
+			Fl::unlock();
+			break;
+		case eventLog::BEATS:
+			Fl::lock();
+			glue_setBeats(e.a, e.b, e.flags != 0);
+			Fl::unlock();
+			break;
+#ifdef __linux__
+		case eventLog::JACK: {
+			float bpm;
+			memcpy(&bpm, &e.a, sizeof(bpm));
+			kernelAudio::jackReplay({e.flags != 0, bpm, static_cast<uint32_t>(e.b)});
+			break;
+		}
+#endif
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void startStopActionRec(bool gui)
 {
 	m::recorder::active ? stopActionRec(gui) : startActionRec(gui);
@@ -273,7 +382,9 @@ void stopActionRec(bool gui)
 		if (ch->type == G_CHANNEL_MIDI)
 			continue;
 		SampleChannel* sch = static_cast<SampleChannel*>(ch);
+		Fl::lock();
 		G_MainWin->keyboard->setChannelWithActions(static_cast<geSampleChannel*>(sch->guiChannel));
+		Fl::unlock();
 		if (!sch->readActions && sch->hasActions)
 			c::channel::startReadingRecs(sch, false);
 	}
@@ -325,13 +436,16 @@ int startInputRec(bool gui)
 		if (!gui)
 			G_MainWin->mainTransport->updateRecInput(1);
 		G_MainWin->mainTimer->setLock(true);
-	Fl::unlock();
 
-	/* Update sample name inside sample channels' main button. This is useless for
-	midi channel, but let's do it anyway. */
+		/* Update sample name inside sample channels' main button. This is useless 
+		for midi channel, but let's do it anyway. */
 
-	for (Channel* ch : m::mixer::channels)
-		ch->guiChannel->update();
+		for (Channel* ch : m::mixer::channels) {
+			geChannel* gch = ch->guiChannel;
+			if (gch != nullptr)
+				gch->update();
+		}
+	Fl::unlock();
 
 	return true;
 }
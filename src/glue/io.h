@@ -36,6 +36,10 @@
 #define G_GLUE_IO_H
 
 
+#include <cstdint>
+#include "../core/eventLog.h"
+
+
 class Channel;
 class SampleChannel;
 class MidiChannel;
@@ -47,13 +51,22 @@ namespace io
 /* keyPress / keyRelease
  * handle the key pressure, either via mouse/keyboard or MIDI. If gui
  * is true it means that the event comes from the main window (mouse,
- * keyb or MIDI), otherwise the event comes from the action recorder. */
+ * keyb or MIDI), otherwise it comes from elsewhere (e.g. an input replay)
+ * and the mute and read-actions widgets are updated here.
+ * The channel is started/stopped by the audio thread, on the frame
+ * matching 'time' (MIDI arrival time, 0 for now), see m::commandQueue. */
+
+void keyPress  (Channel*       ch, bool ctrl, bool shift, int velocity, int64_t time=0, bool gui=true);
+void keyPress  (SampleChannel* ch, bool ctrl, bool shift, int velocity, int64_t time=0, bool gui=true);
+void keyPress  (MidiChannel*   ch, bool ctrl, bool shift, int64_t time=0, bool gui=true);
+void keyRelease(Channel*       ch, bool ctrl, bool shift, int64_t time=0);
+void keyRelease(SampleChannel* ch, bool ctrl, bool shift, int64_t time=0);
+
+/* replay
+Makes again the call that produced an event captured by m::eventLog. Called by
+the null sound system before each block, outside of the FLTK lock. */
 
-void keyPress  (Channel*       ch, bool ctrl, bool shift, int velocity);
-void keyPress  (SampleChannel* ch, bool ctrl, bool shift, int velocity);
-void keyPress  (MidiChannel*   ch, bool ctrl, bool shift);
-void keyRelease(Channel*       ch, bool ctrl, bool shift);
-void keyRelease(SampleChannel* ch, bool ctrl, bool shift);
+void replay(const m::eventLog::Event& e);
 
 /* start/stopActionRec
 Handles the action recording. If gui == true the signal comes from an user
@@ -42,6 +42,8 @@
 #include "../core/kernelMidi.h"
 #include "../core/kernelAudio.h"
 #include "../core/conf.h"
+#include "../core/eventLog.h"
+#include "../core/renderer.h"
 #ifdef WITH_VST
 #include "../core/pluginHost.h"
 #endif
@@ -61,6 +63,8 @@ void glue_setBpm(const char *v1, const char *v2)
 	if (mixer::recording)
 		return;
 
+	eventLog::capture(eventLog::BPM, atoi(v1), atoi(v2));
+
 	char  bpmS[6];
 	float bpmF = atof(v1) + (atof(v2)/10);
 	if (bpmF < 20.0f) {
@@ -115,6 +119,8 @@ void glue_setBeats(int beats, int bars, bool expand)
 	if (mixer::recording)
 		return;
 
+	eventLog::capture(eventLog::BEATS, beats, bars, expand);
+
 	/* Temp vars to store old data (they are necessary) */
 
 	int oldBeats = clock::getBeats();
@@ -141,6 +147,8 @@ void glue_setBeats(int beats, int bars, bool expand)
 
 void glue_rewindSeq(bool gui, bool notifyJack)
 {
+	eventLog::capture(eventLog::REWIND);
+
 	mh::rewindSequencer();
 
 	/* FIXME - potential desync when Quantizer is enabled from this point on.
@@ -202,7 +210,8 @@ void glue_clearAllSamples()
 	clock::stop();
 	for (Channel* ch : mixer::channels) {
 		ch->empty();
-		ch->guiChannel->reset();
+		if (ch->guiChannel != nullptr)
+			ch->guiChannel->reset();
 	}
 	recorder::init();
 	return;
@@ -226,6 +235,7 @@ void glue_clearAllActions()
 
 void glue_resetToInitState(bool resetGui, bool createColumns)
 {
+	renderer::waitStems(true);  // its copies use the pool and plug-ins freed below
 	gu_closeAllSubwindows();
 	mixer::close();
 	clock::init(conf::samplerate, conf::midiTCfps);
@@ -35,6 +35,7 @@
 #include "../core/const.h"
 #include "../core/conf.h"
 #include "../utils/gui.h"
+#include "../utils/log.h"
 #include "../gui/dialogs/gd_mainWindow.h"
 #include "../gui/dialogs/pluginWindow.h"
 #include "../gui/dialogs/pluginList.h"
@@ -82,7 +83,8 @@ Plugin* addPlugin(Channel* ch, int index, int stackType)
 {
   if (index >= pluginHost::countAvailablePlugins())
     return nullptr;
-  return pluginHost::addPlugin(index, stackType, &mixer::mutex_plugins, ch);
+  return pluginHost::addPlugin(index, stackType,
+    mixer::getPluginMutex(stackType), ch);
 }
 
 
@@ -91,8 +93,8 @@ Plugin* addPlugin(Channel* ch, int index, int stackType)
 
 void swapPlugins(Channel* ch, int index1, int index2, int stackType)
 {
-  pluginHost::swapPlugin(index1, index2, stackType, &mixer::mutex_plugins,
-    ch);
+  pluginHost::swapPlugin(index1, index2, stackType,
+    mixer::getPluginMutex(stackType), ch);
 }
 
 
@@ -101,7 +103,8 @@ void swapPlugins(Channel* ch, int index1, int index2, int stackType)
 
 void freePlugin(Channel* ch, int index, int stackType)
 {
-  pluginHost::freePlugin(index, stackType, &mixer::mutex_plugins, ch);
+  pluginHost::freePlugin(index, stackType, mixer::getPluginMutex(stackType),
+    ch);
 }
 
 
@@ -132,11 +135,19 @@ void setProgram(Plugin* p, int index)
 
 void setParameter(Plugin* p, int index, float value, bool gui)
 {
-	p->setParameter(index, value);
+	/* The change is applied by the audio thread at the beginning of the next 
+	block: never touch the plug-in from here, it might be in the middle of 
+	processBlock(). */
+
+	if (!p->postParameter(index, value, gui)) {
+		gu_log("[plugin::setParameter] parameter queue full, change dropped\n");
+		return;
+	}
 
 	/* No need to update plug-in editor if it has one: the plug-in's editor takes
 	care of it on its own. Conversely, update the specific parameter for UI-less 
-	plug-ins. */
+	plug-ins. The plug-in still holds the old value at this point: pass the new
+	one along. */
 
 	if (p->hasEditor())
 		return;
@@ -146,7 +157,7 @@ void setParameter(Plugin* p, int index, float value, bool gui)
 		return;
 
 	Fl::lock();
-	child->updateParameter(index, !gui);
+	child->updateParameter(index, value, !gui);
 	Fl::unlock();
 }
 
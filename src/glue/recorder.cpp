@@ -25,6 +25,8 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <array>
+#include <limits>
 #include "../gui/dialogs/gd_warnings.h"
 #include "../gui/elems/mainWindow/keyboard/channel.h"
 #include "../gui/elems/mainWindow/keyboard/sampleChannel.h"
@@ -149,60 +151,60 @@ void recordMidiAction(int chan, int note, int frame_a, int frame_b)
 /* -------------------------------------------------------------------------- */
 
 
-vector<m::recorder::Composite> getMidiActions(int chan, int frameLimit)
+vector<m::recorder::Composite> getMidiActions(int chan, int frameA, int frameB)
 {
 	vector<m::recorder::Composite> out;
 
-	m::recorder::sortActions();
+	/* Pair Note On and Note Off events in a single pass over the channel. Each 
+	Note On waits in 'pending' (one list per note) until a Note Off of the same 
+	note closes it: velocity is ignored. A Note Off closes any Note On that comes
+	strictly before it, so overlapping notes end on the same Note Off. */
 
-	for (unsigned i=0; i<m::recorder::frames.size(); i++) {
+	std::array<vector<m::recorder::action>, G_MIDI_NOTES> pending;
 
-		if (m::recorder::frames.at(i) > frameLimit)
-			continue;
-
-		for (unsigned j=0; j<m::recorder::global.at(i).size(); j++) {
-
-			m::recorder::action* a1 = m::recorder::global.at(i).at(j);
-			m::recorder::action* a2 = nullptr;
-
-			m::MidiEvent a1midi(a1->iValue);
-
-			/* Skip action if:
-				- does not belong to this channel
-				- is not a MIDI action (we only want MIDI things here)
-				- is not a MIDI Note On type. We don't want any other kind of action here */
-
-			if (a1->chan != chan || a1->type != G_ACTION_MIDI || 
-				  a1midi.getStatus() != m::MidiEvent::NOTE_ON)
-				continue;
-
-			/* Prepare the composite action. Action 1 exists for sure, so fill it up
-			right away. */
-
-			m::recorder::Composite cmp; 
-			cmp.a1 = *a1;
-
-			/* Search for the next action. Must have: same channel, G_ACTION_MIDI,
-			greater than a1->frame and with MIDI properties of note_off (0x80), same
-			note of a1 and random velocity: we don't care about it (and so we mask it
-			with 0x0000FF00). */
-
-			m::MidiEvent a2midi(m::MidiEvent::NOTE_OFF, a1midi.getNote(), 0x0);
-
-			m::recorder::getNextAction(chan, G_ACTION_MIDI, a1->frame, &a2, 
-				a2midi.getRaw(), 0x0000FF00);
-
-			/* If action 2 has been found, add it to the composite duo. Otherwise
-			set the action 2 frame to -1: it should be intended as "orphaned". */
+	auto keep = [&] (const m::recorder::Composite& cmp)
+	{
+		int end = cmp.a2.frame != -1 ? cmp.a2.frame : cmp.a1.frame;
+		if (cmp.a1.frame < frameB && end >= frameA)
+			out.push_back(cmp);
+	};
+
+	m::recorder::forEachAction(chan, 0, std::numeric_limits<int>::max(), 
+		[&] (const m::recorder::action* a)
+	{
+		if (a->type != G_ACTION_MIDI)
+			return;
+
+		m::MidiEvent e(a->iValue);
+		vector<m::recorder::action>& notes = pending[e.getNote() % G_MIDI_NOTES];
+
+		if (e.getStatus() == m::MidiEvent::NOTE_ON)
+			notes.push_back(*a);
+		else
+		if (e.getStatus() == m::MidiEvent::NOTE_OFF) {
+			unsigned closed = 0;
+			for (const m::recorder::action& on : notes) {
+				if (on.frame >= a->frame)
+					break;
+				m::recorder::Composite cmp;
+				cmp.a1 = on;
+				cmp.a2 = *a;
+				keep(cmp);
+				closed++;
+			}
+			notes.erase(notes.begin(), notes.begin() + closed);
+		}
+	});
 
-			if (a2 != nullptr)
-				cmp.a2 = *a2;
-			else
-				cmp.a2.frame = -1;
+	/* Whatever is left has no Note Off: orphaned actions, with a2.frame == -1. */
 
-			out.push_back(cmp);
+	for (const vector<m::recorder::action>& notes : pending)
+		for (const m::recorder::action& on : notes) {
+			m::recorder::Composite cmp;
+			cmp.a1 = on;
+			cmp.a2.frame = -1;
+			keep(cmp);
 		}
-	}
 
 	return out;
 }
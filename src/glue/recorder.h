@@ -53,10 +53,11 @@ void recordMidiAction(int chan, int note, int frame_a, int frame_b=0);
 
 /* getMidiActions
 Returns a list of Composite actions, ready to be displayed in a MIDI note
-editor as pairs of NoteOn+NoteOff. */
+editor as pairs of NoteOn+NoteOff. Only those overlapping the range of frames
+[frameA, frameB) are returned. */
 
 std::vector<giada::m::recorder::Composite> getMidiActions(int channel, 
-	int frameLimit);
+	int frameA, int frameB);
 
 }}} // giada::c::recorder::
 
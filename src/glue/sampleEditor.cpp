@@ -270,7 +270,7 @@ void rewindPreview(SampleChannel* ch)
 void toNewChannel(SampleChannel* ch, int a, int b)
 {
 	SampleChannel* newCh = static_cast<SampleChannel*>(c::channel::addChannel(
-		ch->guiChannel->getColumnIndex(), G_CHANNEL_SAMPLE, G_GUI_CHANNEL_H_1));
+		ch->column, G_CHANNEL_SAMPLE, G_GUI_CHANNEL_H_1));
 
 	Wave* wave = nullptr;
 	int result = m::waveManager::createFromWave(ch->wave, a, b, &wave);
@@ -280,7 +280,8 @@ void toNewChannel(SampleChannel* ch, int a, int b)
 	}
 
 	newCh->pushWave(wave);
-	newCh->guiChannel->update();
+	if (newCh->guiChannel != nullptr)
+		newCh->guiChannel->update();
 }
 
 
@@ -37,6 +37,7 @@
 #include "../core/waveManager.h"
 #include "../core/clock.h"
 #include "../core/wave.h"
+#include "../core/columnBus.h"
 #include "../utils/gui.h"
 #include "../utils/log.h"
 #include "../utils/string.h"
@@ -50,6 +51,7 @@
 #include "../gui/dialogs/browser/browserLoad.h"
 #include "main.h"
 #include "channel.h"
+#include "column.h"
 #include "storage.h"
 
 
@@ -71,7 +73,8 @@ static void glue_fillPatchGlobalsPlugins__(vector <Plugin*>* host, vector<m::pat
 		Plugin *pl = host->at(i);
 		patch::plugin_t ppl;
 		ppl.path = pl->getUniqueId();
-		ppl.bypass = pl->isBypassed();
+		ppl.bypass    = pl->isBypassed();
+		ppl.keepAwake = pl->isKeptAwake();
 		int numParams = pl->getNumParameters();
 		for (int k=0; k<numParams; k++)
 			ppl.params.push_back(pl->getParameter(k));
@@ -92,8 +95,18 @@ static void glue_fillPatchColumns__()
 	for (unsigned i=0; i<G_MainWin->keyboard->getTotalColumns(); i++) {
 		geColumn *gCol = G_MainWin->keyboard->getColumn(i);
 		patch::column_t pCol;
-		pCol.index = gCol->getIndex();
-		pCol.width = gCol->w();
+		pCol.index     = gCol->getIndex();
+		pCol.width     = gCol->w();
+		pCol.bus       = gCol->bus != nullptr;
+		pCol.busVolume = G_DEFAULT_VOL;
+		pCol.busMute   = false;
+		if (gCol->bus != nullptr) {
+			pCol.busVolume = gCol->bus->volume;
+			pCol.busMute   = gCol->bus->mute;
+#ifdef WITH_VST
+			glue_fillPatchGlobalsPlugins__(&gCol->bus->plugins, &pCol.busPlugins);
+#endif
+		}
 		for (int k=0; k<gCol->countChannels(); k++) {
 			Channel *colChannel = gCol->getChannel(k);
 			for (unsigned j=0; j<mixer::channels.size(); j++) {
@@ -148,6 +161,9 @@ static void glue_fillPatchGlobals__(const string &name)
 			&patch::masterInPlugins);
 	glue_fillPatchGlobalsPlugins__(pluginHost::getStack(pluginHost::MASTER_OUT),
 			&patch::masterOutPlugins);
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		glue_fillPatchGlobalsPlugins__(pluginHost::getStack(pluginHost::SEND_BUS + i),
+				&patch::sendBusPlugins[i]);
 
 #endif
 }
@@ -278,8 +294,15 @@ void glue_loadPatch(void* data)
 
 	float steps = 0.8 / patch::channels.size();
 	
-	for (const patch::column_t& col : patch::columns) {
+	for (unsigned i=0; i<patch::columns.size(); i++) {
+		const patch::column_t& col = patch::columns.at(i);
 		G_MainWin->keyboard->addColumn(col.width);
+		if (col.bus) {
+			geColumn* gCol = G_MainWin->keyboard->getColumn(G_MainWin->keyboard->getTotalColumns() - 1);
+			c::column::setBus(gCol, true);
+			if (gCol->bus != nullptr)
+				mh::readPatchColumnBus(gCol->bus, i);
+		}
 		unsigned k = 0;
 		for (const patch::channel_t& pch : patch::channels) {
 			if (pch.column == col.index) {
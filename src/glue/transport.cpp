@@ -33,6 +33,7 @@
 #include "../core/mixerHandler.h"
 #include "../core/mixer.h"
 #include "../core/recorder.h"
+#include "../core/eventLog.h"
 #include "transport.h"
 
 
@@ -53,6 +54,8 @@ void glue_startStopSeq(bool gui)
 
 void glue_startSeq(bool gui)
 {
+	eventLog::capture(eventLog::START);
+
 	clock::start();
 
 #ifdef __linux__
@@ -72,6 +75,8 @@ void glue_startSeq(bool gui)
 
 void glue_stopSeq(bool gui)
 {
+	eventLog::capture(eventLog::STOP);
+
 	mh::stopSequencer();
 
 #ifdef __linux__
@@ -0,0 +1,112 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifdef WITH_VST
+
+
+#include "../../glue/channel.h"
+#include "../../utils/gui.h"
+#include "../../utils/string.h"
+#include "../../core/const.h"
+#include "../../core/channel.h"
+#include "../../core/pluginHost.h"
+#include "../elems/basics/box.h"
+#include "../elems/basics/dial.h"
+#include "../elems/basics/button.h"
+#include "gd_mainWindow.h"
+#include "pluginList.h"
+#include "channelSends.h"
+
+
+extern gdMainWindow* G_MainWin;
+
+
+using std::string;
+using namespace giada;
+
+
+gdChannelSends::gdChannelSends(Channel* ch)
+: gdWindow(204, (G_GUI_UNIT * G_MAX_SEND_BUSES) + (G_GUI_INNER_MARGIN * 
+		(G_MAX_SEND_BUSES - 1)) + (G_GUI_OUTER_MARGIN * 2)),
+  m_ch    (ch)
+{
+	for (int i=0; i<G_MAX_SEND_BUSES; i++) {
+		int y = G_GUI_OUTER_MARGIN + (i * (G_GUI_UNIT + G_GUI_INNER_MARGIN));
+		m_labels[i] = new geBox(G_GUI_OUTER_MARGIN, y, 140, G_GUI_UNIT, "", FL_ALIGN_LEFT);
+		m_levels[i] = new geDial(m_labels[i]->x()+m_labels[i]->w()+G_GUI_INNER_MARGIN, y, G_GUI_UNIT, G_GUI_UNIT);
+		m_fxs[i]    = new geButton(m_levels[i]->x()+m_levels[i]->w()+G_GUI_INNER_MARGIN, y, G_GUI_UNIT, G_GUI_UNIT, "fx");
+
+		string l = "Send to bus " + gu_iToString(i + 1);
+		m_labels[i]->copy_label(l.c_str());
+
+		m_levels[i]->value(m_ch->sendLevels[i]);
+		m_levels[i]->callback(cb_setLevel, (void*)this);
+		m_fxs[i]->callback(cb_openBusFx, (void*)this);
+	}
+	end();
+
+	string l = "Channel " + gu_iToString(m_ch->index + 1) + " Sends";
+	copy_label(l.c_str());
+
+	gu_setFavicon(this);
+	setId(WID_CHANNEL_SENDS);
+	show();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdChannelSends::cb_setLevel (Fl_Widget* w, void* p) { ((gdChannelSends*)p)->cb_setLevel(w); }
+void gdChannelSends::cb_openBusFx(Fl_Widget* w, void* p) { ((gdChannelSends*)p)->cb_openBusFx(w); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdChannelSends::cb_setLevel(Fl_Widget* w)
+{
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		if (w == m_levels[i])
+			c::channel::setSendLevel(m_ch, i, m_levels[i]->value());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdChannelSends::cb_openBusFx(Fl_Widget* w)
+{
+	for (int i=0; i<G_MAX_SEND_BUSES; i++)
+		if (w == m_fxs[i])
+			gu_openSubWindow(G_MainWin, new gdPluginList(m::pluginHost::SEND_BUS + i), 
+				WID_FX_LIST);
+}
+
+
+#endif // #ifdef WITH_VST
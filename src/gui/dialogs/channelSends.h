@@ -0,0 +1,67 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifdef WITH_VST
+
+#ifndef GD_CHANNEL_SENDS_H
+#define GD_CHANNEL_SENDS_H
+
+
+#include "../../core/const.h"
+#include "window.h"
+
+
+class Channel;
+class geBox;
+class geDial;
+class geButton;
+
+
+class gdChannelSends : public gdWindow
+{
+private:
+
+	static void cb_setLevel (Fl_Widget* w, void* p);
+	static void cb_openBusFx(Fl_Widget* w, void* p);
+	void cb_setLevel (Fl_Widget* w);
+	void cb_openBusFx(Fl_Widget* w);
+
+	Channel* m_ch;
+
+	geBox*    m_labels[G_MAX_SEND_BUSES];
+	geDial*   m_levels[G_MAX_SEND_BUSES];
+	geButton* m_fxs[G_MAX_SEND_BUSES];
+
+public:
+
+	gdChannelSends(Channel* ch);
+};
+
+#endif
+
+#endif // #ifdef WITH_VST
@@ -0,0 +1,125 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#include "../../glue/column.h"
+#include "../../utils/gui.h"
+#include "../../utils/string.h"
+#include "../../core/const.h"
+#include "../../core/graphics.h"
+#include "../../core/columnBus.h"
+#ifdef WITH_VST
+#include "../../core/pluginHost.h"
+#endif
+#include "../elems/basics/box.h"
+#include "../elems/basics/dial.h"
+#include "../elems/basics/button.h"
+#include "../elems/mainWindow/keyboard/column.h"
+#include "gd_mainWindow.h"
+#include "pluginList.h"
+#include "columnBus.h"
+
+
+extern gdMainWindow* G_MainWin;
+
+
+using std::string;
+using namespace giada;
+
+
+gdColumnBus::gdColumnBus(geColumn* col)
+: gdWindow(204, G_GUI_UNIT + (G_GUI_OUTER_MARGIN * 2)),
+  m_col   (col)
+{
+	m_label  = new geBox(G_GUI_OUTER_MARGIN, G_GUI_OUTER_MARGIN, 100, G_GUI_UNIT, "Volume", FL_ALIGN_LEFT);
+	m_volume = new geDial(m_label->x()+m_label->w()+G_GUI_INNER_MARGIN, G_GUI_OUTER_MARGIN, G_GUI_UNIT, G_GUI_UNIT);
+	m_mute   = new geButton(m_volume->x()+m_volume->w()+G_GUI_INNER_MARGIN, G_GUI_OUTER_MARGIN, G_GUI_UNIT, G_GUI_UNIT, "", muteOff_xpm, muteOn_xpm);
+#ifdef WITH_VST
+	m_fx     = new geButton(m_mute->x()+m_mute->w()+G_GUI_INNER_MARGIN, G_GUI_OUTER_MARGIN, G_GUI_UNIT, G_GUI_UNIT, "fx");
+#endif
+	end();
+
+	m_volume->value(m_col->bus->volume);
+	m_volume->callback(cb_setVolume, (void*)this);
+
+	m_mute->type(FL_TOGGLE_BUTTON);
+	m_mute->value(m_col->bus->mute);
+	m_mute->callback(cb_mute, (void*)this);
+
+#ifdef WITH_VST
+	m_fx->callback(cb_openFx, (void*)this);
+#endif
+
+	string l = "Column " + gu_iToString(m_col->getIndex() + 1) + " Group Bus";
+	copy_label(l.c_str());
+
+	gu_setFavicon(this);
+	setId(WID_COLUMN_BUS);
+	show();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdColumnBus::cb_setVolume(Fl_Widget* w, void* p) { ((gdColumnBus*)p)->cb_setVolume(); }
+void gdColumnBus::cb_mute     (Fl_Widget* w, void* p) { ((gdColumnBus*)p)->cb_mute(); }
+#ifdef WITH_VST
+void gdColumnBus::cb_openFx   (Fl_Widget* w, void* p) { ((gdColumnBus*)p)->cb_openFx(); }
+#endif
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdColumnBus::cb_setVolume()
+{
+	c::column::setBusVolume(m_col, m_volume->value());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdColumnBus::cb_mute()
+{
+	c::column::toggleBusMute(m_col);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+#ifdef WITH_VST
+
+void gdColumnBus::cb_openFx()
+{
+	gu_openSubWindow(G_MainWin, new gdPluginList(m::pluginHost::COLUMN_BUS + 
+		m_col->bus->id), WID_FX_LIST);
+}
+
+#endif
@@ -0,0 +1,70 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+#ifndef GD_COLUMN_BUS_H
+#define GD_COLUMN_BUS_H
+
+
+#include "window.h"
+
+
+class geColumn;
+class geBox;
+class geDial;
+class geButton;
+
+
+class gdColumnBus : public gdWindow
+{
+private:
+
+	static void cb_setVolume(Fl_Widget* w, void* p);
+	static void cb_mute     (Fl_Widget* w, void* p);
+	void cb_setVolume();
+	void cb_mute();
+#ifdef WITH_VST
+	static void cb_openFx(Fl_Widget* w, void* p);
+	void cb_openFx();
+#endif
+
+	geColumn* m_col;
+
+	geBox*    m_label;
+	geDial*   m_volume;
+	geButton* m_mute;
+#ifdef WITH_VST
+	geButton* m_fx;
+#endif
+
+public:
+
+	gdColumnBus(geColumn* col);
+};
+
+
+#endif
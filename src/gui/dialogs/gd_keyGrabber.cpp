@@ -97,7 +97,8 @@ void gdKeyGrabber::__cb_clear()
 
 void gdKeyGrabber::setButtonLabel(int key)
 {
-	ch->guiChannel->mainButton->setKey(key);
+	if (ch->guiChannel != nullptr)
+		ch->guiChannel->mainButton->setKey(key);
 	ch->key = key;
 }
 
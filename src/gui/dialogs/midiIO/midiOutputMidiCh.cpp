@@ -118,6 +118,7 @@ void gdMidiOutputMidiCh::__cb_close()
 	ch->midiOut     = enableOut->value();
 	ch->midiOutChan = chanListOut->value();
 	ch->midiOutL    = enableLightning->value();
-	ch->guiChannel->update();
+	if (ch->guiChannel != nullptr)
+		ch->guiChannel->update();
 	do_callback();
 }
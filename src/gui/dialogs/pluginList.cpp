@@ -89,6 +89,14 @@ gdPluginList::gdPluginList(int stackType, Channel* ch)
 	else
 	if (stackType == pluginHost::MASTER_IN)
 		label("Master In Plugins");
+	else
+	if (stackType >= pluginHost::COLUMN_BUS)
+		label("Column Group Bus Plugins");
+	else
+	if (stackType >= pluginHost::SEND_BUS) {
+		string l = "Send Bus " + gu_iToString(stackType - pluginHost::SEND_BUS + 1) + " Plugins";
+		copy_label(l.c_str());
+	}
 	else {
 		string l = "Channel " + gu_iToString(ch->index+1) + " Plugins";
 		copy_label(l.c_str());
@@ -208,7 +216,8 @@ void gdPluginList::refreshList()
 		G_MainWin->mainIO->setMasterFxInFull(
 			pluginHost::countPlugins(stackType, ch) > 0);
 	}
-	else {
+	else
+	if (stackType == pluginHost::CHANNEL && ch->guiChannel != nullptr) {
 		ch->guiChannel->fx->status = pluginHost::countPlugins(stackType, ch) > 0;
 		ch->guiChannel->fx->redraw();
 	}
@@ -225,9 +234,10 @@ gdPlugin::gdPlugin(gdPluginList* gdp, Plugin* p, int X, int Y, int W)
 {
 	begin();
 	button    = new geIdButton(8, y(), 220, 20);
-	program   = new geChoice(button->x()+button->w()+4, y(), 132, 20);
+	program   = new geChoice(button->x()+button->w()+4, y(), 108, 20);
 	bypass    = new geIdButton(program->x()+program->w()+4, y(), 20, 20);
-	shiftUp   = new geIdButton(bypass->x()+bypass->w()+4, y(), 20, 20, "", fxShiftUpOff_xpm, fxShiftUpOn_xpm);
+	keepAwake = new geIdButton(bypass->x()+bypass->w()+4, y(), 20, 20, "A");
+	shiftUp   = new geIdButton(keepAwake->x()+keepAwake->w()+4, y(), 20, 20, "", fxShiftUpOff_xpm, fxShiftUpOn_xpm);
 	shiftDown = new geIdButton(shiftUp->x()+shiftUp->w()+4, y(), 20, 20, "", fxShiftDownOff_xpm, fxShiftDownOn_xpm);
 	remove    = new geIdButton(shiftDown->x()+shiftDown->w()+4, y(), 20, 20, "", fxRemoveOff_xpm, fxRemoveOn_xpm);
 	end();
@@ -251,6 +261,13 @@ gdPlugin::gdPlugin(gdPluginList* gdp, Plugin* p, int X, int Y, int W)
 	bypass->type(FL_TOGGLE_BUTTON);
 	bypass->value(pPlugin->isBypassed() ? 0 : 1);
 
+	/* Keep awake: process the plug-in even when its input is silent. Useful for 
+	generators, LFO-driven effects and the like. */
+
+	keepAwake->callback(cb_setKeepAwake, (void*)this);
+	keepAwake->type(FL_TOGGLE_BUTTON);
+	keepAwake->value(pPlugin->isKeptAwake() ? 1 : 0);
+
 	shiftUp->callback(cb_shiftUp, (void*)this);
 	shiftDown->callback(cb_shiftDown, (void*)this);
 	remove->callback(cb_removePlugin, (void*)this);
@@ -263,6 +280,7 @@ gdPlugin::gdPlugin(gdPluginList* gdp, Plugin* p, int X, int Y, int W)
 void gdPlugin::cb_removePlugin    (Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_removePlugin(); }
 void gdPlugin::cb_openPluginWindow(Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_openPluginWindow(); }
 void gdPlugin::cb_setBypass       (Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_setBypass(); }
+void gdPlugin::cb_setKeepAwake    (Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_setKeepAwake(); }
 void gdPlugin::cb_shiftUp         (Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_shiftUp(); }
 void gdPlugin::cb_shiftDown       (Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_shiftDown(); }
 void gdPlugin::cb_setProgram      (Fl_Widget* v, void* p) { ((gdPlugin*)p)->cb_setProgram(); }
@@ -367,6 +385,15 @@ void gdPlugin::cb_setBypass()
 /* -------------------------------------------------------------------------- */
 
 
+void gdPlugin::cb_setKeepAwake()
+{
+	pPlugin->toggleKeepAwake();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void gdPlugin::cb_setProgram()
 {
 	//pPlugin->setCurrentProgram(program->value());
@@ -55,7 +55,7 @@ private:
 
 public:
 
-	Channel *ch;      // ch == nullptr ? masterOut
+	Channel *ch;      // ch == nullptr ? master in/out or send bus
 	int stackType;
 
 	gdPluginList(int stackType, Channel *ch=nullptr);
@@ -83,12 +83,14 @@ private:
 	static void cb_removePlugin(Fl_Widget *v, void *p);
 	static void cb_openPluginWindow(Fl_Widget *v, void *p);
 	static void cb_setBypass(Fl_Widget *v, void *p);
+	static void cb_setKeepAwake(Fl_Widget *v, void *p);
 	static void cb_shiftUp(Fl_Widget *v, void *p);
 	static void cb_shiftDown(Fl_Widget *v, void *p);
 	static void cb_setProgram(Fl_Widget *v, void *p);
 	void cb_removePlugin();
 	void cb_openPluginWindow();
 	void cb_setBypass();
+	void cb_setKeepAwake();
 	void cb_shiftUp();
 	void cb_shiftDown();
 	void cb_setProgram();
@@ -98,6 +100,7 @@ public:
 	geIdButton *button;
 	geChoice    *program;
 	geIdButton *bypass;
+	geIdButton *keepAwake;
 	geIdButton *shiftUp;
 	geIdButton *shiftDown;
 	geIdButton *remove;
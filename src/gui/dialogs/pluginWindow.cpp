@@ -71,9 +71,9 @@ gdPluginWindow::gdPluginWindow(Plugin* p)
 /* -------------------------------------------------------------------------- */
 
 
-void gdPluginWindow::updateParameter(int index, bool changeSlider)
+void gdPluginWindow::updateParameter(int index, float value, bool changeSlider)
 {
-	static_cast<gePluginParameter*>(m_list->child(index))->update(changeSlider);
+	static_cast<gePluginParameter*>(m_list->child(index))->update(value, changeSlider);
 }
 
 
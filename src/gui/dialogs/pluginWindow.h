@@ -54,7 +54,11 @@ public:
 
 	gdPluginWindow(Plugin* p);
 
-	void updateParameter(int index, bool changeSlider=false);
+	/* updateParameter
+	Refreshes parameter 'index' after a change to 'value', not yet applied to the
+	plug-in by the audio thread. */
+
+	void updateParameter(int index, float value, bool changeSlider=false);
 	void updateParameters(bool changeSlider=false);
 };
 
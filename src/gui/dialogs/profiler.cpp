@@ -0,0 +1,250 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#include <cstdio>
+#include <fstream>
+#include <FL/Fl_Browser.H>
+#include "../../core/const.h"
+#include "../../core/mixer.h"
+#include "../../core/channel.h"
+#include "../../core/profiler.h"
+#ifdef WITH_VST
+#include "../../core/plugin.h"
+#include "../../core/pluginHost.h"
+#endif
+#include "../../utils/gui.h"
+#include "../../utils/fs.h"
+#include "../../utils/string.h"
+#include "../elems/basics/boxtypes.h"
+#include "../elems/basics/box.h"
+#include "../elems/basics/button.h"
+#include "gd_warnings.h"
+#include "profiler.h"
+
+
+using std::string;
+using std::vector;
+using namespace giada::m;
+
+
+namespace
+{
+/* toUs
+Nanoseconds to a string in microseconds. */
+
+string toUs(int64_t ns)
+{
+	char buf[32];
+	snprintf(buf, sizeof(buf), "%.1f", ns / 1000.0);
+	return buf;
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+gdProfiler::gdProfiler()
+: gdWindow(480, 300, "DSP profiler"),
+  m_widths {120, 170, 56, 56, 56, 0}
+{
+	set_non_modal();
+
+	m_summary = new geBox(8, 8, w()-16, G_GUI_UNIT, "", FL_ALIGN_LEFT | FL_ALIGN_INSIDE);
+	m_list    = new Fl_Browser(8, m_summary->y()+m_summary->h()+8, w()-16, 
+		h()-G_GUI_UNIT*2-32);
+	m_export  = new geButton(w()-88, m_list->y()+m_list->h()+8, 80, G_GUI_UNIT, "Export...");
+	m_reset   = new geButton(m_export->x()-88, m_export->y(), 80, G_GUI_UNIT, "Reset");
+	end();
+
+	m_list->box(G_CUSTOM_BORDER_BOX);
+	m_list->textsize(G_GUI_FONT_SIZE_BASE);
+	m_list->textcolor(G_COLOR_LIGHT_2);
+	m_list->selection_color(G_COLOR_GREY_4);
+	m_list->color(G_COLOR_GREY_2);
+	m_list->scrollbar.color(G_COLOR_GREY_2);
+	m_list->scrollbar.selection_color(G_COLOR_GREY_4);
+	m_list->scrollbar.labelcolor(G_COLOR_LIGHT_1);
+	m_list->scrollbar.slider(G_CUSTOM_BORDER_BOX);
+	m_list->column_widths(m_widths);
+	m_list->column_char('\t');
+
+	m_reset->callback(cb_reset, (void*)this);
+	m_export->callback(cb_export, (void*)this);
+
+	resizable(m_list);
+
+	profiler::reset();
+	profiler::setEnabled(true);
+	refresh();
+
+	gu_setFavicon(this);
+	setId(WID_PROFILER);
+	show();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+gdProfiler::~gdProfiler()
+{
+	profiler::setEnabled(false);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdProfiler::cb_reset (Fl_Widget* w, void* p) { ((gdProfiler*)p)->cb_reset(); }
+void gdProfiler::cb_export(Fl_Widget* w, void* p) { ((gdProfiler*)p)->cb_export(); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdProfiler::cb_reset()
+{
+	profiler::reset();
+	refresh();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdProfiler::cb_export()
+{
+	string path = gu_getHomePath() + G_SLASH + "giada-profile.txt";
+
+	std::ofstream f(path);
+	f << getSummary() << "\n\n";
+	for (const string& l : getLines())
+		f << l << "\n";
+	f.close();
+
+	if (!f) {
+		gdAlert("Unable to write the profiler report.");
+		return;
+	}
+	string msg = "Profiler report saved to " + path;
+	gdAlert(msg.c_str());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gdProfiler::refresh()
+{
+	string summary = getSummary();
+	m_summary->copy_label(summary.c_str());
+
+	int top = m_list->topline();
+	m_list->clear();
+	m_list->add("STAGE\tSOURCE\tCOUNT\tP50 (us)\tP99 (us)\tMAX (us)");
+	for (const string& l : getLines())
+		m_list->add(l.c_str());
+	m_list->topline(top);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+string gdProfiler::getSummary() const
+{
+	char buf[128];
+	snprintf(buf, sizeof(buf), "DSP load: %.1f%% avg, %.1f%% max - xruns: %d - dropped: %d",
+		profiler::getLoadAvg(), profiler::getLoadMax(), profiler::getXruns(), 
+		profiler::getDropped());
+	return buf;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+vector<string> gdProfiler::getLines() const
+{
+	vector<string> out;
+	for (const profiler::Stats& s : profiler::getStats())
+		out.push_back(profiler::getStageName(s.stage) + "\t" + 
+			getSource(s.stage, s.stack, s.chan, s.id) + "\t" + 
+			gu_iToString(s.count) + "\t" + toUs(s.p50) + "\t" + toUs(s.p99) + "\t" + 
+			toUs(s.max));
+	return out;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+string gdProfiler::getSource(int stage, int stack, int chan, int id) const
+{
+	const Channel* ch = nullptr;
+	for (const Channel* c : mixer::channels)
+		if (c->index == chan)
+			ch = c;
+
+	string chName;
+	if (chan != -1)
+		chName = ch == nullptr ? "(deleted)" : ch->name.empty() ? 
+			"channel " + gu_iToString(chan) : ch->name;
+
+	if (stage == profiler::CHANNEL)
+		return chName;
+	if (stage != profiler::PLUGIN)
+		return "";
+
+#ifdef WITH_VST
+	/* The plug-in might be gone, along with its stack. */
+
+	string plName = "plug-in #" + gu_iToString(id);
+	if (stack != pluginHost::CHANNEL || ch != nullptr) {
+		vector<Plugin*>* plugins = pluginHost::getStack(stack, const_cast<Channel*>(ch));
+		if (plugins != nullptr)
+			for (const Plugin* p : *plugins)
+				if (p->getId() == id)
+					plName = p->getName();
+	}
+
+	if (stack == pluginHost::CHANNEL)
+		return plName + " (" + chName + ")";
+	if (stack == pluginHost::MASTER_OUT)
+		return plName + " (master out)";
+	if (stack == pluginHost::MASTER_IN)
+		return plName + " (master in)";
+	if (stack < pluginHost::COLUMN_BUS)
+		return plName + " (send " + gu_iToString(stack - pluginHost::SEND_BUS + 1) + ")";
+	return plName + " (column bus)";
+#else
+	return "";
+#endif
+}
@@ -0,0 +1,88 @@
+/* -----------------------------------------------------------------------------
+ *
+ * Giada - Your Hardcore Loopmachine
+ *
+ * -----------------------------------------------------------------------------
+ *
+ * Copyright (C) 2010-2018 Giovanni A. Zuliani | Monocasual
+ *
+ * This file is part of Giada - Your Hardcore Loopmachine.
+ *
+ * Giada - Your Hardcore Loopmachine is free software: you can
+ * redistribute it and/or modify it under the terms of the GNU General
+ * Public License as published by the Free Software Foundation, either
+ * version 3 of the License, or (at your option) any later version.
+ *
+ * Giada - Your Hardcore Loopmachine is distributed in the hope that it
+ * will be useful, but WITHOUT ANY WARRANTY; without even the implied
+ * warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ * See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with Giada - Your Hardcore Loopmachine. If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * -------------------------------------------------------------------------- */
+
+
+
+
+#ifndef GD_PROFILER_H
+#define GD_PROFILER_H
+
+
+#include <string>
+#include <vector>
+#include "window.h"
+
+
+class Fl_Browser;
+class geBox;
+class geButton;
+
+
+/* gdProfiler
+Shows the timing of the audio callback, stage by stage. The profiler runs only 
+while this window is open. */
+
+class gdProfiler : public gdWindow
+{
+private:
+
+	static void cb_reset (Fl_Widget* w, void* p);
+	static void cb_export(Fl_Widget* w, void* p);
+	void cb_reset();
+	void cb_export();
+
+	/* getSummary, getLines
+	Text of the header and of each stage, shared by the window and the exported
+	report. Columns in getLines() are separated by tabs. */
+
+	std::string getSummary() const;
+	std::vector<std::string> getLines() const;
+
+	/* getSource
+	Channel or plug-in a stage refers to, if any. */
+
+	std::string getSource(int stage, int stack, int chan, int id) const;
+
+	geBox*      m_summary;
+	Fl_Browser* m_list;
+	geButton*   m_reset;
+	geButton*   m_export;
+
+	int m_widths[6];
+
+public:
+
+	gdProfiler();
+	~gdProfiler();
+
+	/* refresh
+	Rebuilds the list from the latest profiler statistics. */
+
+	void refresh();
+};
+
+
+#endif
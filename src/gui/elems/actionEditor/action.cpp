@@ -50,6 +50,7 @@ geAction::geAction(int X, int Y, int H, int frame_a, unsigned index,
   ch         (ch),
   type       (type),
   frame_a    (frame_a),
+  frame_b    (frame_a),
   onRightEdge(false),
   onLeftEdge (false)
 {
@@ -263,6 +264,15 @@ void geAction::moveAction(int frame_a)
 /* -------------------------------------------------------------------------- */
 
 
+char geAction::getType()
+{
+	return type;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 int geAction::absx()
 {
 	return x() - parent->ac->x();
@@ -61,6 +61,8 @@ public:
 
 	void moveAction(int frame_a=-1);
 
+	char getType();
+
 	/* absx
 	 * x() is relative to scrolling position. absx() returns the absolute
 	 * x value of the action, from the leftmost edge. */
@@ -25,8 +25,11 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <algorithm>
+#include <set>
 #include <FL/fl_draw.H>
 #include "../../../core/clock.h"
+#include "../../../core/recorder.h"
 #include "../../../core/sampleChannel.h"
 #include "../../dialogs/gd_mainWindow.h"
 #include "../../dialogs/gd_actionEditor.h"
@@ -49,46 +52,9 @@ geActionEditor::geActionEditor(int x, int y, gdActionEditor *pParent, SampleChan
 {
 	size(pParent->totalWidth, h());
 
-	/* add actions when the window opens. Their position is zoom-based;
-	 * each frame is / 2 because we don't care about stereo infos. */
-
-	for (unsigned i=0; i<recorder::frames.size(); i++) {
-		for (unsigned j=0; j<recorder::global.at(i).size(); j++) {
-
-		  recorder::action *action = recorder::global.at(i).at(j);
-
-      /* Don't show actions:
-      - that don't belong to the displayed channel (!= pParent->chan->index);
-      - that are covered by the grey area (> G_Mixer.totalFrames);
-      - of type G_ACTION_KILL in a SINGLE_PRESS channel. They cannot be
-        recorded in such mode, but they can exist if you change from another
-        mode to singlepress;
-      - of type G_ACTION_KEYREL in a SINGLE_PRESS channel. It's up to geAction to
-        find the other piece (namely frame_b)
-      - not of types G_ACTION_KEYPRESS | G_ACTION_KEYREL | G_ACTION_KILL */
-
-      if ((action->chan != pParent->chan->index)                          ||
-          (recorder::frames.at(i) > clock::getFramesInLoop())             ||
-          (action->type == G_ACTION_KILL && ch->mode == SINGLE_PRESS)     ||
-          (action->type == G_ACTION_KEYREL && ch->mode == SINGLE_PRESS)   ||
-          (action->type & ~(G_ACTION_KEYPRESS | G_ACTION_KEYREL | G_ACTION_KILL))
-      )
-        continue;
-
-			int ax = x + (action->frame / pParent->zoom);
-			geAction *a = new geAction(
-					ax,               // x
-					y + 4,            // y
-					h() - 8,          // h
-					action->frame,	  // frame_a
-					i,                // n. of recordings
-					pParent,          // pointer to the pParent window
-					ch,               // pointer to SampleChannel
-					false,            // record = false: don't record it, we are just displaying it!
-					action->type);    // type of action
-			add(a);
-		}
-	}
+	/* add actions when the window opens, only those in the visible area. */
+
+	loadActions(true);
 	end(); // mandatory when you add widgets to a fl_group, otherwise mega malfunctions
 }
 
@@ -132,6 +98,84 @@ void geActionEditor::updateActions()
 		else
 			a->resize(newX, a->y(), geAction::MIN_WIDTH, a->h());
 	}
+	loadActions();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geActionEditor::resize(int X, int Y, int W, int H)
+{
+	Fl_Group::resize(X, Y, W, H);
+	loadActions();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geActionEditor::loadActions(bool force)
+{
+	if (!updateLoadRange(force))
+		return;
+
+	/* Delete actions out of the loaded range, except the one being dragged. A
+	SINGLE_PRESS action spans up to its key release. Keep track of the others, 
+	so that they are not added twice. */
+
+	std::set<std::pair<int, char>> loaded;
+
+	for (int i=children(); i-- > 0;) {
+		geAction* a = static_cast<geAction*>(child(i));
+		int end = ch->mode == SINGLE_PRESS && a->getType() == G_ACTION_KEYPRESS ? 
+			a->frame_b : a->frame_a;
+		if (a == selected || (end >= loadedA && a->frame_a < loadedB)) {
+			loaded.insert({a->frame_a, a->getType()});
+			continue;
+		}
+		remove(a);
+		delete a;
+	}
+
+	/* A SINGLE_PRESS action is found by its key press: look back one screen 
+	more, for long ones starting before the range. */
+
+	int from = std::max(0, loadedA - (ch->mode == SINGLE_PRESS ? loadedB - loadedA : 0));
+	int to   = std::min(loadedB, clock::getFramesInLoop() + 1);
+
+	recorder::forEachAction(ch->index, from, to, [&] (const recorder::action* action)
+	{
+		/* Don't show actions:
+		- that are covered by the grey area (> G_Mixer.totalFrames);
+		- of type G_ACTION_KILL in a SINGLE_PRESS channel. They cannot be
+			recorded in such mode, but they can exist if you change from another
+			mode to singlepress;
+		- of type G_ACTION_KEYREL in a SINGLE_PRESS channel. It's up to geAction to
+			find the other piece (namely frame_b)
+		- not of types G_ACTION_KEYPRESS | G_ACTION_KEYREL | G_ACTION_KILL */
+
+		if ((action->type == G_ACTION_KILL && ch->mode == SINGLE_PRESS)     ||
+		    (action->type == G_ACTION_KEYREL && ch->mode == SINGLE_PRESS)   ||
+		    (action->type & ~(G_ACTION_KEYPRESS | G_ACTION_KEYREL | G_ACTION_KILL)) ||
+		    (loaded.count({action->frame, action->type}) > 0)
+		)
+			return;
+
+		geAction *a = new geAction(
+				x() + (action->frame / pParent->zoom), // x
+				y() + 4,          // y
+				h() - 8,          // h
+				action->frame,	  // frame_a
+				0,                // n. of recordings
+				pParent,          // pointer to the pParent window
+				ch,               // pointer to SampleChannel
+				false,            // record = false: don't record it, we are just displaying it!
+				action->type);    // type of action
+		add(a);
+	});
+
+	redraw();
 }
 
 
@@ -74,12 +74,20 @@ private:
 
 	bool actionCollides(int frame);
 
+	/* loadActions
+	Adds widgets for the actions that have been scrolled into view and deletes 
+	those far out of it. Does nothing while the visible area is already loaded, 
+	unless 'force' is set. */
+
+	void loadActions(bool force=false);
+
 public:
 
 	geActionEditor(int x, int y, gdActionEditor *pParent, SampleChannel *ch);
 	void draw();
 	int  handle(int e);
 	void updateActions();
+	void resize(int x, int y, int w, int h);
 };
 
 
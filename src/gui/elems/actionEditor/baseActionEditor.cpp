@@ -28,17 +28,19 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <algorithm>
 #include <FL/fl_draw.H>
 #include "../../../core/mixer.h"
 #include "../../../core/const.h"
 #include "../../dialogs/gd_actionEditor.h"
+#include "../basics/scroll.h"
 #include "gridTool.h"
 #include "baseActionEditor.h"
 
 
 geBaseActionEditor::geBaseActionEditor(int x, int y, int w, int h,
 	gdActionEditor *pParent)
-	:	Fl_Group(x, y, w, h), pParent(pParent) {}
+	:	Fl_Group(x, y, w, h), pParent(pParent), loadedA(0), loadedB(0) {}
 
 
 /* -------------------------------------------------------------------------- */
@@ -97,3 +99,24 @@ void geBaseActionEditor::baseDraw(bool clear) {
 	if (coverWidth != 0)
 		fl_rectf(pParent->coverX+x(), y()+1, coverWidth, h()-2, G_COLOR_GREY_4);
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool geBaseActionEditor::updateLoadRange(bool force)
+{
+	/* The editor scrolls by moving to the left: the visible area starts where
+	the scroller does. */
+
+	int viewW = pParent->scroller->w();
+	int viewA = std::max(0, pParent->scroller->x() - x());
+	int viewB = viewA + viewW;
+
+	if (!force && viewA * pParent->zoom >= loadedA && viewB * pParent->zoom <= loadedB)
+		return false;
+
+	loadedA = std::max(0, viewA - viewW) * pParent->zoom;
+	loadedB = (viewB + viewW) * pParent->zoom;
+	return true;
+}
@@ -47,6 +47,20 @@ protected:
 
   void baseDraw(bool clear=true);
 
+	/* loadedA, loadedB
+	Range of frames currently backed by widgets. Actions outside of it are not
+	built until they are scrolled into view. */
+
+	int loadedA;
+	int loadedB;
+
+	/* updateLoadRange
+	Moves the loaded range over the visible area, plus one screen on each side.
+	Returns false if the visible area still lies within the current range, i.e.
+	there is nothing to load. */
+
+	bool updateLoadRange(bool force);
+
 public:
 
 	virtual void updateActions() = 0;
@@ -55,6 +55,14 @@ public:
 
   virtual void reposition(int pianoRollX) = 0;
 
+  /* getFrameA, getFrameB, getNote
+  Frames covered by the item and its note. An orphaned item starts and ends on 
+  the same frame. */
+
+  virtual int getFrameA() const = 0;
+  virtual int getFrameB() const = 0;
+  virtual int getNote() const = 0;
+
   int handle(int e) override;
 };
 
@@ -30,6 +30,7 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <limits>
 #include <FL/fl_draw.H>
 #include "../../../core/channel.h"
 #include "../../../core/recorder.h"
@@ -398,19 +399,19 @@ int geEnvelopeEditor::getSelectedPoint() {
 
 void geEnvelopeEditor::fill() {
 	points.clear();
-	for (unsigned i=0; i<recorder::global.size(); i++)
-		for (unsigned j=0; j<recorder::global.at(i).size(); j++) {
-			recorder::action *a = recorder::global.at(i).at(j);
-			if (a->type == type && a->chan == pParent->chan->index) {
-				if (range == G_RANGE_FLOAT)
-					addPoint(
-						a->frame,                      // frame
-						0,                             // int value (unused)
-						a->fValue,                     // float value
-						a->frame / pParent->zoom,       // x
-						((1-h()+8)*a->fValue)+h()-8);  // y = (b-a)x + a (line between two points)
-				// else: TODO
-			}
+	recorder::forEachAction(pParent->chan->index, 0, std::numeric_limits<int>::max(), 
+		[&] (const recorder::action* a)
+	{
+		if (a->type == type) {
+			if (range == G_RANGE_FLOAT)
+				addPoint(
+					a->frame,                      // frame
+					0,                             // int value (unused)
+					a->fValue,                     // float value
+					a->frame / pParent->zoom,       // x
+					((1-h()+8)*a->fValue)+h()-8);  // y = (b-a)x + a (line between two points)
+			// else: TODO
 		}
+	});
 
 }
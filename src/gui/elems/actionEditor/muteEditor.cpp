@@ -25,6 +25,7 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <limits>
 #include <FL/fl_draw.H>
 #include "../../../core/recorder.h"
 #include "../../../core/mixer.h"
@@ -127,22 +128,19 @@ void geMuteEditor::extractPoints()
 {
 	points.clear();
 
-	/* actions are already sorted by recorder::sortActions() */
-
-	for (unsigned i=0; i<recorder::frames.size(); i++) {
-		for (unsigned j=0; j<recorder::global.at(i).size(); j++) {
-			if (recorder::global.at(i).at(j)->chan == pParent->chan->index) {
-				if (recorder::global.at(i).at(j)->type & (G_ACTION_MUTEON | G_ACTION_MUTEOFF)) {
-					point p;
-					p.frame = recorder::frames.at(i);
-					p.type  = recorder::global.at(i).at(j)->type;
-					p.x     = p.frame / pParent->zoom;
-					points.push_back(p);
-					//gu_log("[geMuteEditor::extractPoints] point found, type=%d, frame=%d\n", p.type, p.frame);
-				}
-			}
+	/* actions come sorted from recorder::forEachAction() */
+
+	recorder::forEachAction(pParent->chan->index, 0, std::numeric_limits<int>::max(), 
+		[&] (const recorder::action* a)
+	{
+		if (a->type & (G_ACTION_MUTEON | G_ACTION_MUTEOFF)) {
+			point p;
+			p.frame = a->frame;
+			p.type  = a->type;
+			p.x     = p.frame / pParent->zoom;
+			points.push_back(p);
 		}
-	}
+	});
 }
 
 
@@ -72,6 +72,14 @@ void gePianoItem::reposition(int pianoRollX)
 /* -------------------------------------------------------------------------- */
 
 
+int gePianoItem::getFrameA() const { return a.frame; }
+int gePianoItem::getFrameB() const { return b.frame; }
+int gePianoItem::getNote() const   { return kernelMidi::getB2(a.iValue); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
 bool gePianoItem::overlap()
 {
 	/* when 2 segments overlap?
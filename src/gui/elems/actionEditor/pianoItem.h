@@ -89,6 +89,10 @@ public:
 
   void reposition(int pianoRollX) override;
 
+  int getFrameA() const override;
+  int getFrameB() const override;
+  int getNote() const override;
+
 	void removeAction();
 };
 
@@ -67,6 +67,14 @@ void gePianoItemOrphaned::reposition(int pianoRollX)
 /* -------------------------------------------------------------------------- */
 
 
+int gePianoItemOrphaned::getFrameA() const { return frame; }
+int gePianoItemOrphaned::getFrameB() const { return frame; }
+int gePianoItemOrphaned::getNote() const   { return note; }
+
+
+/* -------------------------------------------------------------------------- */
+
+
 int gePianoItemOrphaned::handle(int e)
 {
   int ret = geBasePianoItem::handle(e);
@@ -56,6 +56,10 @@ public:
 
   void reposition(int pianoRollX) override;
 
+  int getFrameA() const override;
+  int getFrameB() const override;
+  int getNote() const override;
+
   void remove();
 };
 
@@ -25,6 +25,8 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <algorithm>
+#include <set>
 #include "../../../core/conf.h"
 #include "../../../core/const.h"
 #include "../../../core/mixer.h"
@@ -71,24 +73,49 @@ gePianoRoll::gePianoRoll(int X, int Y, int W, gdActionEditor* pParent)
 
 void gePianoRoll::build()
 {
-	using namespace m::recorder;
-	
 	clear();
+	loadActions(true);
+}
 
-	int channel   = pParent->chan->index;
-	int maxSample = m::clock::getFramesInLoop();
 
-	vector<Composite> actions = c::recorder::getMidiActions(channel, maxSample); 
-	for (Composite composite : actions)
-	{
-		m::MidiEvent e1 = composite.a1.iValue;
-		m::MidiEvent e2 = composite.a2.iValue;
+/* -------------------------------------------------------------------------- */
+
+
+void gePianoRoll::loadActions(bool force)
+{
+	using namespace m::recorder;
+
+	if (!updateLoadRange(force))
+		return;
+
+	/* Delete items out of the loaded range. Skip those already gone (they hide
+	themselves before being deleted) and the one being dragged. Keep track of 
+	the others, so that they are not added twice. */
+
+	std::set<std::pair<int, int>> loaded;
 
-		gu_log("[gePianoRoll] ((0x%X, 0x%X, f=%d) - (0x%X, 0x%X, f=%d))\n", 
-			e1.getStatus(), e1.getNote(), composite.a1.frame,
-			e2.getStatus(), e2.getNote(), composite.a2.frame
-		);
+	for (int i=children(); i-- > 0;) {
+		geBasePianoItem* item = static_cast<geBasePianoItem*>(child(i));
+		if (!item->visible() || item == Fl::pushed())
+			continue;
+		if (item->getFrameB() >= loadedA && item->getFrameA() < loadedB) {
+			loaded.insert({item->getFrameA(), item->getNote()});
+			continue;
+		}
+		remove(item);
+		Fl::delete_widget(item);
+	}
+
+	int channel  = pParent->chan->index;
+	int maxFrame = m::clock::getFramesInLoop();
 
+	vector<Composite> actions = c::recorder::getMidiActions(channel, loadedA, 
+		std::min(loadedB, maxFrame + 1)); 
+	for (const Composite& composite : actions)
+	{
+		int note = m::kernelMidi::getB2(composite.a1.iValue);
+		if (loaded.count({composite.a1.frame, note}) > 0)
+			continue;
 		if (composite.a2.frame != -1)
 			add(new gePianoItem(0, 0, x(), y(), composite.a1, composite.a2, pParent));
 		else
@@ -328,4 +355,15 @@ void gePianoRoll::updateActions()
 {
 	for (int k=0; k<children(); k++)
 		static_cast<geBasePianoItem*>(child(k))->reposition(x());
+	loadActions();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gePianoRoll::resize(int X, int Y, int W, int H)
+{
+	Fl_Group::resize(X, Y, W, H);
+	loadActions();
 }
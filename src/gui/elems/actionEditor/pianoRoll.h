@@ -63,8 +63,19 @@ private:
 	void drawSurface2();
 
 
+	/* build
+	Throws away all items and loads those in the visible area. Needed when 
+	actions change. */
+
 	void build();
 
+	/* loadActions
+	Adds items for the actions that have been scrolled into view and deletes 
+	those far out of it. Does nothing while the visible area is already loaded, 
+	unless 'force' is set. */
+
+	void loadActions(bool force=false);
+
 public:
 
 	static const int MAX_KEYS    = 127;
@@ -77,6 +88,7 @@ public:
 
 	void draw() override;
 	int  handle(int e) override;
+	void resize(int x, int y, int w, int h) override;
 
   /* updateActions
   Repositions existing actions after a zoom gesture. */
@@ -135,6 +135,10 @@ geTabAudio::geTabAudio(int X, int Y, int W, int H)
 
 #endif
 
+	soundsys->add("Null (no device)");
+	if (conf::soundSystem == G_SYS_API_NULL)
+		soundsys->showItem("Null (no device)");
+
 	soundsysInitValue = soundsys->value();
 
 	soundsys->callback(cb_deactivate_sounddev, (void*)this);
@@ -145,7 +149,7 @@ geTabAudio::geTabAudio(int X, int Y, int W, int H)
 	devOutInfo->callback(cb_showOutputInfo, this);
 	devInInfo->callback(cb_showInputInfo, this);
 
-	if (conf::soundSystem != G_SYS_API_NONE) {
+	if (conf::soundSystem != G_SYS_API_NONE && conf::soundSystem != G_SYS_API_NULL) {
 		fetchSoundDevs();
 		fetchOutChans(sounddevOut->value());
 		fetchInChans(sounddevIn->value());
@@ -171,6 +175,18 @@ geTabAudio::geTabAudio(int X, int Y, int W, int H)
 		samplerate->deactivate();
 	}
 
+	/* No device to ask for frequencies: the null one runs at any rate. */
+
+	if (conf::soundSystem == G_SYS_API_NULL) {
+		const int freqs[] = {44100, 48000, 88200, 96000, 192000};
+		for (int freq : freqs) {
+			samplerate->add(gu_iToString(freq).c_str());
+			if (freq == conf::samplerate)
+				samplerate->showItem(gu_iToString(freq).c_str());
+		}
+		samplerate->activate();
+	}
+
 	buffersize->add("8");
 	buffersize->add("16");
 	buffersize->add("32");
@@ -258,7 +274,8 @@ void geTabAudio::__cb_deactivate_sounddev()
 	 * querying kernelAudio. Watch out if soundsysInitValue == 0: you don't want
 	 * to query kernelAudio for '(none)' soundsystem! */
 
-	if (soundsysInitValue == soundsys->value() && soundsysInitValue != 0) {
+	if (soundsysInitValue == soundsys->value() && soundsysInitValue != 0 &&
+	    conf::soundSystem != G_SYS_API_NULL) {
 		sounddevOut->clear();
 		sounddevIn->clear();
 
@@ -482,6 +499,9 @@ void geTabAudio::save()
 
 #endif
 
+	else if (text == "Null (no device)")
+		conf::soundSystem = G_SYS_API_NULL;
+
 	/* use the device name to search into the drop down menu's */
 
 	conf::soundDeviceOut = kernelAudio::getDeviceByName(sounddevOut->text(sounddevOut->value()));
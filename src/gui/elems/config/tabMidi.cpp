@@ -56,7 +56,9 @@ geTabMidi::geTabMidi(int X, int Y, int W, int H)
 	noNoteOff = new geCheck (x()+w()-250, portIn->y()+portIn->h()+8, 230, 20, "Device does not send NoteOff");
 	midiMap	  = new geChoice(x()+w()-250, noNoteOff->y()+noNoteOff->h(), 250, 20, "Output Midi Map");
 	sync	    = new geChoice(x()+w()-250, midiMap->y()+midiMap->h()+8, 250, 20, "Sync");
-	new geBox(x(), sync->y()+sync->h()+8, w(), h()-150, "Restart Giada for the changes to take effect.");
+	timing    = new geChoice(x()+w()-250, sync->y()+sync->h()+8, 250, 20, "Input timing");
+	jitterLog = new geCheck (x()+w()-250, timing->y()+timing->h()+8, 230, 20, "Log input latency");
+	new geBox(x(), jitterLog->y()+jitterLog->h()+8, w(), h()-206, "Restart Giada for the changes to take effect.");
 	end();
 
 	labelsize(G_GUI_FONT_SIZE_BASE);
@@ -81,6 +83,12 @@ geTabMidi::geTabMidi(int X, int Y, int W, int H)
 	else if (conf::midiSync == MIDI_SYNC_MTC_M)
 		sync->value(2);
 
+	timing->add("Sample-accurate");
+	timing->add("Immediate");
+	timing->value(conf::midiInTiming == MIDI_IN_TIMING_IMMEDIATE ? 1 : 0);
+
+	jitterLog->value(conf::midiInJitterLog);
+
 	systemInitValue = system->value();
 }
 
@@ -182,6 +190,9 @@ void geTabMidi::save()
 		conf::midiSync = MIDI_SYNC_CLOCK_M;
 	else if (sync->value() == 2)
 		conf::midiSync = MIDI_SYNC_MTC_M;
+
+	conf::midiInTiming    = timing->value() == 1 ? MIDI_IN_TIMING_IMMEDIATE : MIDI_IN_TIMING_ACCURATE;
+	conf::midiInJitterLog = jitterLog->value();
 }
 
 
@@ -58,6 +58,8 @@ public:
 	geCheck  *noNoteOff;
 	geChoice *midiMap;
 	geChoice *sync;
+	geChoice *timing;
+	geCheck  *jitterLog;
 
 	geTabMidi(int x, int y, int w, int h);
 
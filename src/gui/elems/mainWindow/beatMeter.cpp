@@ -31,6 +31,7 @@
 #include "../../../core/const.h"
 #include "../../../core/mixer.h"
 #include "../../../core/clock.h"
+#include "../../../core/uiState.h"
 #include "beatMeter.h"
 
 
@@ -38,7 +39,26 @@ using namespace giada::m;
 
 
 geBeatMeter::geBeatMeter(int x, int y, int w, int h, const char *L)
-  : Fl_Box(x, y, w, h, L) {}
+  : Fl_Box(x, y, w, h, L), drawnBeat(-1), drawnBeats(-1), drawnBars(-1) {}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool geBeatMeter::refresh()
+{
+  const uiState::State& state = uiState::get();
+
+  if (state.currentBeat == drawnBeat && state.beats == drawnBeats && 
+      state.bars == drawnBars)
+    return false;
+
+  drawnBeat  = state.currentBeat;
+  drawnBeats = state.beats;
+  drawnBars  = state.bars;
+  redraw();
+  return true;
+}
 
 
 /* -------------------------------------------------------------------------- */
@@ -46,12 +66,14 @@ geBeatMeter::geBeatMeter(int x, int y, int w, int h, const char *L)
 
 void geBeatMeter::draw()
 {
+  const uiState::State& state = uiState::get();
+
   int cursorW = w() / G_MAX_BEATS;
   int greyX   = clock::getBeats() * cursorW;
 
   fl_rect(x(), y(), w(), h(), G_COLOR_GREY_4);                            // border
   fl_rectf(x()+1, y()+1, w()-2, h()-2, FL_BACKGROUND_COLOR);          // bg
-  fl_rectf(x()+(clock::getCurrentBeat()*cursorW)+3, y()+3, cursorW-5, h()-6,
+  fl_rectf(x()+(state.currentBeat*cursorW)+3, y()+3, cursorW-5, h()-6,
     G_COLOR_LIGHT_1); // cursor
 
   /* beat cells */
@@ -36,10 +36,25 @@
 
 class geBeatMeter : public Fl_Box
 {
+private:
+
+	/* drawnBeat, drawnBeats, drawnBars
+	What the meter showed when last redrawn. */
+
+	int drawnBeat;
+	int drawnBeats;
+	int drawnBars;
+
 public:
 
  	geBeatMeter(int X,int Y,int W,int H,const char *L=0);
  	void draw();
+
+	/* refresh
+	Redraws the meter if the current beat or the sequencer length changed. 
+	Returns true if so. */
+
+	bool refresh();
 };
 
 
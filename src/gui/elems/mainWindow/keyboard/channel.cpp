@@ -51,8 +51,12 @@ using namespace giada;
 
 geChannel::geChannel(int X, int Y, int W, int H, int type, Channel* ch)
  : Fl_Group(X, Y, W, H, nullptr),
-	 ch      (ch),
-	 type    (type)
+	 drawnStatus   (-1),
+	 drawnRecStatus(-1),
+	 drawnProgress (-1),
+	 drawnFlags    (-1),
+	 ch            (ch),
+	 type          (type)
 {
 }
 
@@ -188,6 +192,60 @@ void geChannel::setColorsByStatus(int playStatus, int recStatus)
 /* -------------------------------------------------------------------------- */
 
 
+bool geChannel::needsRefresh(int status, int recStatus, int progress, int flags)
+{
+	/* Blinking channels change look with the blinker, not with the engine. */
+
+	if (status == STATUS_WAIT || recStatus == REC_WAITING)
+		flags |= gu_getBlinker() > 6 ? 0x10000 : 0;
+
+	if (status    == drawnStatus    && recStatus == drawnRecStatus &&
+	    progress  == drawnProgress  && flags     == drawnFlags)
+		return false;
+
+	drawnStatus    = status;
+	drawnRecStatus = recStatus;
+	drawnProgress  = progress;
+	drawnFlags     = flags;
+	return true;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geChannel::markDirty()
+{
+	drawnStatus = -1;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geChannel::bind(Channel* c)
+{
+	ch = c;
+	ch->guiChannel = this;
+	button->value(0);
+	update();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geChannel::unbind()
+{
+	if (ch != nullptr && ch->guiChannel == this)
+		ch->guiChannel = nullptr;
+	ch = nullptr;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void geChannel::packWidgets()
 {
 	/* Count visible widgets and resize mainButton according to how many widgets
@@ -98,6 +98,27 @@ protected:
 
 	void packWidgets();
 
+	/* needsRefresh
+	Compares the look of the channel in the latest engine snapshot with the one 
+	last drawn, and remembers it. Returns true if the channel has to be redrawn.
+	'progress' is the status bar width, 'flags' any other state the look depends
+	on (e.g. recording modes). */
+
+	bool needsRefresh(int status, int recStatus, int progress, int flags);
+
+	/* markDirty
+	Forces a redraw on the next refresh(), e.g. after reset() or update(). */
+
+	void markDirty();
+
+	/* drawn*
+	State of the channel when it was last refreshed. */
+
+	int drawnStatus;
+	int drawnRecStatus;
+	int drawnProgress;
+	int drawnFlags;
+
 public:
 
 	geChannel(int x, int y, int w, int h, int type, Channel* ch);
@@ -114,9 +135,21 @@ public:
 	virtual void update() = 0;
 
 	/* refresh
-	 * update graphics. */
+	 * update graphics from the engine snapshot. Returns true if something 
+	 * changed and has been redrawn. */
+
+	virtual bool refresh() = 0;
+
+	/* bind
+	Recycles this widget for channel 'ch': everything is read again from the 
+	channel. */
+
+	virtual void bind(Channel* ch);
+
+	/* unbind
+	Detaches the widget from its channel, when scrolled out of view. */
 
-	virtual void refresh() = 0;
+	void unbind();
 
 	/* changeSize
 	Changes channel's size according to a template (x1, x2, ...). */
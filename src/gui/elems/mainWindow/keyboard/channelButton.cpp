@@ -69,12 +69,21 @@ void geChannelButton::draw()
 {
 	geButton::draw();
 
+	/* draw level: decaying peak, plus a tick for the held one */
+
+	if (m_level.holdDb > -G_MIN_DB_SCALE) {
+		int px = geSoundMeter::Level::toPx(m_level.peakDb, w()-2);
+		int hx = geSoundMeter::Level::toPx(m_level.holdDb, w()-2);
+		fl_rectf(x()+1, y()+h()-3, px, 2, txtColor);
+		fl_rectf(x()+hx, y()+h()-3, 1, 2, m_level.holdDb >= 0.0f ? G_COLOR_RED_ALERT : txtColor);
+	}
+
 	if (m_key == "")
 		return;
 
-	/* draw background */
+	/* draw background, level strip excluded */
 
-	fl_rectf(x()+1, y()+1, 18, h()-2, bgColor0);
+	fl_rectf(x()+1, y()+1, 18, h()-4, bgColor0);
 
 	/* draw m_key */
 
@@ -134,3 +143,12 @@ void geChannelButton::setEndingMode()
 {
 	bgColor0 = G_COLOR_GREY_4;
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool geChannelButton::setLevel(float peak)
+{
+	return m_level.update(peak, 0.0f);  // too thin for RMS
+}
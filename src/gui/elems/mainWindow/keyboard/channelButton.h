@@ -30,6 +30,7 @@
 
 
 #include "../../basics/button.h"
+#include "../../soundMeter.h"
 
 
 class geChannelButton : public geButton
@@ -38,6 +39,11 @@ private:
 
 	std::string m_key;
 
+	/* m_level
+	Output level of the channel, drawn as a thin strip along the bottom edge. */
+
+	geSoundMeter::Level m_level;
+
 public:
 
 	geChannelButton(int x, int y, int w, int h, const char* l=0);
@@ -51,6 +57,12 @@ public:
 	void setDefaultMode(const char* l=0);
 	void setInputRecordMode();
 	void setActionRecordMode();
+
+	/* setLevel
+	Feeds the peak level of the channel. Returns true if the level strip needs 
+	redrawing. */
+
+	bool setLevel(float peak);
 };
 
 
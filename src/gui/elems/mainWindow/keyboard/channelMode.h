@@ -48,6 +48,8 @@ public:
   geChannelMode(int x, int y, int w, int h, class SampleChannel *ch,
     const char *l=0);
 	void draw();
+
+	void setChannel(class SampleChannel *c) { ch = c; }
 };
 
 
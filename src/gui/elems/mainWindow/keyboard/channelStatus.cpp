@@ -31,6 +31,7 @@
 #include "../../../../core/sampleChannel.h"
 #include "../../../../core/recorder.h"
 #include "../../../../core/const.h"
+#include "../../../../core/uiState.h"
 #include "channelStatus.h"
 
 
@@ -50,33 +51,43 @@ void geChannelStatus::draw()
   fl_rect(x(), y(), w(), h(), G_COLOR_GREY_4);              // reset border
   fl_rectf(x()+1, y()+1, w()-2, h()-2, G_COLOR_GREY_2);     // reset background
 
-  if (ch != nullptr) {
-    if (ch->status    & (STATUS_WAIT | STATUS_ENDING | REC_ENDING | REC_WAITING) ||
-        ch->recStatus & (REC_WAITING | REC_ENDING))
+  const uiState::ChannelState* cs = ch != nullptr ? uiState::getChannel(ch->index) : nullptr;
+
+  if (cs != nullptr) {
+    const uiState::State& state = uiState::get();
+
+    if (cs->status    & (STATUS_WAIT | STATUS_ENDING | REC_ENDING | REC_WAITING) ||
+        cs->recStatus & (REC_WAITING | REC_ENDING))
     {
       fl_rect(x(), y(), w(), h(), G_COLOR_LIGHT_1);
     }
     else
-    if (ch->status == STATUS_PLAY)
+    if (cs->status == STATUS_PLAY)
       fl_rect(x(), y(), w(), h(), G_COLOR_LIGHT_1);
     else
       fl_rectf(x()+1, y()+1, w()-2, h()-2, G_COLOR_GREY_2);     // status empty
 
 
-    if (mixer::recording && ch->armed)
+    if (state.recording && ch->armed)
       fl_rectf(x()+1, y()+1, w()-2, h()-2, G_COLOR_RED);     // take in progress
     else
-    if (recorder::active && recorder::canRec(ch, clock::isRunning(), mixer::recording))
+    if (recorder::active && recorder::canRec(ch, state.running, state.recording))
       fl_rectf(x()+1, y()+1, w()-2, h()-2, G_COLOR_BLUE);     // action record
 
     /* equation for the progress bar:
      * ((chanTracker - chanStart) * w()) / (chanEnd - chanStart). */
 
-    int pos = ch->getPosition();
-    if (pos == -1)
-      pos = 0;
-    else
-      pos = (pos * (w()-1)) / ((ch->getEnd() - ch->getBegin()));
-    fl_rectf(x()+1, y()+1, pos, h()-2, G_COLOR_LIGHT_1);
+    fl_rectf(x()+1, y()+1, getProgress(cs->position, cs->length), h()-2, G_COLOR_LIGHT_1);
   }
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int geChannelStatus::getProgress(int position, int length) const
+{
+  if (position == -1 || length <= 0)
+    return 0;
+  return (int) (((long long) position * (w()-1)) / length);
+}
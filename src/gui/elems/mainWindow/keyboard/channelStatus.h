@@ -40,6 +40,13 @@ public:
 	geChannelStatus(int X, int Y, int W, int H, class SampleChannel *ch,
     const char *L=0);
 	void draw();
+
+	/* getProgress
+	Width in pixels of the progress bar for playhead 'position' over 'length' 
+	frames. */
+
+	int getProgress(int position, int length) const;
+
 	class SampleChannel *ch;
 };
 
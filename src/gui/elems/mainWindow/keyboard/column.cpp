@@ -26,15 +26,20 @@
 
 
 #include <cassert>
+#include <algorithm>
 #include <FL/fl_draw.H>
 #include <FL/Fl_Menu_Button.H>
 #include "../../../../core/sampleChannel.h"
 #include "../../../../core/midiChannel.h"
 #include "../../../../glue/channel.h"
+#include "../../../../glue/column.h"
+#include "../../../../utils/gui.h"
 #include "../../../../utils/log.h"
 #include "../../../../utils/fs.h"
 #include "../../../../utils/string.h"
 #include "../../../dialogs/gd_warnings.h"
+#include "../../../dialogs/gd_mainWindow.h"
+#include "../../../dialogs/columnBus.h"
 #include "../../../elems/basics/boxtypes.h"
 #include "../../../elems/basics/resizerBar.h"
 #include "keyboard.h"
@@ -43,6 +48,9 @@
 #include "column.h"
 
 
+extern gdMainWindow* G_MainWin;
+
+
 using std::vector;
 using std::string;
 using namespace giada;
@@ -50,8 +58,11 @@ using namespace giada;
 
 geColumn::geColumn(int X, int Y, int W, int H, int index, geKeyboard* parent)
 	: Fl_Group(X, Y, W, H), 
-		m_parent(parent), 
-		m_index (index)
+		m_parent (parent), 
+		m_index  (index),
+		m_viewTop(-1),
+		m_viewH  (-1),
+		bus      (nullptr)
 {
 	/* geColumn does a bit of a mess: we pass a pointer to its m_parent (geKeyboard) and
 	the geColumn itself deals with the creation of another widget, outside geColumn
@@ -83,6 +94,12 @@ geColumn::~geColumn()
 	just removed, not deleted. But we cannot delete it right now. */
 
 	m_parent->remove(m_resizer);
+
+	/* Bound widgets are children of the column and go away with it. Pooled ones
+	must be deleted here. */
+
+	for (geChannel* gch : m_pool)
+		delete gch;
 }
 
 
@@ -115,7 +132,7 @@ int geColumn::handle(int e)
 					m_index, G_CHANNEL_SAMPLE, G_GUI_CHANNEL_H_1));
 				result = c::channel::loadChannel(c, gu_stripFileUrl(path));
 				if (result != G_RES_OK) {
-					deleteChannel(c->guiChannel);
+					deleteChannel(c);
 					fails = true;
 				}
 			}
@@ -141,33 +158,116 @@ int geColumn::handle(int e)
 
 void geColumn::resize(int X, int Y, int W, int H)
 {
-	/* Resize all children, including "add channel" button. */
-
-	for (int i=0; i<children(); i++) {
-		Fl_Widget* wgCurr = child(i);
-		Fl_Widget* wgPrev = i == 0 ? nullptr : child(i - 1);
-		wgCurr->resize(X, (wgPrev == nullptr ? Y : wgPrev->y() + wgPrev->h() + G_GUI_INNER_MARGIN), 
-			W, wgCurr->h());
-	}
-
 	/* Resize group itself. Must use internal functions, resize() would trigger
 	infinite recursion. */
 
 	x(X); y(Y); w(W); h(H);
 
-	/* Resize resizerBar. */
+	/* Resize "add channel" button and resizerBar, then the channels. This is 
+	also called by geKeyboard when scrolling: channels entering the visible area
+	get their widget here. */
 
+	m_addChannelBtn->resize(X, Y, W, m_addChannelBtn->h());
 	m_resizer->size(G_GUI_OUTER_MARGIN * 2, H);
+
+	layoutChannels();
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void geColumn::refreshChannels()
+void geColumn::layoutChannels()
 {
+	m_viewTop = m_parent->y() - y();
+	m_viewH   = m_parent->h();
+
+	int Y = m_addChannelBtn->h() + G_GUI_INNER_MARGIN;
+	for (Channel* ch : m_channels) {
+		if (Y + ch->size > m_viewTop && Y < m_viewTop + m_viewH) {
+			geChannel* gch = bindChannel(ch);
+			gch->resize(x(), y() + Y, w(), gch->h());
+			if (gch->h() != ch->size)
+				gch->changeSize(ch->size);
+		}
+		else
+			releaseChannel(ch);
+		Y += ch->size + G_GUI_INNER_MARGIN;
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+geChannel* geColumn::bindChannel(Channel* ch)
+{
+	if (ch->guiChannel != nullptr)
+		return ch->guiChannel;
+
+	geChannel* gch = nullptr;
+	for (size_t i=0; i<m_pool.size(); i++) {
+		if (m_pool.at(i)->type != ch->type)
+			continue;
+		gch = m_pool.at(i);
+		m_pool.erase(m_pool.begin() + i);
+		gch->bind(ch);
+		break;
+	}
+
+	/* Nothing to recycle: build a new widget. All geChannels are added with y=0. 
+	That's not a problem, they will be repositioned later on during 
+	layoutChannels(). */
+
+	if (gch == nullptr) {
+		if (ch->type == G_CHANNEL_SAMPLE)
+			gch = new geSampleChannel(x(), 0, w(), ch->size, static_cast<SampleChannel*>(ch));
+		else
+			gch = new geMidiChannel(x(), 0, w(), ch->size, static_cast<MidiChannel*>(ch));
+	}
+
+	add(gch);
+	gch->redraw();    // fix corruption
+	return gch;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geColumn::releaseChannel(Channel* ch)
+{
+	geChannel* gch = ch->guiChannel;
+	if (gch == nullptr)
+		return;
+
+	/* Don't leave the keyboard focus on a detached widget: key events would get
+	lost. */
+
+	if (gch->contains(Fl::focus()))
+		Fl::focus(m_parent);
+
+	gch->unbind();
+	remove(gch);
+	m_pool.push_back(gch);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool geColumn::refreshChannels()
+{
+	/* The visible area might have changed without a resize of the column, e.g.
+	when the main window is resized. */
+
+	if (m_parent->y() - y() != m_viewTop || m_parent->h() != m_viewH)
+		layoutChannels();
+
+	bool changed = false;
 	for (int i=1; i<children(); i++)
-		static_cast<geChannel*>(child(i))->refresh();
+		changed |= static_cast<geChannel*>(child(i))->refresh();
+	return changed;
 }
 
 
@@ -200,9 +300,9 @@ void geColumn::cb_addChannel(Fl_Widget* v, void* p) { ((geColumn*)p)->__cb_addCh
 
 void geColumn::repositionChannels()
 {
-	int totalH = 0;
-	for (int i=0; i<children(); i++)
-		totalH += child(i)->h() + G_GUI_INNER_MARGIN;
+	int totalH = m_addChannelBtn->h() + G_GUI_INNER_MARGIN;
+	for (const Channel* ch : m_channels)
+		totalH += ch->size + G_GUI_INNER_MARGIN;
 	resize(x(), y(), w(), totalH + 66); // evil space for drag n drop
 }
 
@@ -212,38 +312,38 @@ void geColumn::repositionChannels()
 
 geChannel* geColumn::addChannel(Channel* ch, int size)
 {
-	geChannel* gch = nullptr;
-
-	/* All geChannels are added with y=0. That's not a problem, they will be 
-	repositioned later on during geColumn::resize(). */
-
-	if (ch->type == G_CHANNEL_SAMPLE)
-		gch = new geSampleChannel(x(), 0, w(), size, static_cast<SampleChannel*>(ch));
-	else
-		gch = new geMidiChannel(x(), 0, w(), size, static_cast<MidiChannel*>(ch));
-
-	add(gch);
+	ch->column = m_index;
+	ch->size   = size;
+	m_channels.push_back(ch);
 
 	repositionChannels();
-	gch->redraw();    // fix corruption
 	m_parent->redraw(); // redraw Keyboard
-	return gch;
+	return ch->guiChannel;
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void geColumn::deleteChannel(geChannel* gch)
+void geColumn::deleteChannel(Channel* ch)
 {
-	gch->hide();
-	remove(gch);
-	delete gch;
+	auto it = std::find(m_channels.begin(), m_channels.end(), ch);
+	if (it == m_channels.end())
+		return;
+	releaseChannel(ch);
+	m_channels.erase(it);
+	repositionChannels();
+}
+
+
+/* -------------------------------------------------------------------------- */
 
-	/** TODO
-	 * reposition is useless when called by geColumn::clear(). Add a new
-	 * parameter to skip the operation */
 
+void geColumn::setChannelSize(Channel* ch, int H)
+{
+	ch->size = H;
+	if (ch->guiChannel != nullptr)
+		ch->guiChannel->changeSize(H);
 	repositionChannels();
 }
 
@@ -254,7 +354,7 @@ void geColumn::deleteChannel(geChannel* gch)
 void geColumn::__cb_addChannel()
 {
 	gu_log("[geColumn::__cb_addChannel] m_index = %d\n", m_index);
-	int type = openTypeMenu();
+	int type = openMenu();
 	if (type)
 		c::channel::addChannel(m_index, type, G_GUI_CHANNEL_H_1);
 }
@@ -263,14 +363,21 @@ void geColumn::__cb_addChannel()
 /* -------------------------------------------------------------------------- */
 
 
-int geColumn::openTypeMenu()
+int geColumn::openMenu()
 {
 	Fl_Menu_Item rclick_menu[] = {
 		{"Sample channel"},
-		{"MIDI channel"},
+		{"MIDI channel", 0, 0, 0, FL_MENU_DIVIDER},
+		{"Group bus", 0, 0, 0, FL_MENU_TOGGLE},
+		{"Group bus settings..."},
 		{0}
 	};
 
+	if (bus != nullptr)
+		rclick_menu[2].set();
+	else
+		rclick_menu[3].deactivate();
+
 	Fl_Menu_Button* b = new Fl_Menu_Button(0, 0, 100, 50);
 	b->box(G_CUSTOM_BORDER_BOX);
 	b->textsize(G_GUI_FONT_SIZE_BASE);
@@ -284,6 +391,11 @@ int geColumn::openTypeMenu()
 		return G_CHANNEL_SAMPLE;
 	if (strcmp(m->label(), "MIDI channel") == 0)
 		return G_CHANNEL_MIDI;
+	if (strcmp(m->label(), "Group bus") == 0)
+		c::column::setBus(this, bus == nullptr);
+	else
+	if (strcmp(m->label(), "Group bus settings...") == 0)
+		gu_openSubWindow(G_MainWin, new gdColumnBus(this), WID_COLUMN_BUS);
 	return 0;
 }
 
@@ -293,14 +405,33 @@ int geColumn::openTypeMenu()
 
 void geColumn::clear(bool full)
 {
+	for (Channel* ch : m_channels)
+		releaseChannel(ch);
+	m_channels.clear();
+
 	if (full)
 		Fl_Group::clear();
-	else {
-		while (children() >= 2) {  // skip "add new channel" btn
-			int i = children()-1;
-			deleteChannel(static_cast<geChannel*>(child(i)));
-		}
-	}
+	else
+		repositionChannels();
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geColumn::forEachChannel(std::function<void(Channel* ch, geChannel* gch)> f)
+{
+	for (Channel* ch : m_channels)
+		f(ch, ch->guiChannel);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool geColumn::hasChannel(const Channel* ch) const
+{
+	return std::find(m_channels.begin(), m_channels.end(), ch) != m_channels.end();
 }
 
 
@@ -309,7 +440,7 @@ void geColumn::clear(bool full)
 
 Channel* geColumn::getChannel(int i)
 {
-	return static_cast<geChannel*>(child(i + 1))->ch;  // Skip "add channel"
+	return m_channels.at(i);
 }
 
 
@@ -317,6 +448,16 @@ Channel* geColumn::getChannel(int i)
 
 
 int geColumn::getIndex()       { return m_index; }
-void geColumn::setIndex(int i) { m_index = i; }
-bool geColumn::isEmpty()       { return children() == 1; }
-int geColumn::countChannels()  { return children() - 1; }
\ No newline at end of file
+bool geColumn::isEmpty()       { return m_channels.empty(); }
+int geColumn::countChannels()  { return m_channels.size(); }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void geColumn::setIndex(int i) 
+{ 
+	m_index = i; 
+	for (Channel* ch : m_channels)
+		ch->column = i;
+}
\ No newline at end of file
@@ -29,16 +29,24 @@
 #define GE_COLUMN_H
 
 
+#include <vector>
+#include <functional>
 #include <FL/Fl_Group.H>
 
 
 class Channel;
+class ColumnBus;
 class geButton;
 class geChannel;
 class geResizerBar;
 class geKeyboard;
 
 
+/* geColumn
+A column of channels. Channels are stored as a list of Channel objects: only
+those in the visible part of the keyboard get a geChannel widget, recycled from
+a pool as the user scrolls. */
+
 class geColumn : public Fl_Group
 {
 private:
@@ -46,7 +54,28 @@ private:
 	static void cb_addChannel  (Fl_Widget* v, void* p);
 	inline void __cb_addChannel();
 
-	int openTypeMenu();
+	/* openMenu
+	Shows the column menu. Returns the type of channel to add, if any, or 0. Group 
+	bus entries are handled internally. */
+
+	int openMenu();
+
+	/* layoutChannels
+	Binds a widget to each channel in the visible area of the keyboard and 
+	releases the others. */
+
+	void layoutChannels();
+
+	/* bindChannel
+	Returns the widget bound to 'ch', taking one from the pool (or building a new
+	one) if the channel has none. */
+
+	geChannel* bindChannel(Channel* ch);
+
+	/* releaseChannel
+	Unbinds the widget of 'ch', if any, and moves it to the pool. */
+
+	void releaseChannel(Channel* ch);
 
 	geButton*     m_addChannelBtn;
 	geResizerBar* m_resizer;
@@ -54,14 +83,36 @@ private:
 
 	int m_index;
 
+	/* m_channels
+	Channels in this column, top to bottom. */
+
+	std::vector<Channel*> m_channels;
+
+	/* m_pool
+	Unbound widgets, detached from the column and ready to be reused. */
+
+	std::vector<geChannel*> m_pool;
+
+	/* m_viewTop, m_viewH
+	Visible area of the keyboard, relative to the column, at the last layout. */
+
+	int m_viewTop;
+	int m_viewH;
+
 public:
 
 	geColumn(int x, int y, int w, int h, int index, geKeyboard* parent);
 	~geColumn();
 
+	/* bus
+	Group bus the channels of this column are routed to, or nullptr if the 
+	column goes straight to the master output. */
+
+	ColumnBus* bus;
+
 	/* addChannel
-	Adds a new channel in this column and set the internal pointer to channel 
-	to 'ch'. */
+	Adds the channel 'ch' at the bottom of this column, with height 'size'. 
+	Returns the widget bound to it, or nullptr if the channel is not visible. */
 
 	geChannel* addChannel(Channel* ch, int size);
 
@@ -76,16 +127,33 @@ public:
 	void clear(bool full=false);
 
 	/* deleteChannel
-	Removes the channel 'gch' from this column. */
+	Removes the channel 'ch' from this column. */
+
+	void deleteChannel(Channel* ch);
 
-	void deleteChannel(geChannel* gch);
+	/* setChannelSize
+	Changes the height of the row of channel 'ch'. */
+
+	void setChannelSize(Channel* ch, int h);
 
 	void repositionChannels();
 
 	/* refreshChannels
-	Updates channels' graphical statues. Called on each GUI cycle. */
+	Updates channels' graphical statues. Called on each GUI cycle. Returns true if
+	any channel has been redrawn. */
+
+	bool refreshChannels();
+
+	/* forEachChannel
+	Calls 'f' on each channel of the column, with its widget or nullptr if the 
+	channel is not visible. */
+
+	void forEachChannel(std::function<void(Channel* ch, geChannel* gch)> f);
+
+	/* hasChannel
+	Whether the channel 'ch' belongs to this column. */
 
-	void refreshChannels();
+	bool hasChannel(const Channel* ch) const;
 
 	Channel* getChannel(int i);
 	int getIndex();
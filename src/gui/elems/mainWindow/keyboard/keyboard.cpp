@@ -28,6 +28,7 @@
 #include "../../../../core/sampleChannel.h"
 #include "../../../../glue/transport.h"
 #include "../../../../glue/io.h"
+#include "../../../../glue/column.h"
 #include "../../../../utils/log.h"
 #include "../../../dialogs/gd_warnings.h"
 #include "../../basics/boxtypes.h"
@@ -90,22 +91,19 @@ void geKeyboard::init()
 
 void geKeyboard::freeChannel(geChannel* gch)
 {
-	gch->reset();
+	if (gch != nullptr)
+		gch->reset();
 }
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void geKeyboard::deleteChannel(geChannel* gch)
+void geKeyboard::deleteChannel(Channel* ch)
 {
-	for (unsigned i=0; i<columns.size(); i++) {
-		int k = columns.at(i)->find(gch);
-		if (k != columns.at(i)->children()) {
-			columns.at(i)->deleteChannel(gch);
-			return;
-		}
-	}
+	geColumn* col = getColumnByChannel(ch);
+	if (col != nullptr)
+		col->deleteChannel(ch);
 }
 
 
@@ -114,7 +112,8 @@ void geKeyboard::deleteChannel(geChannel* gch)
 
 void geKeyboard::updateChannel(geChannel* gch)
 {
-	gch->update();
+	if (gch != nullptr)
+		gch->update();
 }
 
 
@@ -130,6 +129,7 @@ void geKeyboard::organizeColumns()
 
 	for (size_t i=columns.size(); i-- > 0;) {
 		if (columns.at(i)->isEmpty()) {
+			giada::c::column::setBus(columns.at(i), false);
 			Fl::delete_widget(columns.at(i));
 			columns.erase(columns.begin() + i);
 		}
@@ -188,10 +188,12 @@ geChannel* geKeyboard::addChannel(int colIndex, Channel* ch, int size, bool buil
 /* -------------------------------------------------------------------------- */
 
 
-void geKeyboard::refreshColumns()
+bool geKeyboard::refreshColumns()
 {
+	bool changed = false;
 	for (unsigned i=0; i<columns.size(); i++)
-		columns.at(i)->refreshChannels();
+		changed |= columns.at(i)->refreshChannels();
+	return changed;
 }
 
 
@@ -207,6 +209,36 @@ geColumn* geKeyboard::getColumnByIndex(int index)
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+
+geColumn* geKeyboard::getColumnByChannel(const Channel* ch)
+{
+	for (geColumn* col : columns)
+		if (col->hasChannel(ch))
+			return col;
+	return nullptr;
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int geKeyboard::keyPressHidden(Channel* ch, int e, bool repeat)
+{
+	using namespace giada::c;
+
+	if (Fl::event_key() != ch->key)
+		return 0;
+	if (e == FL_KEYUP)
+		io::keyRelease(ch, Fl::event_ctrl(), Fl::event_shift());
+	else
+	if (!repeat)
+		io::keyPress(ch, Fl::event_ctrl(), Fl::event_shift(), 0x7F);
+	return 1;
+}
+
+
 /* -------------------------------------------------------------------------- */
 
 /* TODO - the following event handling for play, stop, rewind, start rec and
@@ -268,11 +300,20 @@ int geKeyboard::handle(int e)
 
 			/* Walk button arrays, trying to match button's label with the Keyboard event.
 			 * If found, set that button's value() based on up/down event,
-			 * and invoke that button's callback() */
-
-			for (unsigned i=0; i<columns.size(); i++)
-				for (int k=1; k<columns.at(i)->children(); k++)
-					ret &= static_cast<geChannel*>(columns.at(i)->child(k))->keyPress(e);
+			 * and invoke that button's callback(). Channels out of view have no
+			 * button: talk to the engine directly. */
+
+			int  key    = Fl::event_key();
+			bool repeat = e != FL_KEYUP && keysDown.count(key) > 0;
+			if (e == FL_KEYUP)
+				keysDown.erase(key);
+			else
+				keysDown.insert(key);
+
+			for (geColumn* col : columns)
+				col->forEachChannel([&] (Channel* ch, geChannel* gch) {
+					ret &= gch != nullptr ? gch->keyPress(e) : keyPressHidden(ch, e, repeat);
+				});
 			break;
 		}
 	}
@@ -298,6 +339,8 @@ void geKeyboard::clear()
 
 void geKeyboard::setChannelWithActions(geSampleChannel* gch)
 {
+	if (gch == nullptr)
+		return;
 	if (gch->ch->hasActions)
 		gch->showActionButton();
 	else
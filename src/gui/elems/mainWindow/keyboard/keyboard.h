@@ -29,6 +29,7 @@
 #define GE_KEYBOARD_H
 
 
+#include <set>
 #include <vector>
 #include <FL/Fl_Scroll.H>
 #include "../../../../core/const.h"
@@ -61,6 +62,17 @@ private:
 	bool spacePressed;
 	bool enterPressed;
 
+	/* keysDown
+	Keys currently held down, to skip auto-repeat on channels without a widget.*/
+
+	std::set<int> keysDown;
+
+	/* keyPressHidden
+	Key handling for channels scrolled out of view, which have no widget to 
+	receive the event. */
+
+	int keyPressHidden(Channel* ch, int e, bool repeat);
+
 	/* indexColumn
 	 * the last index used for column. */
 
@@ -97,19 +109,19 @@ public:
 	void addColumn(int width=380);
 
 	/* deleteChannel
-	 * delete a channel from geChannels<> where geChannel->ch == ch and remove
-	 * it from the stack. */
+	 * remove the channel 'ch' from its column. */
 
-	void deleteChannel(geChannel* gch);
+	void deleteChannel(Channel* ch);
 
 	/* freeChannel
-	 * free a channel from geChannels<> where geChannel->ch == ch. No channels
-	 * are deleted */
+	 * reset the widget 'gch'. No channels are deleted. 'gch' can be nullptr
+	 * if the channel is not visible. */
 
 	void freeChannel(geChannel* gch);
 
 	/* updateChannel
-	 * wrapper function to call gch->update(). */
+	 * wrapper function to call gch->update(). 'gch' can be nullptr if the 
+	 * channel is not visible: it will be updated once it gets a widget. */
 
 	void updateChannel(geChannel* gch);
 
@@ -119,15 +131,21 @@ public:
 	void organizeColumns();
 
 	/* refreshColumns
-	 * refresh each column's channel, called on each GUI cycle. */
+	 * refresh each column's channel, called on each GUI cycle. Returns true
+	 * if any channel has been redrawn. */
 
-	void refreshColumns();
+	bool refreshColumns();
 
 	/* getColumnByIndex
 	 * return the column with index 'index', or nullptr if not found. */
 
 	geColumn* getColumnByIndex(int index);
 
+	/* getColumnByChannel
+	 * return the column containing channel 'ch', or nullptr if not found. */
+
+	geColumn* getColumnByChannel(const Channel* ch);
+
 	/* getColumn
 	 * return the column with from columns->at(i). */
 
@@ -139,7 +157,8 @@ public:
 	void clear();
 
 	/* setChannelWithActions
-	 * add 'R' button if channel has actions, and set recorder to active. */
+	 * add 'R' button if channel has actions, and set recorder to active. 'gch'
+	 * can be nullptr if the channel is not visible. */
 
 	void setChannelWithActions(geSampleChannel* gch);
 
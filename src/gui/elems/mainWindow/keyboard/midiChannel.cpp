@@ -29,6 +29,7 @@
 #include "../../../../core/const.h"
 #include "../../../../core/graphics.h"
 #include "../../../../core/midiChannel.h"
+#include "../../../../core/uiState.h"
 #include "../../../../utils/gui.h"
 #include "../../../../utils/string.h"
 #include "../../../../glue/channel.h"
@@ -36,6 +37,7 @@
 #include "../../../../glue/recorder.h"
 #include "../../../dialogs/gd_mainWindow.h"
 #include "../../../dialogs/channelNameInput.h"
+#include "../../../dialogs/channelSends.h"
 #include "../../../dialogs/gd_actionEditor.h"
 #include "../../../dialogs/gd_warnings.h"
 #include "../../../dialogs/gd_keyGrabber.h"
@@ -68,6 +70,9 @@ enum class Menu
 	SETUP_KEYBOARD_INPUT,
 	SETUP_MIDI_INPUT,
 	SETUP_MIDI_OUTPUT,
+#ifdef WITH_VST
+	SETUP_SENDS,
+#endif
 	RESIZE,
 	RESIZE_H1,
 	RESIZE_H2,
@@ -76,6 +81,7 @@ enum class Menu
 	__END_RESIZE_SUBMENU__,
 	RENAME_CHANNEL,
 	CLONE_CHANNEL,
+	FREEZE_CHANNEL,
 	DELETE_CHANNEL
 };
 
@@ -113,25 +119,29 @@ void menuCallback(Fl_Widget* w, void* v)
 			gu_openSubWindow(G_MainWin,
 				new gdMidiOutputMidiCh(static_cast<MidiChannel*>(gch->ch)), 0);
 			break;
+#ifdef WITH_VST
+		case Menu::SETUP_SENDS:
+			gu_openSubWindow(G_MainWin, new gdChannelSends(gch->ch), WID_CHANNEL_SENDS);
+			break;
+#endif
 		case Menu::RESIZE_H1:
-			gch->changeSize(G_GUI_CHANNEL_H_1);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_1);
 			break;		
 		case Menu::RESIZE_H2:
-			gch->changeSize(G_GUI_CHANNEL_H_2);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_2);
 			break;		
 		case Menu::RESIZE_H3:
-			gch->changeSize(G_GUI_CHANNEL_H_3);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_3);
 			break;		
 		case Menu::RESIZE_H4:
-			gch->changeSize(G_GUI_CHANNEL_H_4);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_4);
 			break;
 		case Menu::CLONE_CHANNEL:
 			c::channel::cloneChannel(gch->ch);
 			break;		
+		case Menu::FREEZE_CHANNEL:
+			c::channel::toggleFreeze(gch->ch);
+			break;
 		case Menu::RENAME_CHANNEL:
 			gu_openSubWindow(G_MainWin, new gdChannelNameInput(gch->ch), WID_SAMPLE_NAME);
 			break;
@@ -234,6 +244,9 @@ void geMidiChannel::cb_openMenu()
 		{"Setup keyboard input...", 0, menuCallback, (void*) Menu::SETUP_KEYBOARD_INPUT},
 		{"Setup MIDI input...",     0, menuCallback, (void*) Menu::SETUP_MIDI_INPUT},
 		{"Setup MIDI output...",    0, menuCallback, (void*) Menu::SETUP_MIDI_OUTPUT},
+#ifdef WITH_VST
+		{"Send levels...",          0, menuCallback, (void*) Menu::SETUP_SENDS},
+#endif
 		{"Resize",    0, menuCallback, (void*) Menu::RESIZE, FL_SUBMENU},
 			{"Normal",  0, menuCallback, (void*) Menu::RESIZE_H1},
 			{"Medium",  0, menuCallback, (void*) Menu::RESIZE_H2},
@@ -242,6 +255,7 @@ void geMidiChannel::cb_openMenu()
 			{0},
 		{"Rename channel",  0, menuCallback, (void*) Menu::RENAME_CHANNEL},
 		{"Clone channel",  0, menuCallback, (void*) Menu::CLONE_CHANNEL},
+		{ch->isFrozen() ? "Unfreeze channel" : "Freeze channel", 0, menuCallback, (void*) Menu::FREEZE_CHANNEL},
 		{"Delete channel", 0, menuCallback, (void*) Menu::DELETE_CHANNEL},
 		{0}
 	};
@@ -267,10 +281,20 @@ void geMidiChannel::cb_openMenu()
 /* -------------------------------------------------------------------------- */
 
 
-void geMidiChannel::refresh()
+bool geMidiChannel::refresh()
 {
-	setColorsByStatus(ch->status, ch->recStatus);
+	const giada::m::uiState::ChannelState* cs = giada::m::uiState::getChannel(ch->index);
+	if (cs == nullptr)  // not in the engine snapshot yet
+		return false;
+	bool metered = mainButton->setLevel(cs->level.peak);
+	if (!needsRefresh(cs->status, cs->recStatus, 0, 0)) {
+		if (metered)
+			mainButton->redraw();
+		return metered;
+	}
+	setColorsByStatus(cs->status, cs->recStatus);
 	mainButton->redraw();
+	return true;
 }
 
 
@@ -279,6 +303,7 @@ void geMidiChannel::refresh()
 
 void geMidiChannel::reset()
 {
+	markDirty();
 	mainButton->setDefaultMode("-- MIDI --");
 	mainButton->redraw();
 }
@@ -291,6 +316,8 @@ void geMidiChannel::update()
 {
 	const MidiChannel* mch = static_cast<const MidiChannel*>(ch);
 
+	markDirty();
+
 	string label; 
 	if (mch->name.empty())
 		label = "-- MIDI --";
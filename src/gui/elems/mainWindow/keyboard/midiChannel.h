@@ -53,7 +53,7 @@ public:
 
 	void reset() override;
 	void update() override;
-	void refresh() override;
+	bool refresh() override;
 
 	int keyPress(int event);  // TODO - move to base class
 };
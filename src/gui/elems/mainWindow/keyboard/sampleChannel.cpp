@@ -31,6 +31,7 @@
 #include "../../../../core/graphics.h"
 #include "../../../../core/wave.h"
 #include "../../../../core/sampleChannel.h"
+#include "../../../../core/uiState.h"
 #include "../../../../glue/io.h"
 #include "../../../../glue/channel.h"
 #include "../../../../glue/recorder.h"
@@ -40,6 +41,7 @@
 #include "../../../dialogs/gd_keyGrabber.h"
 #include "../../../dialogs/sampleEditor.h"
 #include "../../../dialogs/channelNameInput.h"
+#include "../../../dialogs/channelSends.h"
 #include "../../../dialogs/gd_actionEditor.h"
 #include "../../../dialogs/gd_warnings.h"
 #include "../../../dialogs/browser/browserSave.h"
@@ -71,6 +73,9 @@ enum class Menu
 	SETUP_KEYBOARD_INPUT,
 	SETUP_MIDI_INPUT,
 	SETUP_MIDI_OUTPUT,
+#ifdef WITH_VST
+	SETUP_SENDS,
+#endif
 	EDIT_SAMPLE,
 	EDIT_ACTIONS,
 	CLEAR_ACTIONS,
@@ -87,6 +92,7 @@ enum class Menu
 	__END_RESIZE_SUBMENU__,
 	RENAME_CHANNEL,
 	CLONE_CHANNEL,
+	FREEZE_CHANNEL,
 	FREE_CHANNEL,
 	DELETE_CHANNEL
 };
@@ -133,6 +139,12 @@ void menuCallback(Fl_Widget* w, void* v)
 			gu_openSubWindow(G_MainWin, new gdMidiOutputSampleCh(static_cast<SampleChannel*>(gch->ch)), 0);
 			break;
 		}
+#ifdef WITH_VST
+		case Menu::SETUP_SENDS: {
+			gu_openSubWindow(G_MainWin, new gdChannelSends(gch->ch), WID_CHANNEL_SENDS);
+			break;
+		}
+#endif
 		case Menu::EDIT_SAMPLE: {
 			gu_openSubWindow(G_MainWin, new gdSampleEditor(static_cast<SampleChannel*>(gch->ch)), WID_SAMPLE_EDITOR);
 			break;
@@ -163,29 +175,29 @@ void menuCallback(Fl_Widget* w, void* v)
 			break;
 		}
 		case Menu::RESIZE_H1: {
-			gch->changeSize(G_GUI_CHANNEL_H_1);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_1);
 			break;
 		}		
 		case Menu::RESIZE_H2: {
-			gch->changeSize(G_GUI_CHANNEL_H_2);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_2);
 			break;
 		}		
 		case Menu::RESIZE_H3: {
-			gch->changeSize(G_GUI_CHANNEL_H_3);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_3);
 			break;
 		}		
 		case Menu::RESIZE_H4: {
-			gch->changeSize(G_GUI_CHANNEL_H_4);
-			static_cast<geColumn*>(gch->parent())->repositionChannels();
+			static_cast<geColumn*>(gch->parent())->setChannelSize(gch->ch, G_GUI_CHANNEL_H_4);
 			break;
 		}
 		case Menu::CLONE_CHANNEL: {
 			c::channel::cloneChannel(gch->ch);
 			break;
 		}
+		case Menu::FREEZE_CHANNEL: {
+			c::channel::toggleFreeze(gch->ch);
+			break;
+		}
 		case Menu::RENAME_CHANNEL: {
 			gu_openSubWindow(G_MainWin, new gdChannelNameInput(gch->ch), WID_SAMPLE_NAME);
 			break;
@@ -306,6 +318,9 @@ void geSampleChannel::cb_openMenu()
 		{"Setup keyboard input...",  0, menuCallback, (void*) Menu::SETUP_KEYBOARD_INPUT},
 		{"Setup MIDI input...",      0, menuCallback, (void*) Menu::SETUP_MIDI_INPUT},
 		{"Setup MIDI output...",     0, menuCallback, (void*) Menu::SETUP_MIDI_OUTPUT},
+#ifdef WITH_VST
+		{"Send levels...",          0, menuCallback, (void*) Menu::SETUP_SENDS},
+#endif
 		{"Edit sample...",           0, menuCallback, (void*) Menu::EDIT_SAMPLE},
 		{"Edit actions...",          0, menuCallback, (void*) Menu::EDIT_ACTIONS},
 		{"Clear actions",            0, menuCallback, (void*) Menu::CLEAR_ACTIONS, FL_SUBMENU},
@@ -322,6 +337,7 @@ void geSampleChannel::cb_openMenu()
 			{0},
 		{"Rename channel", 0, menuCallback, (void*) Menu::RENAME_CHANNEL},
 		{"Clone channel",  0, menuCallback, (void*) Menu::CLONE_CHANNEL},
+		{ch->isFrozen() ? "Unfreeze channel" : "Freeze channel", 0, menuCallback, (void*) Menu::FREEZE_CHANNEL},
 		{"Free channel",   0, menuCallback, (void*) Menu::FREE_CHANNEL},
 		{"Delete channel", 0, menuCallback, (void*) Menu::DELETE_CHANNEL},
 		{0}
@@ -331,6 +347,7 @@ void geSampleChannel::cb_openMenu()
 		rclick_menu[(int) Menu::EXPORT_SAMPLE].deactivate();
 		rclick_menu[(int) Menu::EDIT_SAMPLE].deactivate();
 		rclick_menu[(int) Menu::FREE_CHANNEL].deactivate();
+		rclick_menu[(int) Menu::FREEZE_CHANNEL].deactivate();
 		rclick_menu[(int) Menu::RENAME_CHANNEL].deactivate();
 	}
 
@@ -370,25 +387,45 @@ void geSampleChannel::cb_readActions()
 /* -------------------------------------------------------------------------- */
 
 
-void geSampleChannel::refresh()
+bool geSampleChannel::refresh()
 {
 	using namespace giada;
 	
 	if (!mainButton->visible()) // mainButton invisible? status too (see below)
-		return;
+		return false;
+
+	const m::uiState::State&        state = m::uiState::get();
+	const m::uiState::ChannelState* cs    = m::uiState::getChannel(ch->index);
+	if (cs == nullptr)  // not in the engine snapshot yet
+		return false;
+
+	bool hasWave   = static_cast<SampleChannel*>(ch)->wave != nullptr;
+	bool inputRec  = hasWave && state.recording && ch->armed;
+	bool actionRec = hasWave && m::recorder::active && 
+	                 m::recorder::canRec(ch, state.running, state.recording);
 
-	setColorsByStatus(ch->status, ch->recStatus);
+	/* The level strip changes on its own: redraw just the button for it. */
 
-	if (static_cast<SampleChannel*>(ch)->wave != nullptr) {
-		if (m::mixer::recording && ch->armed)
+	bool metered = mainButton->setLevel(cs->level.peak);
+
+	if (!needsRefresh(cs->status, cs->recStatus, 
+	    status->getProgress(cs->position, cs->length), (inputRec ? 1 : 0) | (actionRec ? 2 : 0))) {
+		if (metered)
+			mainButton->redraw();
+		return metered;
+	}
+
+	setColorsByStatus(cs->status, cs->recStatus);
+
+	if (hasWave) {
+		if (inputRec)
 			mainButton->setInputRecordMode();
-		if (m::recorder::active) {
-			if (m::recorder::canRec(ch, m::clock::isRunning(), m::mixer::recording))
-				mainButton->setActionRecordMode();
-		}
+		if (actionRec)
+			mainButton->setActionRecordMode();
 		status->redraw(); // status invisible? sampleButton too (see below)
 	}
 	mainButton->redraw();
+	return true;
 }
 
 
@@ -397,6 +434,7 @@ void geSampleChannel::refresh()
 
 void geSampleChannel::reset()
 {
+	markDirty();
 	hideActionButton();
 	mainButton->setDefaultMode("-- no sample --");
 	mainButton->redraw();
@@ -411,6 +449,8 @@ void geSampleChannel::update()
 {
 	const SampleChannel* sch = static_cast<const SampleChannel*>(ch);
 
+	markDirty();
+
 	switch (sch->status) {
 		case STATUS_EMPTY:
 			mainButton->label("-- no sample --");
@@ -457,6 +497,17 @@ void geSampleChannel::update()
 /* -------------------------------------------------------------------------- */
 
 
+void geSampleChannel::bind(Channel* c)
+{
+	status->ch = static_cast<SampleChannel*>(c);
+	modeBox->setChannel(static_cast<SampleChannel*>(c));
+	geChannel::bind(c);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
 void geSampleChannel::showActionButton()
 {
 	readActions->value(static_cast<SampleChannel*>(ch)->readActions);
@@ -56,8 +56,9 @@ public:
 
 	void reset() override;
 	void update() override;
-	void refresh() override;
+	bool refresh() override;
 	void changeSize(int h) override;
+	void bind(Channel* ch) override;
 
 	/* show/hideActionButton
 	Adds or removes 'R' button when actions are available. */
@@ -29,6 +29,7 @@
 #include "../../../core/graphics.h"
 #include "../../../core/mixer.h"
 #include "../../../core/pluginHost.h"
+#include "../../../core/uiState.h"
 #include "../../../glue/main.h"
 #include "../../../utils/gui.h"
 #include "../../elems/soundMeter.h"
@@ -173,10 +174,18 @@ void geMainIO::setMasterFxInFull(bool v)
 /* -------------------------------------------------------------------------- */
 
 
-void geMainIO::refresh()
+bool geMainIO::refresh()
 {
-	outMeter->mixerPeak = mixer::peakOut;
-	inMeter->mixerPeak  = mixer::peakIn;
-	outMeter->redraw();
-	inMeter->redraw();
+	const uiState::State& state = uiState::get();
+
+	bool changed = false;
+	if (outMeter->setLevel(state.out.peak, state.out.rms)) {
+		outMeter->redraw();
+		changed = true;
+	}
+	if (inMeter->setLevel(state.in.peak, state.in.rms)) {
+		inMeter->redraw();
+		changed = true;
+	}
+	return changed;
 }
@@ -72,7 +72,11 @@ public:
 
 	geMainIO(int x, int y);
 
-	void refresh();
+	/* refresh
+	Redraws the meters if the levels changed or they are still decaying or 
+	holding a peak. Returns true if so. */
+
+	bool refresh();
 
 	void setOutVol(float v);
 	void setInVol (float v);
@@ -25,6 +25,7 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <cstdint>
 #include <FL/Fl_Menu_Button.H>
 #include "../../../core/const.h"
 #include "../../../core/mixer.h"
@@ -33,7 +34,11 @@
 #include "../../../core/patch.h"
 #include "../../../core/channel.h"
 #include "../../../core/sampleChannel.h"
+#include "../../../core/trace.h"
+#include "../../../core/eventLog.h"
+#include "../../../core/renderer.h"
 #include "../../../utils/gui.h"
+#include "../../../utils/fs.h"
 #include "../../../glue/storage.h"
 #include "../../../glue/main.h"
 #include "../../elems/basics/boxtypes.h"
@@ -42,6 +47,7 @@
 #include "../../dialogs/gd_about.h"
 #include "../../dialogs/gd_config.h"
 #include "../../dialogs/gd_warnings.h"
+#include "../../dialogs/profiler.h"
 #include "../../dialogs/browser/browserLoad.h"
 #include "../../dialogs/browser/browserSave.h"
 #include "../../dialogs/midiIO/midiInputMaster.h"
@@ -55,6 +61,57 @@ extern gdMainWindow* G_MainWin;
 using namespace giada::m;
 
 
+namespace
+{
+/* exportId
+Tells the current export from stale Fl::awake() notifications of an earlier 
+one, already joined by renderer::waitStems(). Main thread only. */
+
+int exportId = 0;
+
+
+/* -------------------------------------------------------------------------- */
+
+
+std::string getStemsPath()
+{
+	return gu_getHomePath() + G_SLASH + "giada-stems";
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* onStemsExported
+Called on the main thread via Fl::awake() when the render is over. */
+
+void onStemsExported(void* p)
+{
+	if ((intptr_t) p != exportId || !renderer::isExportingStems())
+		return;
+	std::string msg = renderer::waitStems(false) == G_RES_OK ? 
+		"Stems saved to " + getStemsPath() : "Unable to export stems.";
+	gdAlert(msg.c_str());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void exportStems()
+{
+	intptr_t id = ++exportId;
+	auto done = [id](int) { Fl::awake(onStemsExported, (void*) id); };
+	if (renderer::startStems(getStemsPath(), 1, done) != G_RES_OK)
+		gdAlert("Unable to export stems.");
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+
+
 geMainMenu::geMainMenu(int x, int y)
 	: Fl_Group(x, y, 300, 20)
 {
@@ -114,10 +171,20 @@ void geMainMenu::__cb_file()
 		{"Open patch or project..."},
 		{"Save patch..."},
 		{"Save project..."},
+		{renderer::isExportingStems() ? "Exporting stems..." : "Export stems..."},
 		{"Quit Giada"},
 		{0}
 	};
 
+	/* The engine can't be torn down under a stem export: no loading, no second
+	export, no quitting until it's over. */
+
+	if (renderer::isExportingStems()) {
+		menu[0].deactivate();
+		menu[3].deactivate();
+		menu[4].deactivate();
+	}
+
 	Fl_Menu_Button* b = new Fl_Menu_Button(0, 0, 100, 50);
 	b->box(G_CUSTOM_BORDER_BOX);
 	b->textsize(G_GUI_FONT_SIZE_BASE);
@@ -151,6 +218,10 @@ void geMainMenu::__cb_file()
 		gu_openSubWindow(G_MainWin, childWin, WID_FILE_BROWSER);
 		return;
 	}
+	if (strcmp(m->label(), "Export stems...") == 0) {
+		exportStems();
+		return;
+	}
 	if (strcmp(m->label(), "Quit Giada") == 0) {
 		G_MainWin->do_callback();
 		return;
@@ -169,6 +240,12 @@ void geMainMenu::__cb_edit()
 		{"Remove empty columns"},
 		{"Reset to init state"},
 		{"Setup global MIDI input..."},
+		{"DSP profiler..."},
+		{eventLog::isCapturing() ? "Stop input capture" : "Start input capture"},
+		{eventLog::isReplaying() ? "Stop input replay" : "Replay input capture"},
+#ifdef WITH_TRACE
+		{trace::isEnabled() ? "Stop tracing" : "Start tracing"},
+#endif
 		{0}
 	};
 
@@ -177,6 +254,12 @@ void geMainMenu::__cb_edit()
 
 	menu[1].deactivate();
 
+	/* Captured inputs can be replayed only by the null sound system, which runs
+	at a pace that doesn't depend on hardware. */
+
+	if (conf::soundSystem != G_SYS_API_NULL)
+		menu[7].deactivate();
+
 	for (unsigned i=0; i<mixer::channels.size(); i++)
 		if (mixer::channels.at(i)->hasActions) {
 			menu[1].activate();
@@ -189,6 +272,12 @@ void geMainMenu::__cb_edit()
 				break;
 			}
 
+	/* Same as in the file menu: a reset would free what a stem export is 
+	using. */
+
+	if (renderer::isExportingStems())
+		menu[3].deactivate();
+
 	Fl_Menu_Button* b = new Fl_Menu_Button(0, 0, 100, 50);
 	b->box(G_CUSTOM_BORDER_BOX);
 	b->textsize(G_GUI_FONT_SIZE_BASE);
@@ -226,4 +315,43 @@ void geMainMenu::__cb_edit()
 		gu_openSubWindow(G_MainWin, new gdMidiInputMaster(), 0);
 		return;
 	}
+	if (strcmp(m->label(), "DSP profiler...") == 0) {
+		gu_openSubWindow(G_MainWin, new gdProfiler(), WID_PROFILER);
+		return;
+	}
+	if (strcmp(m->label(), "Start input capture") == 0) {
+		eventLog::startCapture();
+		return;
+	}
+	if (strcmp(m->label(), "Stop input capture") == 0) {
+		std::string path = gu_getHomePath() + G_SLASH + "giada-input.gev";
+		std::string msg  = eventLog::stopCapture(path) == G_RES_OK ? 
+			"Input capture saved to " + path : "Unable to save the input capture.";
+		gdAlert(msg.c_str());
+		return;
+	}
+	if (strcmp(m->label(), "Replay input capture") == 0) {
+		std::string path = gu_getHomePath() + G_SLASH + "giada-input.gev";
+		if (eventLog::startReplay(path) != G_RES_OK)
+			gdAlert(("Unable to replay " + path).c_str());
+		return;
+	}
+	if (strcmp(m->label(), "Stop input replay") == 0) {
+		eventLog::stopReplay();
+		return;
+	}
+#ifdef WITH_TRACE
+	if (strcmp(m->label(), "Start tracing") == 0) {
+		trace::setEnabled(true);
+		return;
+	}
+	if (strcmp(m->label(), "Stop tracing") == 0) {
+		trace::setEnabled(false);
+		std::string path = gu_getHomePath() + G_SLASH + "giada-trace.json";
+		std::string msg  = trace::dump(path) ? "Trace saved to " + path : 
+			"Unable to save the trace.";
+		gdAlert(msg.c_str());
+		return;
+	}
+#endif
 }
@@ -96,4 +96,15 @@ void gePluginParameter::update(bool changeSlider)
 }
 
 
+/* -------------------------------------------------------------------------- */
+
+
+void gePluginParameter::update(float value, bool changeSlider)
+{
+	update(false);
+	if (changeSlider)
+		m_slider->value(value);
+}
+
+
 #endif // #ifdef WITH_VST
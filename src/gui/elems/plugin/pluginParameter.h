@@ -61,6 +61,12 @@ public:
 	gePluginParameter(int paramIndex, Plugin* p, int x, int y, int w, int labelWidth);
 
 	void update(bool changeSlider);
+
+	/* update (2)
+	Same as above, with the slider set to 'value' instead of the one currently
+	held by the plug-in. */
+
+	void update(float value, bool changeSlider);
 };
 
 
@@ -70,12 +70,17 @@ void geVolumeTool::refresh()
 {
   using namespace giada::u;
 
+  /* The channel dial holds the volume not yet applied by the audio thread. No
+  dial if the channel is scrolled out of view. */
+
+  float vol = ch->guiChannel != nullptr ? ch->guiChannel->vol->value() : ch->volume;
+
   string tmp;
-  float dB = math::linearToDB(ch->volume);
+  float dB = math::linearToDB(vol);
   if (dB > -INFINITY) tmp = gu_fToString(dB, 2);  // 2 digits
   else                tmp = "-inf";
   input->value(tmp.c_str());
-  dial->value(ch->guiChannel->vol->value());
+  dial->value(vol);
 }
 
 
@@ -107,5 +112,5 @@ void geVolumeTool::__cb_setVolumeNum()
 
   float value = pow(10, (atof(input->value()) / 20)); // linear = 10^(dB/20)
   c::channel::setVolume(ch, value, false, true);
-  dial->value(ch->guiChannel->vol->value());
+  dial->value(value);
 }
@@ -148,32 +148,20 @@ int geWaveform::alloc(int datasize, bool force)
 		int pc = i     * m_ratio;  // current point TODO - int until we switch to uint32_t for Wave size...
 		int pn = (i+1) * m_ratio;  // next point    TODO - int until we switch to uint32_t for Wave size...
 
-		float peaksup = 0.0f;
-		float peakinf = 0.0f;
+		if (pn > wave->getSize())
+			pn = wave->getSize();
 
-		for (int k=pc; k<pn; k++) { // TODO - int until we switch to uint32_t for Wave size...
+		/* Find peaks (greater and lower). */
 
-			if (k >= wave->getSize())
-				continue;
+		float peaksup, peakinf;
+		wfx::getPeaks(*wave, pc, pn, peaksup, peakinf);
 
-			/* Compute average of stereo signal. */
+		/* Fill up grid vector. */
 
-			float avg = 0.0f;
-			float* frame = wave->getFrame(k);
-			for (int j=0; j<wave->getChannels(); j++)
-				avg += frame[j];
-			avg /= wave->getChannels();
-			
-			/* Find peaks (greater and lower). */
-
-			if      (avg > peaksup)  peaksup = avg;
-			else if (avg <= peakinf) peakinf = avg;
-
-			/* Fill up grid vector. */
-
-			if (gridFreq != 0 && (int) k % gridFreq == 0 && k != 0)
-				m_grid.points.push_back(k);
-		}
+		if (gridFreq != 0)
+			for (int k=pc; k<pn; k++)
+				if (k % gridFreq == 0 && k != 0)
+					m_grid.points.push_back(k);
 
 		m_data.sup[i] = zero - (peaksup * m_ch->getBoost() * offset);
 		m_data.inf[i] = zero - (peakinf * m_ch->getBoost() * offset);
@@ -26,6 +26,7 @@
 
 
 #include <cmath>
+#include <algorithm>
 #include <FL/fl_draw.H>
 #include "../../core/const.h"
 #include "../../core/kernelAudio.h"
@@ -35,53 +36,102 @@
 using namespace giada::m;
 
 
-geSoundMeter::geSoundMeter(int x, int y, int w, int h, const char *L)
-  : Fl_Box    (x, y, w, h, L),
-    clip      (false),
-    mixerPeak (0.0f),
-    peak      (0.0f),
-    dbLevel   (0.0f),
-    dbLevelOld(0.0f)
+namespace
+{
+float toDb(float v)
 {
+  return v > 0.0f ? std::max(20 * log10f(v), -G_MIN_DB_SCALE) : -G_MIN_DB_SCALE;
 }
+} // {anonymous}
 
 
 /* -------------------------------------------------------------------------- */
 
 
-void geSoundMeter::draw()
+geSoundMeter::Level::Level()
+  : peakDb    (-G_MIN_DB_SCALE),
+    rmsDb     (-G_MIN_DB_SCALE),
+    holdDb    (-G_MIN_DB_SCALE),
+    holdCycles(0)
 {
-  fl_rect(x(), y(), w(), h(), G_COLOR_GREY_4);
+}
 
-  /* peak = the highest value inside the frame */
 
-  peak = 0.0f;
-  float tmp_peak = 0.0f;
+/* -------------------------------------------------------------------------- */
 
-  tmp_peak = fabs(mixerPeak);
-  if (tmp_peak > peak)
-    peak = tmp_peak;
 
-  clip = peak >= 1.0f ? true : false; // 1.0f is considered clip
+bool geSoundMeter::Level::update(float peak, float rms)
+{
+  float newPeak = std::max(toDb(peak), std::max(peakDb - 2.0f, -G_MIN_DB_SCALE));
+  float newRms  = toDb(rms);
+  float newHold = holdDb;
 
+  /* Hold the highest peak, then let it follow the decaying peak. */
 
-  /*  dBFS (full scale) calculation, plus decay of -2dB per frame */
+  if (newPeak >= holdDb) {
+    newHold    = newPeak;
+    holdCycles = G_GUI_PEAK_HOLD;
+  }
+  else
+  if (holdCycles > 0)
+    holdCycles--;
+  else
+    newHold = newPeak;
 
-  dbLevel = 20 * log10(peak);
-  if (dbLevel < dbLevelOld)
-    if (dbLevelOld > -G_MIN_DB_SCALE)
-      dbLevel = dbLevelOld - 2.0f;
+  bool changed = newPeak != peakDb || newRms != rmsDb || newHold != holdDb;
 
-  dbLevelOld = dbLevel;
+  peakDb = newPeak;
+  rmsDb  = newRms;
+  holdDb = newHold;
+  return changed;
+}
 
-  /* graphical part */
 
-  float px_level = 0.0f;
-  if (dbLevel < 0.0f)
-    px_level = ((w()/G_MIN_DB_SCALE) * dbLevel) + w();
-  else
-    px_level = w();
+/* -------------------------------------------------------------------------- */
+
+
+int geSoundMeter::Level::toPx(float db, int w)
+{
+  return (int) ((w / G_MIN_DB_SCALE) * std::min(db, 0.0f) + w);
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+geSoundMeter::geSoundMeter(int x, int y, int w, int h, const char *L)
+  : Fl_Box(x, y, w, h, L)
+{
+}
+
+
+/* -------------------------------------------------------------------------- */
 
+
+void geSoundMeter::draw()
+{
+  fl_rect(x(), y(), w(), h(), G_COLOR_GREY_4);
   fl_rectf(x()+1, y()+1, w()-2, h()-2, G_COLOR_GREY_2);
-  fl_rectf(x()+1, y()+1, (int) px_level, h()-2, clip || !kernelAudio::getStatus() ? G_COLOR_RED_ALERT : G_COLOR_GREY_4);
+
+  /* Peak in the background, RMS on top of it. 0 dBFS or more is considered 
+  clipping. */
+
+  bool clip = level.holdDb >= 0.0f || !kernelAudio::getStatus();
+
+  fl_rectf(x()+1, y()+1, Level::toPx(level.peakDb, w()-2), h()-2, G_COLOR_GREY_3);
+  fl_rectf(x()+1, y()+1, Level::toPx(level.rmsDb, w()-2), h()-2, clip ? G_COLOR_RED_ALERT : G_COLOR_GREY_4);
+
+  if (level.holdDb > -G_MIN_DB_SCALE) {
+    int hx = x() + Level::toPx(level.holdDb, w()-2);
+    fl_rectf(hx, y()+1, 1, h()-2, clip ? G_COLOR_RED_ALERT : G_COLOR_LIGHT_1);
+  }
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+bool geSoundMeter::setLevel(float peak, float rms)
+{
+  return level.update(peak, rms);
 }
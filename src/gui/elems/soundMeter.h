@@ -36,18 +36,45 @@ class geSoundMeter : public Fl_Box
 {
 public:
 
+  /* Level
+  What a meter shows, given the levels published by the engine: peak with a 
+  decay of 2 dB per refresh, RMS and the highest recent peak, held for 
+  G_GUI_PEAK_HOLD refreshes. Values in dBFS, floored at -G_MIN_DB_SCALE. Used 
+  by channel meters too. */
+
+  struct Level
+  {
+    Level();
+
+    /* update
+    Feeds the latest peak and RMS, linear scale. Returns true if anything 
+    changed, i.e. the meter has to be redrawn. */
+
+    bool update(float peak, float rms);
+
+    /* toPx
+    Converts a dB value to a bar length over 'w' pixels. */
+
+    static int toPx(float db, int w);
+
+    float peakDb;
+    float rmsDb;
+    float holdDb;
+    int   holdCycles;
+  };
+
   geSoundMeter(int X, int Y, int W, int H, const char *L=0);
 
   void draw() override;
 
-  bool clip;
-	float mixerPeak;	// peak from mixer
+  /* setLevel
+  Returns true if the meter needs redrawing. See Level::update(). */
+
+  bool setLevel(float peak, float rms);
 
 private:
 
-	float peak;
-	float dbLevel;
-	float dbLevelOld;
+  Level level;
 };
 
 
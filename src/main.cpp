@@ -25,6 +25,10 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 #include <pthread.h>
 #if defined(__linux__) || defined(__APPLE__)
 	#include <unistd.h>
@@ -41,7 +45,10 @@
 #include "core/kernelAudio.h"
 #include "core/kernelMidi.h"
 #include "core/recorder.h"
+#include "core/renderer.h"
+#include "core/benchmark.h"
 #include "utils/gui.h"
+#include "utils/log.h"
 #include "utils/time.h"
 #include "gui/dialogs/gd_mainWindow.h"
 #include "core/pluginHost.h"
@@ -53,12 +60,19 @@ gdMainWindow* G_MainWin;
 
 
 void* videoThreadCb(void* arg);
+int   render(int argc, char** argv);
+int   bench(int argc, char** argv);
 
 
 int main(int argc, char** argv)
 {
 	G_quit = false;
 
+	if (argc > 1 && strcmp(argv[1], "--render") == 0)
+		return render(argc, argv);
+	if (argc > 1 && strcmp(argv[1], "--bench") == 0)
+		return bench(argc, argv);
+
 	init_prepareParser();
 	init_prepareMidiMap();
 	init_prepareKernelAudio();
@@ -88,11 +102,197 @@ void* videoThreadCb(void* arg)
 {
 	using namespace giada;
 
+	/* Refresh at full rate while something changes, slow down after a while of
+	inactivity. */
+
+	int idleCycles = 0;
+
 	if (m::kernelAudio::getStatus())
 		while (!G_quit)	{
-			gu_refreshUI();
-			u::time::sleep(G_GUI_REFRESH_RATE);
+			idleCycles = gu_refreshUI() ? 0 : idleCycles + 1;
+			u::time::sleep(idleCycles < G_GUI_IDLE_CYCLES ? G_GUI_REFRESH_RATE : G_GUI_IDLE_RATE);
 		}
 	pthread_exit(nullptr);
 	return 0;
 }
+
+
+/* render
+Headless mode: renders a patch offline and quits. Usage:
+
+	giada --render <patch or project> <output.wav|.flac> [options]
+
+	--loops N        render N loops (default 1)
+	--from S --to S  render a time range in seconds instead
+	--start-loops    start all loop channels on the first frame
+	--stems          render each channel to its own file, the output being a
+	                 directory; takes --loops only */
+
+int render(int argc, char** argv)
+{
+	using namespace giada;
+
+	if (argc < 4) {
+		fprintf(stderr, "usage: %s --render <patch> <output.wav|.flac> "
+			"[--loops N | --from S --to S] [--start-loops] [--stems]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::string input  = argv[2];
+	std::string output = argv[3];
+	int   loops      = 1;
+	float from       = -1.0f;
+	float to         = -1.0f;
+	bool  startLoops = false;
+	bool  stems      = false;
+
+	for (int i=4; i<argc; i++) {
+		if (strcmp(argv[i], "--loops") == 0 && i + 1 < argc)
+			loops = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--from") == 0 && i + 1 < argc)
+			from = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--to") == 0 && i + 1 < argc)
+			to = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--start-loops") == 0)
+			startLoops = true;
+		else
+		if (strcmp(argv[i], "--stems") == 0)
+			stems = true;
+		else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	init_prepareParser();
+	init_prepareKernelAudio(true);
+
+#ifdef WITH_VST
+	juce::initialiseJuce_GUI();
+#endif
+
+	int res = m::renderer::loadPatch(input);
+	if (res == G_RES_OK && stems)
+		res = m::renderer::renderStems(output, loops);
+	else
+	if (res == G_RES_OK) {
+		int frameA = 0;
+		int frameB = loops * (m::clock::getFramesInLoop() + 1);
+		if (from >= 0.0f && to > from) {
+			frameA = from * m::conf::samplerate;
+			frameB = to * m::conf::samplerate;
+		}
+		res = m::renderer::render(output, frameA, frameB, startLoops);
+	}
+
+	/* With the realtime audit mode, a render that blocked the audio thread is a 
+	failure: this is how scripts check the engine. */
+
+	int violations = init_shutdownOffline();
+
+#ifdef WITH_VST
+	juce::shutdownJuce_GUI();
+#endif
+
+	if (violations > 0)
+		fprintf(stderr, "%d realtime violations, see the log\n", violations);
+	return res == G_RES_OK && violations == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+
+/* bench
+Headless mode: runs the engine benchmarks on a synthetic session and quits. 
+Usage:
+
+	giada --bench [options]
+
+	--json PATH      write results to PATH; without it they go to stdout, and
+	                 the log to stderr
+	--channels N     sample channels (default 16)
+	--length S       sample length, in seconds (default 2)
+	--pitch P        pitch of each channel (default 1.0)
+	--actions N      recorded actions per channel and bar (default 4)
+	--loops F        share of loop channels, 0.0 to 1.0 (default 0.5)
+	--bpm B --beats N --bars N --quantize N   sequencer setup
+	--plugin ID      plug-in to add to each channel
+	--blocks N       callbacks to time (default 2000)
+	--seed N         random seed (default 1) */
+
+int bench(int argc, char** argv)
+{
+	using namespace giada;
+
+	m::benchmark::Session s;
+	std::string path = "";
+
+	for (int i=2; i<argc; i++) {
+		bool hasValue = i + 1 < argc;
+		if (strcmp(argv[i], "--json") == 0 && hasValue)
+			path = argv[++i];
+		else
+		if (strcmp(argv[i], "--channels") == 0 && hasValue)
+			s.channels = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--length") == 0 && hasValue)
+			s.length = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--pitch") == 0 && hasValue)
+			s.pitch = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--actions") == 0 && hasValue)
+			s.actions = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--loops") == 0 && hasValue)
+			s.loops = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--bpm") == 0 && hasValue)
+			s.bpm = atof(argv[++i]);
+		else
+		if (strcmp(argv[i], "--beats") == 0 && hasValue)
+			s.beats = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--bars") == 0 && hasValue)
+			s.bars = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--quantize") == 0 && hasValue)
+			s.quantize = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--plugin") == 0 && hasValue)
+			s.plugin = argv[++i];
+		else
+		if (strcmp(argv[i], "--blocks") == 0 && hasValue)
+			s.blocks = atoi(argv[++i]);
+		else
+		if (strcmp(argv[i], "--seed") == 0 && hasValue)
+			s.seed = atoi(argv[++i]);
+		else {
+			fprintf(stderr, "unknown option %s\n", argv[i]);
+			return EXIT_FAILURE;
+		}
+	}
+
+	/* Results go to stdout if no file is given: keep the log out of them. */
+
+	if (path == "")
+		gu_logToStderr();
+
+	init_prepareParser();
+	init_prepareKernelAudio(true);
+
+#ifdef WITH_VST
+	juce::initialiseJuce_GUI();
+#endif
+
+	int res = m::benchmark::run(s, path);
+
+	init_shutdownOffline();
+
+#ifdef WITH_VST
+	juce::shutdownJuce_GUI();
+#endif
+
+	return res == G_RES_OK ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -40,11 +40,19 @@
 #include "../core/channel.h"
 #include "../core/conf.h"
 #include "../core/graphics.h"
+#include "../core/kernelMidi.h"
+#include "../core/uiState.h"
+#include "../core/profiler.h"
+#include "../core/trace.h"
+#include "../core/eventLog.h"
+#include "../glue/main.h"
+#include "../glue/transport.h"
 #include "../gui/dialogs/gd_warnings.h"
 #include "../gui/dialogs/gd_mainWindow.h"
 #include "../gui/dialogs/gd_actionEditor.h"
 #include "../gui/dialogs/window.h"
 #include "../gui/dialogs/sampleEditor.h"
+#include "../gui/dialogs/profiler.h"
 #include "../gui/elems/mainWindow/mainIO.h"
 #include "../gui/elems/mainWindow/mainTimer.h"
 #include "../gui/elems/mainWindow/mainTransport.h"
@@ -65,18 +73,70 @@ using namespace giada::m;
 
 
 static int blinker = 0;
+static int profilerTimer = 0;
 
 
-void gu_refreshUI()
+/* -------------------------------------------------------------------------- */
+
+/* processEngineEvents
+Carries out the requests queued by the audio thread, which can't call into glue
+code or send MIDI by itself. Must be called without the FLTK lock held: glue 
+functions take it when needed. */
+
+static void processEngineEvents()
+{
+	/* Requests come from JACK transport changes, already captured as such. */
+
+	eventLog::Derived derived;
+
+	uiState::Event e;
+	while (uiState::popEvent(e)) {
+		switch (e.type) {
+			case uiState::TRANSPORT_START:
+				if (!clock::isRunning())
+					glue_startSeq(false); // not from UI
+				break;
+			case uiState::TRANSPORT_STOP:
+				if (clock::isRunning())
+					glue_stopSeq(false); // not from UI
+				break;
+			case uiState::TRANSPORT_REWIND:
+				glue_rewindSeq(false, false);  // not from UI, don't notify jack (avoid loop)
+				break;
+			case uiState::SET_BPM:
+				Fl::lock();
+				glue_setBpm(e.fValue);
+				Fl::unlock();
+				break;
+			case uiState::MIDI_LIGHTNING:
+				kernelMidi::send(e.iValue);
+				break;
+		}
+	}
+}
+
+
+bool gu_refreshUI()
 {
+	G_TRACE_THREAD("video");
+	G_TRACE_SCOPE("gu_refreshUI");
+
+	processEngineEvents();
+
 	Fl::lock();
 
-	/* update dynamic elements: in and out meters, beat meter and
-	 * each channel */
+	/* Pick up the latest engine snapshot: widgets read from it while drawing,
+	which happens under the same lock. */
+
+	uiState::update();
+
+	/* update dynamic elements: in and out meters, beat meter and each channel. 
+	Each one redraws only if its state changed since the last cycle. */
 
-	G_MainWin->mainIO->refresh();
-	G_MainWin->beatMeter->redraw();
-	G_MainWin->keyboard->refreshColumns();
+	bool changed = false;
+	changed |= G_MainWin->mainIO->refresh();
+	changed |= G_MainWin->beatMeter->refresh();
+	changed |= G_MainWin->keyboard->refreshColumns();
 
 	/* compute timer for blinker */
 
@@ -87,13 +147,33 @@ void gu_refreshUI()
 	/* If Sample Editor is open, repaint it (for dynamic play head). */
 
 	gdSampleEditor* se = static_cast<gdSampleEditor*>(gu_getSubwindow(G_MainWin, WID_SAMPLE_EDITOR));
-	if (se != nullptr)
+	if (se != nullptr) {
 		se->waveTools->redrawWaveformAsync();
+		changed = true;
+	}
+
+	/* Drain the profiler queue on each cycle, so that it never fills up; the 
+	window is updated a few times per second, text is not meant to flicker. */
+
+	if (profiler::isEnabled()) {
+		profiler::collect();
+		gdProfiler* pr = static_cast<gdProfiler*>(gu_getSubwindow(G_MainWin, WID_PROFILER));
+		if (pr != nullptr && ++profilerTimer >= G_PROFILER_REFRESH) {
+			pr->refresh();
+			profilerTimer = 0;
+			changed = true;
+		}
+	}
+
+	if (eventLog::isCapturing())
+		eventLog::collect();
 
 	/* redraw GUI */
 
 	Fl::unlock();
-	Fl::awake();
+	if (changed)
+		Fl::awake();
+	return changed;
 }
 
 
@@ -112,7 +192,8 @@ int gu_getBlinker()
 void gu_updateControls()
 {
 	for (const Channel* ch : mixer::channels)
-		ch->guiChannel->update();
+		if (ch->guiChannel != nullptr)
+			ch->guiChannel->update();
 
 	G_MainWin->mainIO->setOutVol(mixer::outVol);
 	G_MainWin->mainIO->setInVol(mixer::inVol);
@@ -39,7 +39,7 @@ class gdWindow;
 /* refresh
  * refresh all GUI elements. */
 
-void gu_refreshUI();
+bool gu_refreshUI();
 
 /* getBlinker
 *  return blinker value, used to make widgets blink. */
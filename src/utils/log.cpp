@@ -27,35 +27,124 @@
  * -------------------------------------------------------------------------- */
 
 
+#include <atomic>
 #include <cstdio>
 #include <cstdarg>
 #include <string>
+#include <thread>
 #include "../utils/fs.h"
+#include "../utils/time.h"
 #include "../core/const.h"
+#include "../core/queue.h"
 #include "log.h"
 
 
 using std::string;
 
 
-static FILE *f;
-static int   mode;
-static bool  stat;
+namespace
+{
+/* Message
+A formatted line, waiting for the writer thread. Fixed size, so that producers
+never allocate. */
+
+struct Message
+{
+	char text[G_LOG_LINE];
+};
+
+/* f, console, mode, stat
+'console' and 'stat' are read by any producer writing in place, see gu_log(), 
+while gu_logToStderr() and gu_logClose() change them. */
+
+FILE*              f;
+std::atomic<FILE*> console(stdout);
+int                mode;
+std::atomic<bool>  stat(false);
+
+giada::m::MpscQueue<Message, G_LOG_QUEUE> queue;
+
+std::thread       writer;
+std::atomic<bool> running(false);
+std::atomic<int>  dropped(0);
+std::atomic<int>  producers(0);  // gu_log() calls in progress
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void print(const char* text)
+{
+	if (mode == LOG_MODE_FILE && stat.load()) {
+		fputs(text, f);
+#ifdef _WIN32
+		fflush(f);
+#endif
+	}
+	else
+		fputs(text, console.load());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+/* drain
+Writes out all pending messages. Losses, if any, are reported in the log 
+itself. Writer thread only, or after the writer thread has stopped. */
+
+void drain()
+{
+	Message m;
+	bool    wrote = false;
+	while (queue.pop(m)) {
+		print(m.text);
+		wrote = true;
+	}
+
+	int lost = dropped.exchange(0);
+	if (lost > 0) {
+		char text[64];
+		snprintf(text, sizeof(text), "[log] %d messages dropped\n", lost);
+		print(text);
+		wrote = true;
+	}
+
+	if (wrote && mode != LOG_MODE_FILE)
+		fflush(console.load());
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void run()
+{
+	while (running.load()) {
+		drain();
+		giada::u::time::sleep(G_LOG_SLEEP);
+	}
+}
+} // {anonymous}
+
+
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
+/* -------------------------------------------------------------------------- */
 
 
 int gu_logInit(int m)
 {
 	mode = m;
-	stat = true;
+	bool ok = true;
 	if (mode == LOG_MODE_FILE) {
 		string fpath = gu_getHomePath() + G_SLASH + "giada.log";
-		f = fopen(fpath.c_str(), "a");
-		if (!f) {
-			stat = false;
-			return 0;
-		}
+		f  = fopen(fpath.c_str(), "a");
+		ok = f != nullptr;
 	}
-	return 1;
+	stat.store(ok);
+	running.store(true);
+	writer = std::thread(run);
+	return ok ? 1 : 0;
 }
 
 
@@ -64,8 +153,34 @@ int gu_logInit(int m)
 
 void gu_logClose()
 {
-	if (mode == LOG_MODE_FILE)
+	/* A producer that has seen 'running' still true may push after the writer 
+	thread is gone: wait for it, then write out what's left. */
+
+	if (running.exchange(false)) {
+		writer.join();
+		while (producers.load() > 0)
+			std::this_thread::yield();
+		drain();
+	}
+
+	/* Late messages go to the console from now on. Producers that have seen 
+	'stat' still true may be writing to the file in place: wait for them too
+	before closing it. */
+
+	if (stat.exchange(false) && mode == LOG_MODE_FILE) {
+		while (producers.load() > 0)
+			std::this_thread::yield();
 		fclose(f);
+	}
+}
+
+
+/* -------------------------------------------------------------------------- */
+
+
+void gu_logToStderr()
+{
+	console.store(stderr);
 }
 
 
@@ -76,15 +191,20 @@ void gu_log(const char *format, ...)
 {
 	if (mode == LOG_MODE_MUTE)
 		return;
-  va_list args;
-  va_start(args, format);
-  if (mode == LOG_MODE_FILE && stat == true) {
-		vfprintf(f, format, args);
-#ifdef _WIN32
-		fflush(f);
-#endif
-	}
-  else
-		vprintf(format, args);
-  va_end(args);
+
+	Message m;
+	va_list args;
+	va_start(args, format);
+	vsnprintf(m.text, G_LOG_LINE, format, args);
+	va_end(args);
+
+	/* Until the writer thread starts, and after it's gone, write in place. */
+
+	producers.fetch_add(1);
+	if (!running.load())
+		print(m.text);
+	else
+	if (!queue.push(m))
+		dropped.fetch_add(1, std::memory_order_relaxed);
+	producers.fetch_sub(1);
 }
@@ -33,12 +33,29 @@
 
 /* init
  * init logger. Mode defines where to write the output: LOG_MODE_STDOUT,
- * LOG_MODE_FILE and LOG_MODE_MUTE. */
+ * LOG_MODE_FILE and LOG_MODE_MUTE. Starts the writer thread: messages logged 
+ * before are written in place. */
 
 int  gu_logInit(int mode);
 
+/* close
+Flushes pending messages, stops the writer thread and closes the log file. */
+
 void gu_logClose();
 
+/* logToStderr
+Console output (LOG_MODE_STDOUT, and messages logged before gu_logInit()) goes
+to stderr instead, so that it doesn't mix with data written to stdout. Call it
+before logging anything. */
+
+void gu_logToStderr();
+
+/* log
+Formats the message and hands it to a writer thread, which prints it to stdout
+or giada.log. Never blocks and never allocates, so it can be called from the
+audio thread: messages are truncated to G_LOG_LINE characters, and dropped if 
+G_LOG_QUEUE of them are pending already. */
+
 void gu_log(const char *format, ...);
 
 
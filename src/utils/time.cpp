@@ -40,4 +40,14 @@ void sleep(int millisecs)
 {
 	std::this_thread::sleep_for(std::chrono::milliseconds(millisecs));
 }
+
+
+/* -------------------------------------------------------------------------- */
+
+
+int64_t now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 }}};  // giada::u::time::
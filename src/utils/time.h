@@ -31,11 +31,20 @@
 #define G_UTILS_TIME_H
 
 
+#include <cstdint>
+
+
 namespace giada {
 namespace u     {
 namespace time 
 {
 void sleep(int millisecs);
+
+/* now
+Returns the current time in nanoseconds, from a monotonic clock. Only meaningful
+when compared to other values returned by now(). */
+
+int64_t now();
 }}};
 
 
@@ -0,0 +1,58 @@
+#include <cstdint>
+#include "../src/core/const.h"
+#include "../src/core/audioBuffer.h"
+#include "../src/core/bufferPool.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test bufferPool")
+{
+	using namespace giada::m;
+
+	static const int BUFFER_SIZE = 1023;  // odd on purpose, to test padding
+
+	REQUIRE(bufferPool::init(BUFFER_SIZE, 2) == true);
+
+	SECTION("test acquire")
+	{
+		AudioBuffer a, b;
+		REQUIRE(bufferPool::acquire(a) == true);
+		REQUIRE(bufferPool::acquire(b) == true);
+		REQUIRE(a.countFrames() == BUFFER_SIZE);
+		REQUIRE(a.countChannels() == 2);
+		REQUIRE(reinterpret_cast<uintptr_t>(a[0]) % G_BUFFER_ALIGN == 0);
+		REQUIRE(reinterpret_cast<uintptr_t>(b[0]) % G_BUFFER_ALIGN == 0);
+		REQUIRE(a[0] != b[0]);
+		REQUIRE(bufferPool::countFreeSlots() == G_BUFFER_POOL_CHUNK - 2);
+
+		bufferPool::release(a);
+		bufferPool::release(b);
+		REQUIRE(a.isAllocd() == false);
+		REQUIRE(bufferPool::countFreeSlots() == G_BUFFER_POOL_CHUNK);
+	}
+
+	SECTION("test reuse")
+	{
+		AudioBuffer a;
+		bufferPool::acquire(a);
+		float* p = a[0];
+		a[0][0] = 1.0f;
+		bufferPool::release(a);
+		bufferPool::acquire(a);
+		REQUIRE(a[0] == p);
+		REQUIRE(a[0][0] == 0.0f);
+		bufferPool::release(a);
+	}
+
+	SECTION("test grow")
+	{
+		AudioBuffer bufs[G_BUFFER_POOL_CHUNK + 1];
+		for (AudioBuffer& b : bufs)
+			REQUIRE(bufferPool::acquire(b) == true);
+		REQUIRE(bufferPool::countSlots() == G_BUFFER_POOL_CHUNK * 2);
+		for (AudioBuffer& b : bufs)
+			bufferPool::release(b);
+	}
+
+	bufferPool::clear();
+}
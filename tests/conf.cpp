@@ -38,6 +38,8 @@ TEST_CASE("Test Conf class")
     conf::midiInActionRec = 18;
     conf::midiInInputRec = 19;
     conf::midiInMetronome = 20;
+    conf::midiInTiming = MIDI_IN_TIMING_IMMEDIATE;
+    conf::midiInJitterLog = true;
     conf::midiInVolumeIn = 21;
     conf::midiInVolumeOut = 22;
     conf::midiInBeatDouble = 23;
@@ -114,6 +116,8 @@ TEST_CASE("Test Conf class")
     REQUIRE(conf::midiInActionRec == 18);
     REQUIRE(conf::midiInInputRec == 19);
     REQUIRE(conf::midiInMetronome == 20);
+    REQUIRE(conf::midiInTiming == MIDI_IN_TIMING_IMMEDIATE);
+    REQUIRE(conf::midiInJitterLog == true);
     REQUIRE(conf::midiInVolumeIn == 21);
     REQUIRE(conf::midiInVolumeOut == 22);
     REQUIRE(conf::midiInBeatDouble == 23);
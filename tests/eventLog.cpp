@@ -0,0 +1,112 @@
+#include <cstdio>
+#include <vector>
+#include "../src/core/const.h"
+#include "../src/core/conf.h"
+#include "../src/core/eventLog.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test eventLog")
+{
+	using namespace giada::m;
+
+	const std::string path = std::string(P_tmpdir) + "/giada-test-input.gev";
+
+	conf::samplerate = 44100;
+	conf::buffersize = 256;
+
+	std::vector<eventLog::Event> out;
+	auto record = [&out](const eventLog::Event& e) { out.push_back(e); };
+
+	SECTION("test capture disabled")
+	{
+		eventLog::capture(eventLog::START);
+		eventLog::startCapture();
+		REQUIRE(eventLog::stopCapture(path) == G_RES_OK);
+
+		conf::soundSystem = G_SYS_API_NULL;
+		REQUIRE(eventLog::startReplay(path) == G_RES_OK);
+		eventLog::replay(record);
+		REQUIRE(out.size() == 0);
+		REQUIRE(eventLog::isReplaying() == false);
+	}
+
+	SECTION("test derived")
+	{
+		eventLog::startCapture();
+		{
+			eventLog::Derived d;
+			eventLog::capture(eventLog::START);
+		}
+		eventLog::capture(eventLog::STOP);
+		REQUIRE(eventLog::stopCapture(path) == G_RES_OK);
+
+		conf::soundSystem = G_SYS_API_NULL;
+		REQUIRE(eventLog::startReplay(path) == G_RES_OK);
+		eventLog::replay(record);
+		REQUIRE(out.size() == 1);
+		REQUIRE(out[0].type == eventLog::STOP);
+	}
+
+	SECTION("test round trip")
+	{
+		eventLog::startCapture();
+		eventLog::capture(eventLog::MIDI, 0x903C7F);
+		eventLog::advance(256);
+		eventLog::capture(eventLog::KEY_PRESS, 3, 100, 2);
+		eventLog::capture(eventLog::BPM, 120, 5);
+		eventLog::advance(512);
+		eventLog::capture(eventLog::BEATS, 4, 1, 1);
+		eventLog::collect();
+		REQUIRE(eventLog::stopCapture(path) == G_RES_OK);
+
+		conf::soundSystem = G_SYS_API_NULL;
+		REQUIRE(eventLog::startReplay(path) == G_RES_OK);
+		REQUIRE(eventLog::isReplaying() == true);
+
+		/* Events are dispatched block by block, as the frame counter goes. */
+
+		eventLog::replay(record);
+		REQUIRE(out.size() == 1);
+		REQUIRE(out[0].frame == 0);
+		REQUIRE(out[0].type == eventLog::MIDI);
+		REQUIRE(out[0].a == 0x903C7F);
+
+		eventLog::advance(256);
+		eventLog::replay(record);
+		REQUIRE(out.size() == 3);
+		REQUIRE(out[1].frame == 256);
+		REQUIRE(out[1].type == eventLog::KEY_PRESS);
+		REQUIRE(out[1].a == 3);
+		REQUIRE(out[1].b == 100);
+		REQUIRE(out[1].flags == 2);
+		REQUIRE(out[2].type == eventLog::BPM);
+
+		eventLog::advance(256);
+		eventLog::replay(record);
+		REQUIRE(out.size() == 3);
+
+		eventLog::advance(256);
+		eventLog::replay(record);
+		REQUIRE(out.size() == 4);
+		REQUIRE(out[3].frame == 768);
+		REQUIRE(out[3].type == eventLog::BEATS);
+		REQUIRE(out[3].flags == 1);
+		REQUIRE(eventLog::isReplaying() == false);
+	}
+
+	SECTION("test replay requires null device")
+	{
+		conf::soundSystem = G_SYS_API_ALSA;
+		REQUIRE(eventLog::startReplay(path) == G_RES_ERR_WRONG_DATA);
+		REQUIRE(eventLog::isReplaying() == false);
+	}
+
+	SECTION("test invalid file")
+	{
+		conf::soundSystem = G_SYS_API_NULL;
+		REQUIRE(eventLog::startReplay("./does-not-exist.gev") == G_RES_ERR_IO);
+	}
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,56 @@
+#include <cmath>
+#include "../src/core/audioBuffer.h"
+#include "../src/core/meter.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test meter")
+{
+	using namespace giada::m;
+
+	static const int BUFFER_SIZE = 256;
+
+	AudioBuffer buffer;
+	buffer.alloc(BUFFER_SIZE, 2);
+	buffer.clear();
+
+	SECTION("test silence")
+	{
+		meter::Level l = meter::measure(buffer);
+		REQUIRE(l.peak == 0.0f);
+		REQUIRE(l.rms == 0.0f);
+	}
+
+	SECTION("test negative peaks")
+	{
+		buffer[10][1] = -0.8f;
+		buffer[20][0] =  0.5f;
+		REQUIRE(meter::measure(buffer).peak == Approx(0.8f));
+	}
+
+	SECTION("test rms")
+	{
+		/* Square wave at +/- 0.5 on both channels: RMS equals the amplitude. */
+
+		for (int i=0; i<BUFFER_SIZE; i++)
+			for (int k=0; k<2; k++)
+				buffer[i][k] = i % 2 == 0 ? 0.5f : -0.5f;
+
+		meter::Level l = meter::measure(buffer);
+		REQUIRE(l.peak == Approx(0.5f));
+		REQUIRE(l.rms == Approx(0.5f));
+	}
+
+	SECTION("test gain")
+	{
+		for (int i=0; i<BUFFER_SIZE; i++) {
+			buffer[i][0] = 1.0f;
+			buffer[i][1] = 1.0f;
+		}
+
+		float gain[2] = { 0.5f, 0.0f };
+		meter::Level l = meter::measure(buffer, gain);
+		REQUIRE(l.peak == Approx(0.5f));
+		REQUIRE(l.rms == Approx(std::sqrt(0.125f)));
+	}
+}
@@ -36,15 +36,17 @@ TEST_CASE("Test Patch class")
 		channel1.actions.push_back(action2);
 
 #ifdef WITH_VST
-		plugin1.path   = "/path/to/plugin1";
-		plugin1.bypass = false;
+		plugin1.path      = "/path/to/plugin1";
+		plugin1.bypass    = false;
+		plugin1.keepAwake = true;
 		plugin1.params.push_back(0.0f);
 		plugin1.params.push_back(0.1f);
 		plugin1.params.push_back(0.2f);
 		channel1.plugins.push_back(plugin1);
 
-		plugin2.path   = "/another/path/to/plugin2";
-		plugin2.bypass = true;
+		plugin2.path      = "/another/path/to/plugin2";
+		plugin2.bypass    = true;
+		plugin2.keepAwake = false;
 		plugin2.params.push_back(0.6f);
 		plugin2.params.push_back(0.6f);
 		plugin2.params.push_back(0.6f);
@@ -53,6 +55,9 @@ TEST_CASE("Test Patch class")
 		plugin2.params.push_back(1.0f);
 		plugin2.params.push_back(0.333f);
 		channel1.plugins.push_back(plugin2);
+
+		channel1.sendLevels.push_back(0.0f);
+		channel1.sendLevels.push_back(0.5f);
 #endif
 
 		channel1.type              = G_CHANNEL_SAMPLE;
@@ -90,8 +95,14 @@ TEST_CASE("Test Patch class")
 		channel1.midiOutChan       = 5;
 		patch::channels.push_back(channel1);
 
-		column.index = 0;
-		column.width = 500;
+		column.index     = 0;
+		column.width     = 500;
+		column.bus       = true;
+		column.busVolume = 0.6f;
+		column.busMute   = true;
+#ifdef WITH_VST
+		column.busPlugins.push_back(plugin2);
+#endif
 		patch::columns.push_back(column);
 
 		patch::header       = "GPTCH";
@@ -114,6 +125,7 @@ TEST_CASE("Test Patch class")
 
 		patch::masterInPlugins.push_back(plugin1);
 		patch::masterOutPlugins.push_back(plugin2);
+		patch::sendBusPlugins[1].push_back(plugin1);
 
 #endif
 
@@ -142,6 +154,13 @@ TEST_CASE("Test Patch class")
 		patch::column_t column0 = patch::columns.at(0);
 		REQUIRE(column0.index == 0);
 		REQUIRE(column0.width == 500);
+		REQUIRE(column0.bus == true);
+		REQUIRE(column0.busVolume == Approx(0.6f));
+		REQUIRE(column0.busMute == true);
+#ifdef WITH_VST
+		REQUIRE(column0.busPlugins.size() == 1);
+		REQUIRE(column0.busPlugins.at(0).path == "/another/path/to/plugin2");
+#endif
 
 		patch::channel_t channel0 = patch::channels.at(0);
 		REQUIRE(channel0.type == G_CHANNEL_SAMPLE);
@@ -194,6 +213,7 @@ TEST_CASE("Test Patch class")
 		patch::plugin_t plugin0 = channel0.plugins.at(0);
 		REQUIRE(plugin0.path   == "/path/to/plugin1");
 		REQUIRE(plugin0.bypass == false);
+		REQUIRE(plugin0.keepAwake == true);
 		REQUIRE(plugin0.params.at(0) == Approx(0.0f));
 		REQUIRE(plugin0.params.at(1) == Approx(0.1f));
 		REQUIRE(plugin0.params.at(2) == Approx(0.2f));
@@ -201,6 +221,7 @@ TEST_CASE("Test Patch class")
 		patch::plugin_t plugin1 = channel0.plugins.at(1);
 		REQUIRE(plugin1.path == "/another/path/to/plugin2");
 		REQUIRE(plugin1.bypass == true);
+		REQUIRE(plugin1.keepAwake == false);
 		REQUIRE(plugin1.params.at(0) == Approx(0.6f));
 		REQUIRE(plugin1.params.at(1) == Approx(0.6f));
 		REQUIRE(plugin1.params.at(2) == Approx(0.6f));
@@ -226,6 +247,15 @@ TEST_CASE("Test Patch class")
 		REQUIRE(masterPlugin1.params.at(4) == Approx(1.0f));
 		REQUIRE(masterPlugin1.params.at(5) == Approx(1.0f));
 		REQUIRE(masterPlugin1.params.at(6) == Approx(0.333f));
+
+		REQUIRE(channel0.sendLevels.size() == 2);
+		REQUIRE(channel0.sendLevels.at(0) == Approx(0.0f));
+		REQUIRE(channel0.sendLevels.at(1) == Approx(0.5f));
+
+		REQUIRE(patch::sendBusPlugins[0].size() == 0);
+		REQUIRE(patch::sendBusPlugins[1].size() == 1);
+		REQUIRE(patch::sendBusPlugins[1].at(0).path == "/path/to/plugin1");
+		REQUIRE(patch::sendBusPlugins[1].at(0).keepAwake == true);
 #endif
 	}
 }
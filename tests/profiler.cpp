@@ -0,0 +1,54 @@
+#include "../src/core/profiler.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test profiler")
+{
+	using namespace giada::m;
+
+	profiler::Histogram h;
+
+	SECTION("test empty histogram")
+	{
+		REQUIRE(h.getCount() == 0);
+		REQUIRE(h.getPercentile(0.5) == 0);
+		REQUIRE(h.getMax() == 0);
+	}
+
+	SECTION("test exact small values")
+	{
+		for (int i=1; i<=10; i++)
+			h.add(i);
+		REQUIRE(h.getCount() == 10);
+		REQUIRE(h.getPercentile(0.5) == 5);
+		REQUIRE(h.getPercentile(1.0) == 10);
+		REQUIRE(h.getMax() == 10);
+	}
+
+	SECTION("test percentiles")
+	{
+		/* 1..1000 microseconds: percentiles must be within 12.5% and never
+		above the max. */
+
+		for (int i=1; i<=1000; i++)
+			h.add(i * 1000);
+
+		int64_t p50 = h.getPercentile(0.5);
+		int64_t p99 = h.getPercentile(0.99);
+		REQUIRE(p50 >= 500000);
+		REQUIRE(p50 <= 562500);
+		REQUIRE(p99 >= 990000);
+		REQUIRE(p99 <= 1000000);
+		REQUIRE(h.getPercentile(1.0) == 1000000);
+		REQUIRE(h.getMax() == 1000000);
+	}
+
+	SECTION("test outliers")
+	{
+		for (int i=0; i<999; i++)
+			h.add(100);
+		h.add(5000000);
+		REQUIRE(h.getPercentile(0.99) <= 112);
+		REQUIRE(h.getMax() == 5000000);
+	}
+}
@@ -0,0 +1,133 @@
+#include <thread>
+#include <vector>
+#include "../src/core/queue.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test Queue")
+{
+	using namespace giada::m;
+
+	Queue<int, 4> q;
+	int v = 0;
+
+	SECTION("test empty")
+	{
+		REQUIRE(q.isEmpty() == true);
+		REQUIRE(q.pop(v) == false);
+	}
+
+	SECTION("test FIFO order")
+	{
+		REQUIRE(q.push(1) == true);
+		REQUIRE(q.push(2) == true);
+		REQUIRE(q.isEmpty() == false);
+		REQUIRE(q.pop(v) == true);
+		REQUIRE(v == 1);
+		REQUIRE(q.pop(v) == true);
+		REQUIRE(v == 2);
+		REQUIRE(q.isEmpty() == true);
+	}
+
+	SECTION("test full")
+	{
+		REQUIRE(q.push(1) == true);
+		REQUIRE(q.push(2) == true);
+		REQUIRE(q.push(3) == true);
+		REQUIRE(q.push(4) == false);  // size - 1 items at most
+		REQUIRE(q.pop(v) == true);
+		REQUIRE(q.push(4) == true);
+	}
+
+	SECTION("test wrap around")
+	{
+		for (int i=0; i<10; i++) {
+			REQUIRE(q.push(i) == true);
+			REQUIRE(q.pop(v) == true);
+			REQUIRE(v == i);
+		}
+	}
+
+	SECTION("test producer/consumer threads")
+	{
+		static const int COUNT = 100000;
+
+		Queue<int, 64> q2;
+		std::thread producer([&q2]() {
+			for (int i=0; i<COUNT; i++)
+				while (!q2.push(i));
+		});
+
+		bool ordered = true;
+		for (int i=0; i<COUNT; i++) {
+			while (!q2.pop(v));
+			if (v != i)
+				ordered = false;
+		}
+		producer.join();
+
+		REQUIRE(ordered == true);
+		REQUIRE(q2.isEmpty() == true);
+	}
+}
+
+
+TEST_CASE("Test MpscQueue")
+{
+	using namespace giada::m;
+
+	MpscQueue<int, 4> q;
+	int v = 0;
+
+	SECTION("test FIFO order")
+	{
+		REQUIRE(q.pop(v) == false);
+		REQUIRE(q.push(1) == true);
+		REQUIRE(q.push(2) == true);
+		REQUIRE(q.pop(v) == true);
+		REQUIRE(v == 1);
+		REQUIRE(q.pop(v) == true);
+		REQUIRE(v == 2);
+		REQUIRE(q.pop(v) == false);
+	}
+
+	SECTION("test full")
+	{
+		for (int i=0; i<4; i++)
+			REQUIRE(q.push(i) == true);
+		REQUIRE(q.push(4) == false);
+		REQUIRE(q.pop(v) == true);
+		REQUIRE(q.push(4) == true);
+	}
+
+	SECTION("test multiple producers")
+	{
+		static const int COUNT     = 50000;
+		static const int PRODUCERS = 4;
+
+		MpscQueue<int, 64> q2;
+		std::vector<std::thread> producers;
+		for (int p=0; p<PRODUCERS; p++)
+			producers.push_back(std::thread([&q2, p]() {
+				for (int i=0; i<COUNT; i++)
+					while (!q2.push(p * COUNT + i));
+			}));
+
+		/* Items from the same producer must come out in order. */
+
+		std::vector<int> last(PRODUCERS, -1);
+		bool ordered = true;
+		for (int i=0; i<COUNT * PRODUCERS; i++) {
+			while (!q2.pop(v));
+			int p = v / COUNT;
+			if (v % COUNT <= last.at(p))
+				ordered = false;
+			last.at(p) = v % COUNT;
+		}
+		for (std::thread& t : producers)
+			t.join();
+
+		REQUIRE(ordered == true);
+		REQUIRE(q2.pop(v) == false);
+	}
+}
@@ -0,0 +1,76 @@
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <vector>
+#include "../src/core/conf.h"
+#include "../src/core/audioBuffer.h"
+#include "../src/core/realtime.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test realtime")
+{
+	using namespace giada::m;
+
+	conf::rtPriority   = 0;
+	conf::rtCpuMask    = 0;
+	conf::rtLockMemory = false;
+
+	SECTION("test prefault")
+	{
+		std::vector<float> data(100000, 0.5f);
+		realtime::prefault(data.data(), data.size() * sizeof(float));
+		REQUIRE(std::count(data.begin(), data.end(), 0.5f) == (long) data.size());
+
+		AudioBuffer b;
+		realtime::prefault(b);  // not allocated, nothing to do
+		REQUIRE(b.alloc(1024, 2));
+		b[1023][1] = 0.25f;
+		realtime::prefault(b);
+		REQUIRE(b[1023][1] == 0.25f);
+	}
+
+#if defined(__SSE__) || defined(_M_X64) || defined(__aarch64__)
+
+	/* Each thread has its own floating point state: run in a separate one, so 
+	that the flags don't leak into other tests. */
+
+	SECTION("test denormals")
+	{
+		auto flushes = [](std::function<void()> setup) -> bool {
+			bool result;
+			std::thread t([&result, &setup] {
+				setup();
+				volatile float tiny = 1e-38f;
+				volatile float r    = tiny * 1e-3f;
+				result = r == 0.0f;
+			});
+			t.join();
+			return result;
+		};
+
+		conf::rtFlushDenormals = false;
+		realtime::prepare();
+		REQUIRE(flushes(realtime::enterAudioThread) == false);
+		REQUIRE(flushes(realtime::flushDenormals) == false);
+
+		conf::rtFlushDenormals = true;
+		realtime::prepare();
+		REQUIRE(flushes(realtime::enterAudioThread) == true);
+		REQUIRE(flushes(realtime::flushDenormals) == true);
+	}
+
+#endif
+
+	SECTION("test once per prepare")
+	{
+		conf::rtFlushDenormals = false;
+		realtime::prepare();
+		std::thread t([] {
+			realtime::enterAudioThread();
+			realtime::enterAudioThread();
+		});
+		realtime::report();  // returns as soon as the thread is configured
+		t.join();
+	}
+}
@@ -1,5 +1,6 @@
 #include "../src/core/recorder.h"
 #include "../src/core/const.h"
+#include <algorithm>
 #include <catch.hpp>
 
 
@@ -128,6 +129,53 @@ TEST_CASE("Test Recorder")
 		REQUIRE(result->frame == 1000);
 	}
 
+	SECTION("Test range query")
+	{
+		recorder::rec(0, G_ACTION_KEYPRESS, 500, 0, 0.0f);
+		recorder::rec(1, G_ACTION_KEYPRESS, 200, 0, 0.0f);
+		recorder::rec(0, G_ACTION_KEYREL,   300, 0, 0.0f);
+		recorder::rec(0, G_ACTION_KEYPRESS, 100, 0, 0.0f);
+		recorder::rec(0, G_ACTION_KEYREL,   900, 0, 0.0f);
+		recorder::rec(1, G_ACTION_KEYREL,   300, 0, 0.0f);
+
+		std::vector<int> found;
+		recorder::forEachAction(0, 200, 900, [&] (const recorder::action* a) {
+			found.push_back(a->frame);
+		});
+
+		/* Actions get sorted by frame along the way. Range is [200, 900). */
+
+		REQUIRE(recorder::sortedActions);
+		REQUIRE(std::is_sorted(recorder::frames.begin(), recorder::frames.end()));
+		for (unsigned i=0; i<recorder::frames.size(); i++)
+			REQUIRE(recorder::global.at(i).at(0)->frame == recorder::frames.at(i));
+		REQUIRE(found.size() == 2);
+		REQUIRE(found.at(0) == 300);
+		REQUIRE(found.at(1) == 500);
+	}
+
+	SECTION("Test snapshot")
+	{
+		recorder::rec(0, G_ACTION_KEYPRESS, 500, 0, 0.0f);
+		recorder::rec(1, G_ACTION_KEYPRESS, 200, 0, 0.0f);
+		recorder::rec(0, G_ACTION_KEYREL,   300, 0, 0.0f);
+		recorder::rec(0, G_ACTION_KEYPRESS, 100, 0, 0.0f);
+
+		/* Renders read a snapshot: the recorder is left as it is, and later
+		changes don't reach the copy. */
+
+		std::vector<recorder::action> actions = recorder::getActions(0, &mutex);
+		REQUIRE(recorder::frames.size() == 4);
+		REQUIRE(actions.size() == 3);
+		REQUIRE(actions.at(0).frame == 100);
+		REQUIRE(actions.at(1).frame == 300);
+		REQUIRE(actions.at(2).frame == 500);
+
+		recorder::clearAll();
+		REQUIRE(actions.at(2).frame == 500);
+		REQUIRE(actions.at(2).type == G_ACTION_KEYPRESS);
+	}
+
 	SECTION("Test deletion, single action")
 	{
 		recorder::rec(0, G_ACTION_KEYPRESS, 50, 6, 0.3f);
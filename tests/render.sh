@@ -0,0 +1,18 @@
+#!/bin/sh
+
+# Renders a clean patch offline with the realtime audit enabled. Giada exits 
+# with failure if the audio thread made any call that might block, known 
+# engine mutexes aside (see rtAudit::allow()). Runs with a private HOME, so 
+# that the user's configuration doesn't get in the way.
+
+set -e
+
+dir=$(mktemp -d)
+trap 'rm -rf "$dir"' EXIT
+
+mkdir "$dir/render.gprj"
+cp "${srcdir:-.}/tests/resources/render.gptc" "${srcdir:-.}/tests/resources/test.wav" \
+	"$dir/render.gprj/"
+
+HOME="$dir" ./giada --render "$dir/render.gprj" "$dir/render.wav" --loops 2 --start-loops
+test -s "$dir/render.wav"
@@ -0,0 +1,92 @@
+#ifdef WITH_RT_AUDIT
+
+
+#include <cstdlib>
+#include <pthread.h>
+#include "../src/core/rtAudit.h"
+#include "../src/core/const.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test realtime audit")
+{
+	using namespace giada::m;
+
+	rtAudit::init();
+	rtAudit::report();
+
+	SECTION("test clean code")
+	{
+		rtAudit::enter();
+		volatile int x = 0;
+		for (int i=0; i<16; i++)
+			x += i;
+		rtAudit::leave();
+		REQUIRE(rtAudit::report() == 0);
+	}
+
+	SECTION("test violations")
+	{
+		/* Volatile pointers, or the optimizer would drop the allocations. */
+
+		pthread_mutex_t m = PTHREAD_MUTEX_INITIALIZER;
+
+		rtAudit::enter();
+		void* volatile p = malloc(64);
+		free(p);
+		int* volatile i = new int(1);
+		delete i;
+		pthread_mutex_lock(&m);
+		pthread_mutex_unlock(&m);
+		rtAudit::leave();
+
+		REQUIRE(rtAudit::report() == 5);
+	}
+
+	SECTION("test known mutexes")
+	{
+		/* Static: allow() outlives this section. Past the traced ones, known 
+		locks don't take room in the queue. */
+
+		static pthread_mutex_t known = PTHREAD_MUTEX_INITIALIZER;
+		static pthread_mutex_t other = PTHREAD_MUTEX_INITIALIZER;
+
+		rtAudit::allow(&known);
+		rtAudit::allow(&known);
+
+		rtAudit::enter();
+		for (int i=0; i<G_RT_AUDIT_QUEUE * 2; i++) {
+			pthread_mutex_lock(&known);
+			pthread_mutex_unlock(&known);
+		}
+		pthread_mutex_lock(&other);
+		pthread_mutex_unlock(&other);
+		rtAudit::leave();
+
+		REQUIRE(rtAudit::report() == 1);
+	}
+
+	SECTION("test aligned allocations")
+	{
+		rtAudit::enter();
+		void* p = nullptr;
+		int res = posix_memalign(&p, 64, 256);
+		free(p);
+		void* volatile q = aligned_alloc(64, 256);
+		free(q);
+		rtAudit::leave();
+
+		REQUIRE(res == 0);
+		REQUIRE(rtAudit::report() == 4);
+	}
+
+	SECTION("test other threads")
+	{
+		void* volatile p = malloc(64);
+		free(p);
+		REQUIRE(rtAudit::report() == 0);
+	}
+}
+
+
+#endif
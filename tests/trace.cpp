@@ -0,0 +1,80 @@
+#ifdef WITH_TRACE
+
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "../src/core/const.h"
+#include "../src/core/trace.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test trace")
+{
+	using namespace giada::m;
+
+	const std::string path = std::string(P_tmpdir) + "/giada-test-trace.json";
+
+	trace::dump(path);  // flush leftovers
+
+	SECTION("test disabled")
+	{
+		trace::setEnabled(false);
+		{
+			G_TRACE_SCOPE("disabled");
+		}
+		trace::dump(path);
+
+		std::ifstream f(path);
+		std::stringstream s;
+		s << f.rdbuf();
+		REQUIRE(s.str().find("\"disabled\"") == std::string::npos);
+	}
+
+	SECTION("test threads")
+	{
+		trace::setEnabled(true);
+		G_TRACE_THREAD("main");
+		{
+			G_TRACE_SCOPE("scope");
+		}
+		std::thread t([] {
+			G_TRACE_THREAD("worker");
+			G_TRACE_BEGIN(id);
+			G_TRACE_END(id, "pair");
+		});
+		t.join();
+		trace::setEnabled(false);
+
+		REQUIRE(trace::dump(path));
+
+		std::ifstream f(path);
+		std::stringstream s;
+		s << f.rdbuf();
+		REQUIRE(s.str().find("\"scope\",\"ph\":\"X\"") != std::string::npos);
+		REQUIRE(s.str().find("\"pair\",\"ph\":\"X\"") != std::string::npos);
+		REQUIRE(s.str().find("\"name\":\"main\"") != std::string::npos);
+		REQUIRE(s.str().find("\"name\":\"worker\"") != std::string::npos);
+	}
+
+	SECTION("test buffers released on thread exit")
+	{
+		trace::setEnabled(true);
+		for (int i=0; i<G_TRACE_THREADS * 2; i++) {
+			std::thread t([] {
+				G_TRACE_SCOPE("short");
+			});
+			t.join();
+		}
+		trace::setEnabled(false);
+
+		REQUIRE(trace::getDropped() == 0);
+		REQUIRE(trace::dump(path));
+	}
+
+	std::remove(path.c_str());
+}
+
+
+#endif
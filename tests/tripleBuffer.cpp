@@ -0,0 +1,68 @@
+#include <thread>
+#include "../src/core/tripleBuffer.h"
+#include <catch.hpp>
+
+
+TEST_CASE("Test TripleBuffer")
+{
+	using namespace giada::m;
+
+	struct Data { int a; int b; };
+
+	TripleBuffer<Data> tb;
+
+	SECTION("test nothing published")
+	{
+		REQUIRE(tb.update() == false);
+		REQUIRE(tb.getVersion() == 0);
+	}
+
+	SECTION("test publish and read")
+	{
+		tb.getWriteBuffer() = { 1, 1 };
+		tb.publish();
+		REQUIRE(tb.update() == true);
+		REQUIRE(tb.getReadBuffer().a == 1);
+		REQUIRE(tb.update() == false);  // nothing new, read buffer untouched
+		REQUIRE(tb.getReadBuffer().a == 1);
+		REQUIRE(tb.getVersion() == 1);
+	}
+
+	SECTION("test latest value wins")
+	{
+		for (int i=0; i<5; i++) {
+			tb.getWriteBuffer() = { i, i };
+			tb.publish();
+		}
+		REQUIRE(tb.update() == true);
+		REQUIRE(tb.getReadBuffer().a == 4);
+	}
+
+	SECTION("test writer/reader threads")
+	{
+		static const int COUNT = 100000;
+
+		std::thread writer([&tb]() {
+			for (int i=1; i<=COUNT; i++) {
+				tb.getWriteBuffer() = { i, -i };
+				tb.publish();
+			}
+		});
+
+		/* Values must never be torn nor go back in time. */
+
+		bool consistent = true;
+		int last = 0;
+		while (last < COUNT) {
+			if (!tb.update())
+				continue;
+			const Data& d = tb.getReadBuffer();
+			if (d.a != -d.b || d.a < last)
+				consistent = false;
+			last = d.a;
+		}
+		writer.join();
+
+		REQUIRE(consistent == true);
+	}
+}
@@ -135,4 +135,22 @@ TEST_CASE("Test waveFx")
 			REQUIRE(waveMono.getFrame(b)[0] == 0.0f);		
 		}
 	}
+
+	SECTION("test peaks")
+	{
+		wfx::silence(waveStereo, 0, BUFFER_SIZE);
+		waveStereo.getFrame(10)[0] =  0.5f;
+		waveStereo.getFrame(10)[1] =  0.3f;
+		waveStereo.getFrame(20)[0] = -0.2f;
+		waveStereo.getFrame(20)[1] = -0.6f;
+
+		float sup, inf;
+		wfx::getPeaks(waveStereo, 0, 100, sup, inf);
+		REQUIRE(sup == Approx(0.4f));
+		REQUIRE(inf == Approx(-0.4f));
+
+		wfx::getPeaks(waveStereo, 30, 100, sup, inf);
+		REQUIRE(sup == 0.0f);
+		REQUIRE(inf == 0.0f);
+	}
 }